@@ -0,0 +1,1144 @@
+/*
+ * bench.cpp - 在主机上对不依赖libnx的模块做正确性检查并计时
+ * bench.cpp - correctness checks and timings for the modules that don't depend on libnx, run on the host
+ *
+ * 用法 (Usage): host_bench [section...]，不带参数时运行所有部分 (runs every section when no argument is given)
+ * 所有文件都写入当前目录，Makefile在build/work下运行 (Every file is written to the current directory, the Makefile runs
+ * it in build/work)
+ * mods部分写入/atmosphere/和/mods2/，只在chroot到build/work后运行 (The mods section writes to /atmosphere/ and /mods2/ and
+ * only runs once chrooted into build/work)
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "collation_key.hpp"
+#include "search_index.hpp"
+#include "conflict_index.hpp"
+#include "install_manifest.hpp"
+#include "catalog_snapshot.hpp"
+#include "frame_scheduler.hpp"
+#include "icon_data.hpp"
+#include "pulse_colour.hpp"
+#include "atomic_file.hpp"
+#include "mod_manager.hpp"
+#include "game_dir_scanner.hpp"
+#include "nvg_util.hpp"
+// 不要zlib兼容宏，否则crc32成员会被改名 (No zlib compatible macros, they would rename the crc32 members)
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "miniz.h"
+#include <nxtc_version.h>
+#include <haze/ptp_string.hpp>
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+int g_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::printf("    FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        g_failures++; \
+    } \
+} while (0)
+
+// 运行一次并返回毫秒数 (Run once and return milliseconds)
+double TimeMs(const std::function<void()>& func) {
+    auto start = BenchClock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+// 取多次运行的最小值，减少调度噪声 (Take the minimum of several runs to reduce scheduling noise)
+double BestMs(int runs, const std::function<void()>& func) {
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i) {
+        best = std::min(best, TimeMs(func));
+    }
+    return best;
+}
+
+bool FileExists(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+// 生成中英混合的名称，与主页和MOD列表的名称分布相近 (Generate mixed CJK/Latin names, close to the home and MOD lists)
+std::vector<std::string> MakeNames(size_t count) {
+    static const char* const cjk[] = {
+        "超级", "马力欧", "塞尔达", "传说", "宝可梦", "异度", "神剑", "火焰", "纹章", "星之",
+        "卡比", "斯普拉遁", "动物", "森友会", "银河", "战士", "重制版", "汉化", "补丁", "高清",
+    };
+    static const char* const latin[] = {
+        "Mario", "Zelda", "Pokemon", "Xenoblade", "Kirby", "Splatoon", "HD", "Mod", "v1.2", "DLC",
+    };
+
+    std::mt19937 rng(12345);
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string name;
+        size_t parts = 2 + rng() % 3;
+        for (size_t p = 0; p < parts; ++p) {
+            if (rng() % 3 == 0) {
+                name += latin[rng() % (sizeof(latin) / sizeof(latin[0]))];
+                name += ' ';
+            } else {
+                name += cjk[rng() % (sizeof(cjk) / sizeof(cjk[0]))];
+            }
+        }
+        name += std::to_string(i);
+        names.push_back(std::move(name));
+    }
+    return names;
+}
+
+void BenchCollation() {
+    // 拼音顺序：chuan < chui，an < bei，ASCII保持字节序 (Pinyin order: chuan < chui, an < bei, ASCII keeps byte order)
+    CHECK(tj::MakeCollationKey("传") < tj::MakeCollationKey("吹"));
+    CHECK(tj::MakeCollationKey("安") < tj::MakeCollationKey("北"));
+    CHECK(tj::MakeCollationKey("Mario") < tj::MakeCollationKey("Zelda"));
+    // 结束符让前缀排在前面 (The terminator sorts a prefix first)
+    CHECK(tj::MakeCollationKey("传") < tj::MakeCollationKey("传说"));
+
+    const auto names = MakeNames(5000);
+    std::vector<std::string> keys;
+    double build_ms = BestMs(5, [&] {
+        keys.clear();
+        keys.reserve(names.size());
+        for (const auto& name : names) {
+            keys.push_back(tj::MakeCollationKey(name));
+        }
+    });
+
+    std::vector<size_t> order;
+    double sort_ms = BestMs(5, [&] {
+        order.resize(names.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+    });
+    CHECK(std::is_sorted(order.begin(), order.end(), [&](size_t a, size_t b) { return keys[a] < keys[b]; }));
+
+    std::printf("  %zu names: build keys %.2f ms, sort %.2f ms\n", names.size(), build_ms, sort_ms);
+}
+
+void BenchSearch() {
+    tj::PinyinSearchIndex index;
+    index.Build({"超级马力欧", "塞尔达传说", "Zelda HD", "宝可梦"});
+    auto query = [&](const std::string& text) { return index.Query(text); };
+    CHECK(query("cjml") == std::vector<uint32_t>{0});
+    CHECK(query("chuanshuo") == std::vector<uint32_t>{1});
+    CHECK(query("zelda") == std::vector<uint32_t>{2});
+    CHECK(query("bkm") == std::vector<uint32_t>{3});
+    // 多音字：塞 sai/se (Polyphonic character: 塞 sai/se)
+    CHECK(query("sedcs") == std::vector<uint32_t>{1});
+    CHECK(query("saierda") == std::vector<uint32_t>{1});
+    CHECK(query("xyz").empty());
+
+    const auto names = MakeNames(5000);
+    double build_ms = BestMs(5, [&] { index.Build(names); });
+
+    // 逐字输入，与搜索框的使用方式相同 (Type character by character, as the search box does)
+    const std::string typed = "chaojimaliou";
+    size_t matches = 0;
+    double type_ms = BestMs(5, [&] {
+        index.Query("");
+        for (size_t i = 1; i <= typed.size(); ++i) {
+            matches = index.Query(typed.substr(0, i)).size();
+        }
+    });
+    CHECK(matches > 0);
+
+    std::printf("  %zu names: build index %.2f ms, %zu keystrokes %.3f ms (%zu matches)\n",
+        names.size(), build_ms, typed.size(), type_ms, matches);
+}
+
+std::vector<tj::InstallManifestEntry> MakeEntries(const std::string& prefix, size_t count) {
+    std::vector<tj::InstallManifestEntry> entries;
+    entries.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        entries.push_back({prefix + std::to_string(i) + ".bfres", 1000 + i, static_cast<u32>(i * 2654435761u)});
+    }
+    return entries;
+}
+
+void BenchConflictIndex() {
+    const std::string path = "conflict_index.bin";
+    tj::atomic_file::Remove(path);
+
+    const std::string shared = "/atmosphere/contents/0100000000010000/romfs/shared.bfres";
+    auto mod_a = MakeEntries("/atmosphere/contents/0100000000010000/romfs/a/", 5000);
+    auto mod_b = MakeEntries("/atmosphere/contents/0100000000010000/romfs/b/", 5000);
+    mod_a.push_back({shared, 10, 111});
+    mod_b.push_back({shared, 10, 222});
+
+    double add_ms = 0;
+    double commit_ms = 0;
+    {
+        tj::ConflictIndex index(path);
+        add_ms = TimeMs([&] {
+            index.AddMod("ModA", mod_a);
+            index.AddMod("ModB", mod_b);
+        });
+        commit_ms = TimeMs([&] { CHECK(index.Commit()); });
+    }
+
+    std::vector<std::string> owners;
+    u32 crc32 = 0;
+    double load_ms = 0;
+    double lookup_us = 0;
+    {
+        std::unique_ptr<tj::ConflictIndex> index;
+        load_ms = TimeMs([&] { index = std::make_unique<tj::ConflictIndex>(path); });
+        CHECK(index->Size() == mod_a.size() + mod_b.size() - 1);
+        CHECK(index->Lookup(shared, owners, &crc32));
+        CHECK(owners.size() == 2);
+
+        lookup_us = TimeMs([&] {
+            for (const auto& entry : mod_a) {
+                index->Lookup(entry.target_path, owners);
+            }
+        }) * 1000.0 / mod_a.size();
+
+        index->RenameMod("ModA", "ModA2");
+        index->RemoveMod("ModB");
+        CHECK(index->Lookup(shared, owners, &crc32));
+        CHECK(owners == std::vector<std::string>{"ModA2"});
+        CHECK(crc32 == 111);
+        CHECK(index->Commit());
+    }
+    {
+        tj::ConflictIndex index(path);
+        CHECK(index.Lookup(shared, owners));
+        CHECK(owners == std::vector<std::string>{"ModA2"});
+        index.RemoveMod("ModA2");
+        CHECK(index.Commit());
+    }
+    // 空索引删除文件 (An empty index removes the file)
+    CHECK(!FileExists(path));
+
+    std::printf("  %zu files: add %.2f ms, commit %.2f ms, load %.2f ms, lookup %.3f us\n",
+        mod_a.size() + mod_b.size(), add_ms, commit_ms, load_ms, lookup_us);
+}
+
+void BenchManifest() {
+    const std::string path = "install_manifest.bin";
+    const auto entries = MakeEntries("/atmosphere/contents/0100000000010000/romfs/", 10000);
+    const u64 fingerprint = 0x1234567890ABCDEFull;
+
+    double write_ms = TimeMs([&] { CHECK(tj::InstallManifest::Write(path, fingerprint, entries)); });
+    std::vector<tj::InstallManifestEntry> read;
+    double read_ms = TimeMs([&] { CHECK(tj::InstallManifest::Read(path, fingerprint, read)); });
+    CHECK(read.size() == entries.size());
+    CHECK(read.back().target_path == entries.back().target_path && read.back().crc32 == entries.back().crc32);
+
+    // 指纹不符视为过期 (A fingerprint mismatch is stale)
+    CHECK(!tj::InstallManifest::Read(path, fingerprint + 1, read));
+
+    // 改动一个字节后尾部CRC不再匹配 (Flipping one byte breaks the trailer CRC)
+    FILE* file = std::fopen(path.c_str(), "r+b");
+    CHECK(file != nullptr);
+    if (file) {
+        std::fseek(file, 100, SEEK_SET);
+        int c = std::fgetc(file);
+        std::fseek(file, 100, SEEK_SET);
+        std::fputc(c ^ 0xFF, file);
+        std::fclose(file);
+    }
+    CHECK(!tj::InstallManifest::Read(path, fingerprint, read));
+
+    // 替换中断后遗留的临时文件在读取时恢复 (A temp file left by an interrupted replace is restored on read)
+    CHECK(tj::InstallManifest::Write(path, fingerprint, entries));
+    std::rename(path.c_str(), tj::atomic_file::TempPath(path).c_str());
+    CHECK(tj::InstallManifest::Read(path, fingerprint, read));
+    CHECK(read.size() == entries.size());
+    CHECK(!FileExists(tj::atomic_file::TempPath(path)));
+
+    tj::InstallManifest::Remove(path);
+    CHECK(!FileExists(path));
+
+    std::printf("  %zu entries: write %.2f ms, read %.2f ms\n", entries.size(), write_ms, read_ms);
+}
+
+void BenchCatalogSnapshot() {
+    const std::string path = "catalog_snapshot.bin";
+    const std::string game_name_json = "game_name.json";
+    FILE* file = std::fopen(game_name_json.c_str(), "wb");
+    if (file) {
+        std::fputs("{\"0100000000010000\":\"Super Mario Odyssey\"}", file);
+        std::fclose(file);
+    }
+
+    const auto names = MakeNames(500);
+    std::vector<std::string> dirnames;
+    std::vector<tj::CatalogSnapshotEntry> entries;
+    for (size_t i = 0; i < names.size(); ++i) {
+        dirnames.push_back(names[i] + "[01000000000" + std::to_string(10000 + i) + "]");
+        tj::CatalogSnapshotEntry entry;
+        entry.dirname = dirnames.back();
+        entry.name = names[i];
+        entry.display_version = "1.0." + std::to_string(i);
+        entry.FILE_NAME = names[i];
+        entry.FILE_NAME2 = names[i];
+        entry.FILE_PATH = "/mods2/" + dirnames.back() + "/01000000000" + std::to_string(10000 + i);
+        entry.MOD_VERSION = "1.0";
+        entry.MOD_TOTAL = std::to_string(i % 7);
+        entry.id = 0x0100000000010000ull + i;
+        entry.is_favorite = i % 5 == 0;
+        entries.push_back(std::move(entry));
+    }
+
+    const u64 key = tj::CatalogSnapshot::ComputeKey(dirnames, game_name_json);
+    double write_ms = TimeMs([&] { CHECK(tj::CatalogSnapshot::Write(path, key, entries)); });
+    std::vector<tj::CatalogSnapshotEntry> read;
+    double read_ms = TimeMs([&] { CHECK(tj::CatalogSnapshot::Read(path, key, read)); });
+    CHECK(read.size() == entries.size());
+    CHECK(read[7].FILE_PATH == entries[7].FILE_PATH && read[5].is_favorite && read[7].id == entries[7].id);
+
+    // 目录列表或game_name.json变化都会使快照失效 (A change to the directory list or game_name.json invalidates it)
+    dirnames.pop_back();
+    CHECK(tj::CatalogSnapshot::ComputeKey(dirnames, game_name_json) != key);
+    dirnames.push_back(entries.back().dirname);
+    file = std::fopen(game_name_json.c_str(), "ab");
+    if (file) {
+        std::fputc(' ', file);
+        std::fclose(file);
+    }
+    const u64 changed_key = tj::CatalogSnapshot::ComputeKey(dirnames, game_name_json);
+    CHECK(changed_key != key);
+    CHECK(!tj::CatalogSnapshot::Read(path, changed_key, read));
+
+    tj::atomic_file::Remove(path);
+    std::remove(game_name_json.c_str());
+
+    std::printf("  %zu games: write %.2f ms, read %.2f ms\n", entries.size(), write_ms, read_ms);
+}
+
+// 以约60fps模拟主循环，返回空闲期间每秒绘制的帧数 (Simulate the main loop at about 60 fps, return frames drawn per
+// idle second)
+double IdleFramesPerSecond(bool animated) {
+    tj::FrameScheduler scheduler;
+    const auto frame = std::chrono::microseconds(16667);
+    const auto start = BenchClock::now();
+    scheduler.MarkActive(start);
+
+    // 跳过输入后的逐帧窗口，只统计空闲的2秒 (Skip the every-frame window after input and count 2 idle seconds)
+    const auto idle_start = start + tj::FrameScheduler::ACTIVE_WINDOW + std::chrono::milliseconds(100);
+    const auto idle_end = idle_start + std::chrono::seconds(2);
+    u64 idle_frames = 0;
+    for (auto next = start; next < idle_end; next += frame) {
+        std::this_thread::sleep_until(next);
+        const auto now = BenchClock::now();
+        if (!scheduler.ShouldDraw(now)) {
+            continue;
+        }
+        if (animated) {
+            scheduler.RequestFrameWithin(std::chrono::milliseconds(33));
+        }
+        if (now >= idle_start) {
+            idle_frames++;
+        }
+    }
+    return idle_frames / 2.0;
+}
+
+// 以60Hz模拟带选中项的列表画面，时间是模拟的：每个绘制的帧调用一次真实的脉冲更新，第10秒有一次输入；
+// 返回每一秒绘制的帧数
+// (Simulate a list screen with a selection at 60 Hz on simulated time: every drawn frame runs the real pulse update and
+// there is one input at 10 s; returns the frames drawn in each second)
+std::vector<int> PulseFramesPerSecond(bool& settled_at_initial_colour) {
+    tj::FrameScheduler scheduler;
+    tj::PulseColour pulse;
+    const auto frame = std::chrono::microseconds(16667);
+    const auto start = tj::FrameScheduler::Clock::now();
+    const NVGcolor initial = pulse.GetColour();
+    scheduler.MarkActive(start);
+
+    std::vector<int> frames_per_second(13, 0);
+    settled_at_initial_colour = false;
+    for (auto now = start; now < start + std::chrono::seconds(13); now += frame) {
+        const auto second = static_cast<size_t>(std::chrono::duration_cast<std::chrono::seconds>(now - start).count());
+        if (second == 10 && now - frame < start + std::chrono::seconds(10)) {
+            // 停下时颜色回到初始值 (The colour is back at its initial value when the pulse rests)
+            settled_at_initial_colour = pulse.GetColour().g == initial.g && pulse.GetColour().b == initial.b;
+            scheduler.MarkActive(now);
+        }
+        if (scheduler.ShouldDraw(now)) {
+            frames_per_second[second]++;
+            pulse.Update(scheduler, now);
+        }
+    }
+    return frames_per_second;
+}
+
+void BenchFrameScheduler() {
+    const double static_fps = IdleFramesPerSecond(false);
+    const double animated_fps = IdleFramesPerSecond(true);
+    // 静态画面只有250ms的兜底刷新，33ms动画约30帧 (A static screen only gets the 250 ms safety refresh, a 33 ms
+    // animation about 30 frames)
+    CHECK(static_fps <= 5.0);
+    CHECK(animated_fps >= 20.0 && animated_fps <= 31.0);
+
+    // 输入后1-3秒脉冲以30帧动画，3秒无输入后走完当前周期停下，只剩兜底刷新；第10秒的输入让它继续
+    // (1-3 s after input the pulse animates at 30 fps; after 3 s without input it finishes its cycle and rests, leaving
+    // only the safety refresh; the input at 10 s resumes it)
+    bool settled_at_initial_colour = false;
+    const auto pulse_fps = PulseFramesPerSecond(settled_at_initial_colour);
+    CHECK(pulse_fps[1] >= 29 && pulse_fps[2] >= 29);
+    for (size_t second = 5; second < 10; ++second) {
+        CHECK(pulse_fps[second] <= 5);
+    }
+    CHECK(settled_at_initial_colour);
+    CHECK(pulse_fps[11] >= 29 && pulse_fps[12] >= 29);
+
+    std::printf("  idle frames per second: static %.1f, 33 ms animation %.1f (loop at 60)\n", static_fps, animated_fps);
+    std::printf("  selection pulse frames per second, input at 0 s and 10 s:");
+    for (int fps : pulse_fps) {
+        std::printf(" %d", fps);
+    }
+    std::printf("\n");
+}
+
+NacpStruct MakeNacp(u64 title_id) {
+    NacpStruct nacp{};
+    for (auto& lang : nacp.lang) {
+        std::snprintf(lang.name, sizeof(lang.name), "Title %016llX", static_cast<unsigned long long>(title_id));
+        std::snprintf(lang.author, sizeof(lang.author), "Publisher %u", static_cast<unsigned>(title_id % 97));
+    }
+    std::snprintf(nacp.display_version, sizeof(nacp.display_version), "1.%u.0", static_cast<unsigned>(title_id % 10));
+    return nacp;
+}
+
+std::vector<unsigned char> MakeIcon(u64 title_id, size_t size) {
+    std::vector<unsigned char> icon(size);
+    std::mt19937 rng(static_cast<u32>(title_id));
+    for (auto& byte : icon) {
+        byte = static_cast<unsigned char>(rng());
+    }
+    // JPEG SOI/EOI
+    icon[0] = 0xFF;
+    icon[1] = 0xD8;
+    icon[size - 2] = 0xFF;
+    icon[size - 1] = 0xD9;
+    return icon;
+}
+
+std::vector<u64> MakeTitleIds(size_t count, bool shuffled) {
+    std::vector<u64> ids;
+    for (size_t i = 0; i < count; ++i) {
+        ids.push_back(0x0100000000010000ull + (i << 16));
+    }
+    if (shuffled) {
+        std::shuffle(ids.begin(), ids.end(), std::mt19937(7));
+    }
+    return ids;
+}
+
+// 返回添加所用的毫秒数 (Returns the milliseconds spent adding)
+double AddTitles(const std::vector<u64>& ids, size_t icon_size, bool batch) {
+    std::vector<NacpStruct> nacps;
+    std::vector<std::vector<unsigned char>> icons;
+    for (u64 id : ids) {
+        nacps.push_back(MakeNacp(id));
+        icons.push_back(MakeIcon(id, icon_size));
+    }
+
+    return TimeMs([&] {
+        if (batch) {
+            nxtcBeginBatchAdd();
+        }
+        for (size_t i = 0; i < ids.size(); ++i) {
+            nxtcAddEntry(ids[i], &nacps[i], icons[i].size(), icons[i].data(), false, static_cast<u32>(i));
+        }
+        if (batch) {
+            nxtcCommitBatchAdd();
+        }
+    });
+}
+
+void BenchNxtc() {
+    const std::string cache_path = "sdmc:/switch/nxtc_version.bin";
+    mkdir("sdmc:", 0755);
+    mkdir("sdmc:/switch", 0755);
+
+    // 2000个乱序标题：逐个添加与一次批量添加；40 KiB图标时复制图标占主要时间，1 KiB图标时主要是排序合并
+    // 2000 shuffled titles: per-entry adds vs one batch; with 40 KiB icons copying the icons dominates, with 1 KiB icons
+    // it is mostly the sort and merge
+    const auto shuffled = MakeTitleIds(2000, true);
+    CHECK(nxtcInitialize());
+    double per_entry_ms[2] = {};
+    double batch_ms[2] = {};
+    const size_t add_icon_sizes[2] = {40 * 1024, 1024};
+    for (int i = 0; i < 2; ++i) {
+        nxtcWipeCache();
+        per_entry_ms[i] = AddTitles(shuffled, add_icon_sizes[i], false);
+        nxtcWipeCache();
+        batch_ms[i] = AddTitles(shuffled, add_icon_sizes[i], true);
+        for (u64 id : shuffled) {
+            CHECK(nxtcCheckIfEntryExists(id));
+        }
+    }
+    nxtcWipeCache();
+    nxtcExit();
+
+    // 1000个标题的借用查找 (Borrowing lookups over 1000 titles)
+    const auto ids = MakeTitleIds(1000, false);
+    const size_t icon_size = 32 * 1024;
+    CHECK(nxtcInitialize());
+    AddTitles(ids, icon_size, true);
+
+    const auto lookups = MakeTitleIds(1000, true);
+    NxTitleCacheApplicationMetadataView view;
+    double lookup_us = BestMs(5, [&] {
+        for (u64 id : lookups) {
+            if (nxtcBorrowApplicationMetadataById(id, &view)) {
+                nxtcReleaseApplicationMetadataView(&view);
+            }
+        }
+    }) * 1000.0 / lookups.size();
+
+    // 保存时先写临时文件再替换，完成后不留临时文件 (Saving writes a temp file and swaps it in, leaving no temp file)
+    nxtcFlushCacheFile();
+    CHECK(FileExists(cache_path));
+    CHECK(!FileExists(cache_path + ".tmp"));
+    nxtcExit();
+
+    // 完整加载与延迟加载 (Full load vs lazy load)
+    double full_init_ms = TimeMs([&] { CHECK(nxtcInitialize()); });
+    CHECK(nxtcCheckIfEntryExists(ids[500]));
+    nxtcExit();
+
+    double lazy_init_ms = TimeMs([&] { CHECK(nxtcInitializeLazy()); });
+    CHECK(nxtcBorrowApplicationMetadataById(ids[500], &view));
+    if (view.handle) {
+        CHECK(view.name && std::string(view.name) == MakeNacp(ids[500]).lang[SetLanguage_ENUS].name);
+        CHECK(nxtcLoadApplicationMetadataViewIcon(&view));
+        const auto icon = MakeIcon(ids[500], icon_size);
+        CHECK(view.icon_data && view.icon_size == icon.size() && std::memcmp(view.icon_data, icon.data(), icon.size()) == 0);
+        nxtcReleaseApplicationMetadataView(&view);
+    }
+
+    // 纹理上传后释放图标字节，再次加载时从缓存文件读取；锁定期间和其他视图仍在借用时保留
+    // Icon bytes are freed after the texture upload and read from the cache file on the next load; they are kept while
+    // pinned and while another view still borrows the entry
+    CHECK(nxtcBorrowApplicationMetadataById(ids[600], &view));
+    auto icon_data = tj::IconData::FromTitleCache(view);
+    const auto icon = MakeIcon(ids[600], icon_size);
+    const auto pinned_matches = [&] {
+        auto pinned = icon_data->Load();
+        return pinned && icon_data->data() && std::memcmp(icon_data->data(), icon.data(), icon.size()) == 0;
+    };
+    CHECK(icon_data && pinned_matches());
+    if (icon_data) {
+        {
+            auto pinned = icon_data->Load();
+            std::thread([&] { icon_data->Unload(); }).join();
+            CHECK(icon_data->data() != nullptr);
+        }
+        NxTitleCacheApplicationMetadataView other{};
+        CHECK(nxtcBorrowApplicationMetadataById(ids[600], &other));
+        icon_data->Unload();
+        CHECK(icon_data->Load() && icon_data->data() != nullptr);
+        nxtcReleaseApplicationMetadataView(&other);
+        icon_data->Unload();
+        CHECK(icon_data->data() == nullptr);
+        CHECK(pinned_matches());
+    }
+    icon_data.reset();
+
+    // 启动后新增的条目写入缓存文件之后才能释放 (Entries added after startup can only be freed once the cache file is written)
+    const u64 added_id = 0x0100000000010000ull + (ids.size() << 16);
+    AddTitles({added_id}, icon_size, false);
+    CHECK(nxtcBorrowApplicationMetadataById(added_id, &view));
+    CHECK(!nxtcUnloadApplicationMetadataViewIcon(&view) && view.icon_data);
+    nxtcFlushCacheFile();
+    CHECK(nxtcUnloadApplicationMetadataViewIcon(&view) && !view.icon_data);
+    CHECK(nxtcLoadApplicationMetadataViewIcon(&view));
+    const auto added_icon = MakeIcon(added_id, icon_size);
+    CHECK(view.icon_data && std::memcmp(view.icon_data, added_icon.data(), added_icon.size()) == 0);
+    nxtcReleaseApplicationMetadataView(&view);
+    nxtcExit();
+
+    // 替换中断后遗留的临时文件在下次加载时恢复 (A temp file left by an interrupted swap is restored on the next load)
+    std::rename(cache_path.c_str(), (cache_path + ".tmp").c_str());
+    CHECK(nxtcInitialize());
+    CHECK(nxtcCheckIfEntryExists(ids[0]));
+    nxtcWipeCache();
+    nxtcExit();
+    CHECK(!FileExists(cache_path));
+
+    for (int i = 0; i < 2; ++i) {
+        std::printf("  %zu shuffled titles, %zu KiB icons: per-entry adds %.1f ms, one batch %.1f ms\n",
+            shuffled.size(), add_icon_sizes[i] / 1024, per_entry_ms[i], batch_ms[i]);
+    }
+    std::printf("  %zu titles: lookup %.3f us\n", ids.size(), lookup_us);
+    std::printf("  %zu titles, 32 KiB icons: full init %.2f ms, lazy init %.2f ms\n",
+        ids.size(), full_init_ms, lazy_init_ms);
+}
+
+// Makefile在chroot的根目录放置的标记 (Marker the Makefile puts in the chroot's root directory)
+bool IsChrooted() {
+    return FileExists("/.host_bench_root");
+}
+
+// 合成MOD中的一个文件，路径相对于MOD目录 (A file of a synthetic MOD, path relative to the MOD directory)
+struct SyntheticFile {
+    std::string path;
+    size_t size;
+};
+
+struct ModShape {
+    const char* name;
+    std::vector<SyntheticFile> files;
+};
+
+// 三种形状：大量小文件、少量大文件、深目录树，每种用不同的标题ID
+// (Three shapes: many small files, a few huge files, a deep tree, each under its own title ID)
+std::vector<ModShape> MakeModShapes() {
+    std::vector<ModShape> shapes;
+
+    ModShape small{"small", {}};
+    for (int i = 0; i < 3000; ++i) {
+        char path[96];
+        std::snprintf(path, sizeof(path), "contents/0100000000A10000/romfs/d%02d/f%04d.bin", i % 30, i);
+        small.files.push_back({path, 4 * 1024});
+    }
+    shapes.push_back(std::move(small));
+
+    ModShape huge{"huge", {}};
+    for (int i = 0; i < 4; ++i) {
+        char path[96];
+        std::snprintf(path, sizeof(path), "contents/0100000000A20000/romfs/pack%d.arc", i);
+        huge.files.push_back({path, 32 * 1024 * 1024});
+    }
+    shapes.push_back(std::move(huge));
+
+    ModShape deep{"deep", {}};
+    std::string dir = "contents/0100000000A30000/romfs";
+    for (int level = 0; level < 32; ++level) {
+        dir += "/l" + std::to_string(level);
+        for (int i = 0; i < 8; ++i) {
+            deep.files.push_back({dir + "/f" + std::to_string(i) + ".bin", 16 * 1024});
+        }
+    }
+    shapes.push_back(std::move(deep));
+
+    return shapes;
+}
+
+// 一半字节取自16个值，压缩率与常见的资源文件相近 (Half the bytes come from 16 values, compressing about like common
+// asset files)
+std::vector<unsigned char> MakeFileData(size_t size, u32 seed) {
+    std::vector<unsigned char> data(size);
+    std::mt19937 rng(seed);
+    for (size_t i = 0; i < size; i += 4) {
+        const u32 value = rng();
+        for (size_t b = 0; b < 4 && i + b < size; ++b) {
+            data[i + b] = static_cast<unsigned char>(b % 2 ? (value >> (b * 8)) & 0x0F : value >> (b * 8));
+        }
+    }
+    return data;
+}
+
+void MakeParentDirs(const std::string& path) {
+    for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+        mkdir(path.substr(0, pos).c_str(), 0755);
+    }
+}
+
+bool WriteMod(const ModShape& shape, const std::string& mod_path, bool zip) {
+    mkdir(mod_path.c_str(), 0755);
+
+    mz_zip_archive archive{};
+    const std::string zip_path = mod_path + "/" + shape.name + ".zip";
+    if (zip && !mz_zip_writer_init_file(&archive, zip_path.c_str(), 0)) {
+        return false;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < shape.files.size() && ok; ++i) {
+        const auto& file = shape.files[i];
+        const auto data = MakeFileData(file.size, static_cast<u32>(i + 1));
+        if (zip) {
+            ok = mz_zip_writer_add_mem(&archive, file.path.c_str(), data.data(), data.size(), MZ_BEST_SPEED);
+            continue;
+        }
+
+        const std::string path = mod_path + "/" + file.path;
+        MakeParentDirs(path);
+        FILE* fp = std::fopen(path.c_str(), "wb");
+        ok = fp && std::fwrite(data.data(), 1, data.size(), fp) == data.size();
+        if (fp) {
+            std::fclose(fp);
+        }
+    }
+
+    if (zip) {
+        ok = mz_zip_writer_finalize_archive(&archive) && ok;
+        mz_zip_writer_end(&archive);
+    }
+    return ok;
+}
+
+bool TargetsMatch(const ModShape& shape, bool installed) {
+    for (const auto& file : shape.files) {
+        struct stat st;
+        const bool exists = stat(("/atmosphere/" + file.path).c_str(), &st) == 0;
+        if (exists != installed || (exists && static_cast<size_t>(st.st_size) != file.size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct ModTimings {
+    double install_ms;
+    double preview_ms;
+    double crc_check_ms;
+    double uninstall_ms;
+    double serial_extract_ms;
+    double pipelined_extract_ms;
+};
+
+// 同一个ZIP计划分别用extractMod和extractModPipelined解压，不含计划、日志和清单的开销
+// (Extract the same ZIP plan with extractMod and with extractModPipelined, without the plan, journal and manifest costs)
+void CompareZipExtraction(const ModShape& shape, const std::string& mod_path, ModTimings& timings) {
+    ModManager mod_manager;
+    auto on_error = [](const std::string&) {};
+
+    for (bool pipelined : {false, true}) {
+        ModManager::InstallPlan plan;
+        CHECK(mod_manager.PlanInstall(mod_path, plan, nullptr, on_error));
+        CHECK(plan.is_zip && plan.files.size() == shape.files.size());
+
+        std::vector<std::string> directories = plan.directories;
+        CHECK(mod_manager.createDirectoriesBatch(directories, nullptr, plan.files.size(), on_error, {}));
+
+        std::vector<int> files_to_extract;
+        for (const auto& planned_file : plan.files) {
+            files_to_extract.push_back(planned_file.zip_index);
+        }
+        int files_total = static_cast<int>(files_to_extract.size());
+
+        bool ok = false;
+        double& ms = pipelined ? timings.pipelined_extract_ms : timings.serial_extract_ms;
+        ms = TimeMs([&] {
+            ok = pipelined
+                ? mod_manager.extractModPipelined(plan.source_path, files_total, files_to_extract, nullptr, on_error, {}, plan.zip_archive.get())
+                : mod_manager.extractMod(plan.source_path, files_total, files_to_extract, nullptr, on_error, {}, plan.zip_archive.get());
+        });
+        CHECK(ok);
+        CHECK(TargetsMatch(shape, true));
+
+        // 没有安装清单，卸载回退到读取ZIP (No install manifest, so the uninstall falls back to reading the ZIP)
+        plan = {};
+        CHECK(mod_manager.getModInstallType(mod_path, 0, nullptr, on_error));
+        CHECK(TargetsMatch(shape, false));
+    }
+}
+
+// 安装、对同内容副本做冲突预览和CRC32校验、卸载 (Install, run the conflict preview and CRC32 check for an identical
+// copy, uninstall)
+ModTimings RunMod(const ModShape& shape, bool zip) {
+    const std::string game_path = "/mods2/BenchGame/0100000000A00000";
+    const std::string mod_name = std::string(shape.name) + (zip ? "-zip" : "-folder");
+    const std::string mod_path = game_path + "/" + mod_name;
+    const std::string copy_path = mod_path + "-copy";
+    CHECK(WriteMod(shape, mod_path, zip));
+    CHECK(WriteMod(shape, copy_path, zip));
+
+    ModTimings timings{};
+    ModManager mod_manager;
+    std::string last_error;
+    auto on_error = [&](const std::string& message) { last_error = message; };
+
+    // 安装到一半时取消，按安装日志回滚后不留下目标文件、清单和日志 (Cancel halfway through the install; the rollback
+    // from the install journal leaves no target file, manifest or journal behind)
+    std::stop_source cancel;
+    auto cancel_halfway = [&](int current, int total, const std::string&, bool, float, const std::string& dialog_title, const int*) {
+        if (dialog_title.empty() && current * 2 >= total) {
+            cancel.request_stop();
+        }
+    };
+    bool ok = mod_manager.getModInstallType(mod_path, 1, cancel_halfway, on_error, cancel.get_token());
+    CHECK(!ok && cancel.stop_requested());
+    CHECK(TargetsMatch(shape, false));
+    CHECK(!FileExists("/atmosphere/" + shape.files[0].path.substr(0, shape.files[0].path.find('/', 9))));
+    CHECK(!FileExists(mod_manager.GetModManifestPath(mod_path)));
+    CHECK(!FileExists(tj::InstallJournal::JOURNAL_PATH));
+
+    timings.install_ms = TimeMs([&] { ok = mod_manager.getModInstallType(mod_path, 1, nullptr, on_error); });
+    CHECK(ok);
+    CHECK(TargetsMatch(shape, true));
+    CHECK(FileExists(mod_manager.GetModManifestPath(mod_path)));
+    CHECK(!FileExists(tj::InstallJournal::JOURNAL_PATH));
+
+    // 副本的所有目标都已存在且归已安装的MOD所有 (Every target of the copy exists and is owned by the installed MOD)
+    ModManager::InstallPlan plan;
+    timings.preview_ms = TimeMs([&] { ok = mod_manager.PlanInstall(copy_path, plan, nullptr, on_error); });
+    CHECK(ok);
+    CHECK(plan.files.empty() && plan.existing_files.size() == shape.files.size());
+    CHECK(plan.conflict_owners == std::vector<std::string>{mod_name});
+
+    // 内容相同，逐个校验CRC32后以重复MOD拒绝，不写入任何文件 (Same content, so every CRC32 is checked and the copy is
+    // refused as a duplicate without writing anything)
+    last_error.clear();
+    timings.crc_check_ms = TimeMs([&] { ok = mod_manager.InstallFromPlan(plan, nullptr, on_error); });
+    CHECK(!ok && !last_error.empty());
+    plan = {};
+
+    // 卸载回放安装清单，由RemoveModFilesFromCache按目录并行删除 (Uninstall replays the install manifest,
+    // RemoveModFilesFromCache deletes by directory in parallel)
+    timings.uninstall_ms = TimeMs([&] { ok = mod_manager.getModInstallType(mod_path, 0, nullptr, on_error); });
+    CHECK(ok);
+    CHECK(TargetsMatch(shape, false));
+    CHECK(!FileExists("/atmosphere/" + shape.files[0].path.substr(0, shape.files[0].path.find('/', 9))));
+    CHECK(!FileExists(mod_manager.GetModManifestPath(mod_path)));
+
+    if (zip) {
+        CompareZipExtraction(shape, mod_path, timings);
+    }
+    return timings;
+}
+
+void BenchMods() {
+    if (!IsChrooted()) {
+        std::printf("  skipped: not chrooted into build/work\n");
+        return;
+    }
+    // 与真实SD卡一样，atmosphere的contents和exefs_patches目录总是存在 (Like a real SD card, atmosphere's contents and
+    // exefs_patches directories always exist)
+    MakeParentDirs("/atmosphere/contents/");
+    MakeParentDirs("/atmosphere/exefs_patches/");
+    MakeParentDirs("/mods2/BenchGame/0100000000A00000/");
+
+    for (const auto& shape : MakeModShapes()) {
+        size_t bytes = 0;
+        for (const auto& file : shape.files) {
+            bytes += file.size;
+        }
+        const double files = static_cast<double>(shape.files.size());
+        const double mib = bytes / (1024.0 * 1024.0);
+
+        for (bool zip : {false, true}) {
+            const ModTimings t = RunMod(shape, zip);
+            auto rate = [&](const char* what, double ms) {
+                std::printf("    %-17s %9.0f files/s %9.1f MB/s\n", what, files * 1000.0 / ms, mib * 1000.0 / ms);
+            };
+            std::printf("  %s %s, %zu files, %.1f MiB\n", shape.name, zip ? "zip" : "folder", shape.files.size(), mib);
+            rate("install", t.install_ms);
+            if (zip) {
+                rate("serial extract", t.serial_extract_ms);
+                rate("pipelined extract", t.pipelined_extract_ms);
+            }
+            rate("uninstall", t.uninstall_ms);
+            rate("conflict preview", t.preview_ms);
+            rate("crc check", t.crc_check_ms);
+        }
+    }
+    // ZIP的CRC32来自中央目录，已安装目标的CRC32来自缓存，两边都不读文件内容 (ZIP CRC32s come from the central
+    // directory and installed targets' from the cache, so neither side reads file contents)
+    std::printf("  zip crc checks read no file contents (central directory + CRC32 cache)\n");
+}
+
+// 500个游戏目录，每个的modid目录下50个MOD (500 game directories with 50 MODs under each modid directory)
+void BenchGameDirScanner() {
+    if (!IsChrooted()) {
+        std::printf("  skipped: not chrooted into build/work\n");
+        return;
+    }
+
+    const size_t game_count = 500;
+    const int mods_per_game = 50;
+    std::vector<std::string> dirnames;
+    for (size_t i = 0; i < game_count; ++i) {
+        char game[32];
+        char modid[32];
+        std::snprintf(game, sizeof(game), "Game%03zu", i);
+        std::snprintf(modid, sizeof(modid), "%016llX", 0x0100000000010000ull + (static_cast<unsigned long long>(i) << 16));
+        const std::string modid_path = std::string("/mods2/") + game + "/" + modid;
+        MakeParentDirs(modid_path + "/");
+        for (int m = 0; m < mods_per_game; ++m) {
+            mkdir((modid_path + "/Mod" + std::to_string(m)).c_str(), 0755);
+        }
+        dirnames.push_back(game);
+    }
+    // 收藏分隔标记直接完成 (The favorites marker completes immediately)
+    dirnames.insert(dirnames.begin() + 10, "END::FAVORITES");
+
+    std::vector<tj::GameDirScanResult> serial(dirnames.size());
+    const double serial_ms = BestMs(3, [&] {
+        for (size_t i = 0; i < dirnames.size(); ++i) {
+            if (dirnames[i] != "END::FAVORITES") {
+                serial[i] = tj::GameDirScanner::ScanGameDir("/mods2/" + dirnames[i]);
+            }
+        }
+    });
+
+    // 按列表顺序取结果，与主页加载一致；首屏按8个计 (Take results in list order like the home screen load; the first
+    // screen counts as 8)
+    const size_t first_screen = 8;
+    double first_screen_ms = 1e30;
+    const double scanner_ms = BestMs(3, [&] {
+        tj::GameDirScanner scanner;
+        auto start = BenchClock::now();
+        scanner.Start(dirnames);
+        for (size_t i = 0; i < dirnames.size(); ++i) {
+            tj::GameDirScanResult result;
+            CHECK(scanner.Wait(i, result, {}));
+            CHECK(result.application_id == serial[i].application_id && result.mod_count == serial[i].mod_count);
+            if (i + 1 == first_screen) {
+                first_screen_ms = std::min(first_screen_ms,
+                    std::chrono::duration<double, std::milli>(BenchClock::now() - start).count());
+            }
+        }
+    });
+
+    CHECK(serial[0].application_id == 0x0100000000010000ull && serial[0].mod_count == std::to_string(mods_per_game));
+    CHECK(serial[10].application_id == 0 && serial[10].modid_name.empty());
+
+    std::printf("  %zu games x %d MODs: serial %.2f ms, %zu workers %.2f ms, first %zu results %.3f ms (%u host CPUs)\n",
+        game_count, mods_per_game, serial_ms, tj::GameDirScanner::WORKER_COUNT, scanner_ms, first_screen,
+        first_screen_ms, std::thread::hardware_concurrency());
+}
+
+// 空渲染器：不绘制任何东西，只记录每次nvgText提交的字形范围 (Null renderer: draws nothing, only records the glyph
+// extent of every nvgText submission)
+struct NullRenderer {
+    int atlas_width{0};
+    int atlas_height{0};
+    std::vector<std::pair<float, float>> text_runs; // 每次提交的最小和最大x (Min and max x of every submission)
+};
+
+NVGcontext* CreateNullContext(NullRenderer& renderer) {
+    NVGparams params{};
+    params.userPtr = &renderer;
+    params.renderCreate = [](void*) { return 1; };
+    params.renderCreateTexture = [](void* uptr, int, int w, int h, int, const unsigned char*) {
+        auto* r = static_cast<NullRenderer*>(uptr);
+        r->atlas_width = w;
+        r->atlas_height = h;
+        return 1;
+    };
+    params.renderDeleteTexture = [](void*, int) { return 1; };
+    params.renderUpdateTexture = [](void*, int, int, int, int, int, const unsigned char*) { return 1; };
+    params.renderGetTextureSize = [](void* uptr, int, int* w, int* h) {
+        auto* r = static_cast<NullRenderer*>(uptr);
+        *w = r->atlas_width;
+        *h = r->atlas_height;
+        return 1;
+    };
+    params.renderViewport = [](void*, float, float, float) {};
+    params.renderCancel = [](void*) {};
+    params.renderFlush = [](void*) {};
+    params.renderFill = [](void*, NVGpaint*, NVGcompositeOperationState, NVGscissor*, float, const float*, const NVGpath*, int) {};
+    params.renderStroke = [](void*, NVGpaint*, NVGcompositeOperationState, NVGscissor*, float, float, const NVGpath*, int) {};
+    params.renderTriangles = [](void* uptr, NVGpaint*, NVGcompositeOperationState, NVGscissor*, const NVGvertex* verts, int nverts, float) {
+        float min_x = 1e30f;
+        float max_x = -1e30f;
+        for (int i = 0; i < nverts; ++i) {
+            min_x = std::min(min_x, verts[i].x);
+            max_x = std::max(max_x, verts[i].x);
+        }
+        static_cast<NullRenderer*>(uptr)->text_runs.emplace_back(min_x, max_x);
+    };
+    params.renderDelete = [](void*) {};
+    return nvgCreateInternal(&params);
+}
+
+// 长的中文MOD说明，含几个段落 (Long CJK MOD descriptions with a few paragraphs)
+std::vector<std::string> MakeDescriptions(size_t count) {
+    const auto names = MakeNames(count * 24);
+    std::vector<std::string> descriptions;
+    for (size_t i = 0; i < count; ++i) {
+        std::string text;
+        for (size_t n = 0; n < 24; ++n) {
+            text += names[i * 24 + n];
+            text += n % 8 == 7 ? "\n" : "，";
+        }
+        descriptions.push_back(std::move(text));
+    }
+    return descriptions;
+}
+
+// 对话框正文：drawTextBoxCentered排版并绘制，文本不变时复用排版 (Dialog body: drawTextBoxCentered lays the text out and
+// draws it, reusing the layout while the text is unchanged)
+void BenchTextLayout() {
+    // Makefile把主机字体复制为font.ttf，中文字形没有时按.notdef排版，仍走完整的UTF-8解码和换行
+    // (The Makefile copies a host font to font.ttf; without CJK glyphs the text is laid out with .notdef, still going
+    // through the full UTF-8 decoding and line breaking)
+    if (!FileExists("font.ttf")) {
+        std::printf("  skipped: no font.ttf\n");
+        return;
+    }
+
+    NullRenderer renderer;
+    NVGcontext* vg = CreateNullContext(renderer);
+    CHECK(vg != nullptr);
+    CHECK(nvgCreateFont(vg, "Standard", "font.ttf") >= 0);
+    nvgFontFace(vg, "Standard");
+
+    const float width = 1000.f;
+    const float size = 28.f;
+    const auto descriptions = MakeDescriptions(100);
+    auto draw = [&](const std::string& text) {
+        nvgBeginFrame(vg, 1280.f, 720.f, 1.f);
+        tj::gfx::drawTextBoxCentered(vg, 140.f, 100.f, width, 500.f, size, 1.5f, text.c_str(), nullptr,
+            tj::gfx::Colour::WHITE);
+        nvgEndFrame(vg);
+    };
+
+    // 每行都不超过文本框宽度，行数受20行上限约束 (Every row fits the text box width and the row count is capped at 20)
+    renderer.text_runs.clear();
+    draw(descriptions[0]);
+    const auto first_runs = renderer.text_runs;
+    CHECK(first_runs.size() > 3 && first_runs.size() <= 20);
+    for (const auto& [min_x, max_x] : first_runs) {
+        CHECK(min_x >= 140.f - size && max_x <= 140.f + width + size);
+    }
+
+    // 重复绘制同一段文本走缓存，结果必须一致 (Redrawing the same text hits the cache and must give the same result)
+    const int frames = 2000;
+    renderer.text_runs.clear();
+    const double cached_us = BestMs(3, [&] {
+        for (int i = 0; i < frames; ++i) {
+            draw(descriptions[0]);
+        }
+    }) * 1000.0 / frames;
+    CHECK(renderer.text_runs.size() == first_runs.size() * frames * 3);
+    CHECK(std::equal(first_runs.begin(), first_runs.end(), renderer.text_runs.end() - first_runs.size()));
+
+    // 轮流绘制100段文本，超过64个缓存项，每次都重新排版 (Cycle through 100 texts, more than the 64 cache entries, so
+    // every draw lays the text out again)
+    const double uncached_us = BestMs(3, [&] {
+        for (int i = 0; i < frames; ++i) {
+            draw(descriptions[i % descriptions.size()]);
+        }
+    }) * 1000.0 / frames;
+
+    size_t bytes = 0;
+    for (const auto& text : descriptions) {
+        bytes += text.size();
+    }
+    nvgDeleteInternal(vg);
+
+    std::printf("  %zu descriptions, %zu bytes avg, %zu rows: cached layout %.2f us/frame, new layout %.2f us/frame\n",
+        descriptions.size(), bytes / descriptions.size(), first_runs.size(), cached_us, uncached_us);
+}
+
+std::u16string ToPtpString(const std::string& utf8, size_t max_len = haze::PtpStringMaxLength) {
+    std::u16string units(max_len, u'\0');
+    const size_t written = haze::ConvertUtf8ToPtpString(reinterpret_cast<u16*>(units.data()), max_len, utf8.c_str());
+    units.resize(written);
+    return units;
+}
+
+std::string FromPtpString(const std::u16string& units) {
+    std::string utf8(haze::PtpStringMaxUtf8Length + 1, '\0');
+    const size_t written = haze::ConvertPtpStringToUtf8(utf8.data(), reinterpret_cast<const u16*>(units.data()), units.size());
+    utf8.resize(written);
+    return utf8;
+}
+
+// MTP文件名的UTF-8与UTF-16互转 (UTF-8 <-> UTF-16 conversion of MTP file names)
+void BenchPtpString() {
+    // 中文、拉丁和四字节字符往返不变 (CJK, Latin and four-byte characters round-trip unchanged)
+    for (const std::string name : {"Mario.zip", "超级马力欧 HD", "Pokémon", "😀 表情 mod", ""}) {
+        CHECK(FromPtpString(ToPtpString(name)) == name);
+    }
+    CHECK(ToPtpString("超级") == u"超级");
+
+    // 四字节字符编码为代理对，截断时不拆开代理对 (Four-byte characters become surrogate pairs, truncation never splits a pair)
+    CHECK(ToPtpString("😀") == std::u16string({0xD83D, 0xDE00}));
+    CHECK(ToPtpString("😀", 1).empty());
+    CHECK(ToPtpString("a😀", 2) == u"a");
+
+    // 主机发来的不成对代理项变成U+FFFD，空字符结束转换 (Unpaired surrogates from the host become U+FFFD, a null code unit
+    // ends the conversion)
+    CHECK(FromPtpString(std::u16string({0xD83D, u'a'})) == "\xEF\xBF\xBD" "a");
+    CHECK(FromPtpString(std::u16string({0xDC10})) == "\xEF\xBF\xBD");
+    CHECK(FromPtpString(std::u16string({u'a', 0, u'b'})) == "a");
+
+    // 不合法的UTF-8逐字节转义为U+DC80-U+DCFF，转回后字节不变：任意字节、过长编码、编码的代理项、截断的序列
+    // (Invalid UTF-8 is escaped byte by byte as U+DC80-U+DCFF and decodes back to the same bytes: stray bytes, overlong
+    // forms, encoded surrogates, truncated sequences)
+    CHECK(ToPtpString("\xFF\xFE") == std::u16string({0xDCFF, 0xDCFE}));
+    for (const std::string name : {"\xFF\xFE", "a\xC0\xAF" "b", "\xED\xA0\x80", "\xF4\x90\x80\x80", "mod\xE8\x80", "GBK\xB3\xAC\xBC\xB6"}) {
+        const auto units = ToPtpString(name);
+        CHECK(units.size() == name.size());
+        CHECK(FromPtpString(units) == name);
+    }
+
+    // 最长的名称转回UTF-8后不超过缓冲区 (The longest name fits the UTF-8 buffer after converting back)
+    std::string longest;
+    for (u32 i = 0; i < haze::PtpStringMaxLength; ++i) {
+        longest += "超";
+    }
+    const auto longest_units = ToPtpString(longest);
+    CHECK(longest_units.size() == haze::PtpStringMaxLength);
+    CHECK(FromPtpString(longest_units).size() == haze::PtpStringMaxLength * 3);
+
+    const auto names = MakeNames(5000);
+    size_t round_trips = 0;
+    const double us = BestMs(5, [&] {
+        round_trips = 0;
+        for (const auto& name : names) {
+            round_trips += FromPtpString(ToPtpString(name)) == name;
+        }
+    }) * 1000.0 / names.size();
+    CHECK(round_trips == names.size());
+
+    std::printf("  %zu mixed CJK/Latin names: round trip %.3f us\n", names.size(), us);
+}
+
+struct Section {
+    const char* name;
+    void (*run)();
+};
+
+const Section SECTIONS[] = {
+    {"collation", BenchCollation},
+    {"search", BenchSearch},
+    {"conflict", BenchConflictIndex},
+    {"manifest", BenchManifest},
+    {"snapshot", BenchCatalogSnapshot},
+    {"frames", BenchFrameScheduler},
+    {"nxtc", BenchNxtc},
+    {"mods", BenchMods},
+    {"scanner", BenchGameDirScanner},
+    {"text", BenchTextLayout},
+    {"ptp", BenchPtpString},
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    for (const auto& section : SECTIONS) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) {
+            selected = selected || std::strcmp(argv[i], section.name) == 0;
+        }
+        if (!selected) {
+            continue;
+        }
+
+        std::printf("[%s]\n", section.name);
+        const int failures = g_failures;
+        section.run();
+        std::printf("  %s\n", g_failures == failures ? "ok" : "FAILED");
+    }
+
+    return g_failures == 0 ? 0 : 1;
+}
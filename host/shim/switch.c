@@ -0,0 +1,11 @@
+/*
+ * switch.c - libnx替身的实现，CRC32使用自带的miniz
+ * switch.c - implementation of the libnx stand-in, CRC32 uses the bundled miniz
+ */
+#include <switch.h>
+#include "miniz.h"
+
+u32 crc32CalculateWithSeed(u32 seed, const void *src, size_t size)
+{
+    return (u32)mz_crc32(seed, (const unsigned char*)src, size);
+}
@@ -0,0 +1,98 @@
+/*
+ * switch.h - 主机构建用的libnx替身，只提供host/下编译的模块实际用到的部分
+ * switch.h - libnx stand-in for the host build, providing only what the modules compiled under host/ actually use
+ *
+ * 主机测试程序是单线程的，Mutex只记录是否已加锁
+ * The host test program is single-threaded, so a Mutex only records whether it is locked
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef int64_t s64;
+typedef u32 Result;
+
+#define R_SUCCEEDED(res) ((res) == 0)
+#define R_FAILED(res)    ((res) != 0)
+#define NX_INLINE        __attribute__((always_inline)) static inline
+#define BIT(n)           (1U << (n))
+
+/* CRC32：与libnx的硬件实现一致，即zlib的crc32()语义 (CRC32: same as libnx's hardware version, i.e. zlib's crc32()) */
+u32 crc32CalculateWithSeed(u32 seed, const void *src, size_t size);
+
+NX_INLINE u32 crc32Calculate(const void *src, size_t size)
+{
+    return crc32CalculateWithSeed(0, src, size);
+}
+
+/* 互斥锁 (Mutex) */
+typedef u32 Mutex;
+
+NX_INLINE void mutexLock(Mutex *mutex) { *mutex = 1; }
+NX_INLINE void mutexUnlock(Mutex *mutex) { *mutex = 0; }
+NX_INLINE bool mutexIsLockedByCurrentThread(const Mutex *mutex) { return *mutex != 0; }
+
+/* 系统语言，主机上固定为美式英语 (System language, fixed to American English on the host) */
+typedef enum {
+    SetLanguage_JA     = 0,
+    SetLanguage_ENUS   = 1,
+    SetLanguage_FR     = 2,
+    SetLanguage_DE     = 3,
+    SetLanguage_IT     = 4,
+    SetLanguage_ES     = 5,
+    SetLanguage_ZHCN   = 6,
+    SetLanguage_KO     = 7,
+    SetLanguage_NL     = 8,
+    SetLanguage_PT     = 9,
+    SetLanguage_RU     = 10,
+    SetLanguage_ZHTW   = 11,
+    SetLanguage_ENGB   = 12,
+    SetLanguage_FRCA   = 13,
+    SetLanguage_ES419  = 14,
+    SetLanguage_ZHHANS = 15,
+    SetLanguage_ZHHANT = 16,
+    SetLanguage_PTBR   = 17,
+    SetLanguage_Total,
+} SetLanguage;
+
+NX_INLINE Result setInitialize(void) { return 0; }
+NX_INLINE void setExit(void) {}
+NX_INLINE Result setGetSystemLanguage(u64 *language_code) { *language_code = 0; return 0; }
+NX_INLINE Result setMakeLanguage(u64 language_code, SetLanguage *language) { (void)language_code; *language = SetLanguage_ENUS; return 0; }
+
+/* NACP，只保留libnxtc读取的字段 (NACP, only the fields libnxtc reads) */
+typedef struct {
+    char name[0x200];
+    char author[0x100];
+} NacpLanguageEntry;
+
+typedef struct {
+    NacpLanguageEntry lang[16];
+    char display_version[0x10];
+} NacpStruct;
+
+/* 文件系统：主机上没有需要提交的SD卡 (Filesystem: there is no SD card to commit on the host) */
+#define FS_MAX_PATH 0x301
+
+typedef struct {
+    u32 unused;
+} FsFileSystem;
+
+NX_INLINE Result fsFsCommit(FsFileSystem *fs) { (void)fs; return 0; }
+
+#ifdef __cplusplus
+}
+#endif
@@ -18,6 +18,7 @@
 #include <haze/async_usb_server.hpp>
 #include <haze/common.hpp>
 #include <haze/ptp.hpp>
+#include <haze/ptp_string.hpp>
 
 namespace haze {
 
@@ -139,17 +140,17 @@ namespace haze {
                 R_SUCCEED();
             }
 
-            template <typename T>
-            Result AddString(const T *str) {
+            Result AddString(const char *str) {
                 /* Use one less than the maximum string length for maximum length with null terminator. */
-                const u8 len = static_cast<u8>(std::min<s32>(util::Strlen(str), PtpStringMaxLength - 1));
+                u16 units[PtpStringMaxLength - 1];
+                const u8 len = static_cast<u8>(ConvertUtf8ToPtpString(units, util::size(units), str));
 
                 if (len > 0) {
                     /* Length is padded by null terminator for non-empty strings. */
                     R_TRY(this->Add<u8>(len + 1));
 
                     for (size_t i = 0; i < len; i++) {
-                        R_TRY(this->Add<u16>(str[i]));
+                        R_TRY(this->Add<u16>(units[i]));
                     }
 
                     R_TRY(this->Add<u16>(0));
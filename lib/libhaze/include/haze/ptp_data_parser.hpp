@@ -18,6 +18,7 @@
 #include <haze/async_usb_server.hpp>
 #include <haze/common.hpp>
 #include <haze/ptp.hpp>
+#include <haze/ptp_string.hpp>
 
 namespace haze {
 
@@ -97,22 +98,20 @@ namespace haze {
                 R_SUCCEED();
             }
 
-            /* NOTE: out_string must contain room for 256 bytes. */
-            /* The result will be null-terminated on successful completion. */
+            /* NOTE: out_string must contain room for PtpStringMaxUtf8Length + 1 bytes. */
+            /* The result will be UTF-8 and null-terminated on successful completion. */
             Result ReadString(char *out_string) {
                 u8 len;
                 R_TRY(this->Read(std::addressof(len)));
 
-                /* Read characters one by one. */
+                /* Read code units one by one. */
+                u16 units[PtpStringMaxLength];
                 for (size_t i = 0; i < len; i++) {
-                    u16 chr;
-                    R_TRY(this->Read(std::addressof(chr)));
-
-                    *out_string++ = static_cast<char>(chr);
+                    R_TRY(this->Read(std::addressof(units[i])));
                 }
 
-                /* Write null terminator. */
-                *out_string++ = '\x00';
+                /* Convert to UTF-8, this also writes the null terminator. */
+                ConvertPtpStringToUtf8(out_string, units, len);
 
                 R_SUCCEED();
             }
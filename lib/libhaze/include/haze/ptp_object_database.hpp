@@ -18,6 +18,7 @@
 #include <haze/common.hpp>
 #include <haze/ptp_object_heap.hpp>
 #include <vapours/util.hpp>
+#include <vector>
 
 namespace haze {
 
@@ -88,8 +89,12 @@ namespace haze {
             ObjectNameTree m_name_tree;
             ObjectIdTree m_object_id_tree;
             u32 m_next_object_id;
+
+            /* Directories in the order the host last enumerated them. When the heap is exhausted, the children of the */
+            /* least recently enumerated directory are evicted, so browsing a large card keeps the heap bounded. */
+            std::vector<u32> m_enumerated_directories;
         public:
-            constexpr explicit PtpObjectDatabase() : m_object_heap(), m_name_tree(), m_object_id_tree(), m_next_object_id() { /* ... */ }
+            constexpr explicit PtpObjectDatabase() : m_object_heap(), m_name_tree(), m_object_id_tree(), m_next_object_id(), m_enumerated_directories() { /* ... */ }
 
             void Initialize(PtpObjectHeap *object_heap);
             void Finalize();
@@ -101,6 +106,12 @@ namespace haze {
             void DeleteObject(PtpObject *obj);
 
             Result CreateAndRegisterObjectId(const char *parent_name, const char *name, u32 parent_id, u32 storage_id, u32 *out_object_id);
+
+            /* Directory enumeration tracking API. */
+            void MarkDirectoryEnumerated(u32 object_id);
+        private:
+            void EvictDirectoryChildren(u32 object_id);
+            bool EvictLeastRecentDirectory();
         public:
             PtpObject *GetObjectById(u32 object_id);
             PtpObject *GetObjectByName(const char *name);
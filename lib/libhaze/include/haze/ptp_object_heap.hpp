@@ -21,16 +21,27 @@ namespace haze {
 
     /* This simple linear allocator implementation allows us to rapidly reclaim the entire object graph. */
     /* This is critical for maintaining interactivity when a session is closed. */
+    /* Small allocations are rounded up to a size class, and freed ones are kept on a per-class free list for reuse, */
+    /* so objects evicted or deleted during a session do not permanently consume the heap. */
     class PtpObjectHeap {
         private:
             static constexpr size_t NumHeapBlocks = 2;
+            static constexpr size_t FreeListGranularity = 16;
+            static constexpr size_t MaxFreeListSize = 1024;
+            static constexpr size_t NumFreeLists = MaxFreeListSize / FreeListGranularity;
+
+            struct FreeNode {
+                FreeNode *m_next;
+            };
         private:
             void *m_heap_blocks[NumHeapBlocks];
             void *m_next_address;
             u32 m_heap_block_size;
             u32 m_current_heap_block;
+            FreeNode *m_free_lists[NumFreeLists];
+            size_t m_free_size;
         public:
-            constexpr explicit PtpObjectHeap() : m_heap_blocks(), m_next_address(), m_heap_block_size(), m_current_heap_block() { /* ... */ }
+            constexpr explicit PtpObjectHeap() : m_heap_blocks(), m_next_address(), m_heap_block_size(), m_current_heap_block(), m_free_lists(), m_free_size() { /* ... */ }
 
             void Initialize();
             void Finalize();
@@ -40,9 +51,22 @@ namespace haze {
             }
 
             constexpr size_t GetUsedSize() const {
-                return (m_heap_block_size * m_current_heap_block) + this->GetNextAddress() - this->GetFirstAddress();
+                return (m_heap_block_size * m_current_heap_block) + this->GetNextAddress() - this->GetFirstAddress() - m_free_size;
             }
         private:
+            static constexpr size_t GetAllocationSize(size_t n) {
+                /* Round small allocations up to their size class, so freed blocks can serve any request of the same class. */
+                if (n <= MaxFreeListSize) {
+                    return util::AlignUp(n, FreeListGranularity);
+                }
+
+                return util::AlignUp(n, alignof(u64));
+            }
+
+            static constexpr size_t GetFreeListIndex(size_t n) {
+                return (n / FreeListGranularity) - 1;
+            }
+
             constexpr u8 *GetNextAddress()  const { return static_cast<u8 *>(m_next_address); }
             constexpr u8 *GetFirstAddress() const { return static_cast<u8 *>(m_heap_blocks[m_current_heap_block]); }
 
@@ -84,16 +108,48 @@ namespace haze {
 
                 return result;
             }
+
+            constexpr void PushFreeBlock(void *p, size_t n) {
+                FreeNode * const node = static_cast<FreeNode *>(p);
+                node->m_next = m_free_lists[GetFreeListIndex(n)];
+                m_free_lists[GetFreeListIndex(n)] = node;
+                m_free_size += n;
+            }
+
+            constexpr void *PopFreeBlock(size_t index) {
+                FreeNode * const node = m_free_lists[index];
+                m_free_lists[index] = node->m_next;
+                m_free_size -= (index + 1) * FreeListGranularity;
+                return node;
+            }
+
+            constexpr void *AllocateFromFreeLists(size_t n) {
+                /* Split the smallest larger free block, returning its unused tail to the free list of the tail's size class. */
+                for (size_t i = GetFreeListIndex(n) + 1; i < NumFreeLists; i++) {
+                    if (m_free_lists[i] != nullptr) {
+                        u8 * const result = static_cast<u8 *>(this->PopFreeBlock(i));
+                        this->PushFreeBlock(result + n, (i + 1) * FreeListGranularity - n);
+                        return result;
+                    }
+                }
+
+                return nullptr;
+            }
         public:
             template <typename T = void>
             constexpr T *Allocate(size_t n) {
                 /* Check for overflow in alignment. */
-                if (!util::CanAddWithoutOverflow(n, alignof(u64) - 1)) {
+                if (!util::CanAddWithoutOverflow(n, FreeListGranularity - 1)) {
                     return nullptr;
                 }
 
-                /* Align the amount to satisfy allocation for u64. */
-                n = util::AlignUp(n, alignof(u64));
+                /* Align the amount to satisfy allocation for u64, or round up to the size class. */
+                n = GetAllocationSize(n);
+
+                /* Reuse a previously freed block of the same size class if one is available. */
+                if (n <= MaxFreeListSize && m_free_lists[GetFreeListIndex(n)] != nullptr) {
+                    return static_cast<T *>(this->PopFreeBlock(GetFreeListIndex(n)));
+                }
 
                 /* Check if the allocation is possible. */
                 if (!this->AllocationIsPossible(n)) {
@@ -103,7 +159,8 @@ namespace haze {
                 /* If the allocation is not satisfyable now, we might be able to satisfy it on the next block. */
                 /* However, if the next block would be empty, we won't be able to satisfy the request. */
                 if (!this->AllocationIsSatisfyable(n) && !this->AdvanceToNextBlock()) {
-                    return nullptr;
+                    /* Once the heap is exhausted, fall back to splitting a larger freed block. */
+                    return n <= MaxFreeListSize ? static_cast<T *>(this->AllocateFromFreeLists(n)) : nullptr;
                 }
 
                 /* Allocate the memory. */
@@ -112,20 +169,24 @@ namespace haze {
 
             constexpr void Deallocate(void *p, size_t n) {
                 /* Check for overflow in alignment. */
-                if (!util::CanAddWithoutOverflow(n, alignof(u64) - 1)) {
+                if (!util::CanAddWithoutOverflow(n, FreeListGranularity - 1)) {
                     return;
                 }
 
-                /* Align the amount to satisfy allocation for u64. */
-                n = util::AlignUp(n, alignof(u64));
+                /* Align the amount the same way it was aligned when allocated. */
+                n = GetAllocationSize(n);
 
                 /* If the pointer was the last allocation, return the memory to the heap. */
                 if (static_cast<u8 *>(p) + n == this->GetNextAddress()) {
                     m_next_address = this->GetNextAddress() - n;
+                    return;
                 }
 
-                /* Otherwise, do nothing. */
-                /* ... */
+                /* Otherwise, keep small blocks on the free list of their size class. */
+                /* Larger blocks are only reclaimed when the heap is finalized. */
+                if (n <= MaxFreeListSize) {
+                    this->PushFreeBlock(p, n);
+                }
             }
     };
 
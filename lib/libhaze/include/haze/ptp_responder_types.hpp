@@ -169,10 +169,10 @@ namespace haze {
     static constexpr s64 DirectoryReadSize = 128;
 
     struct PtpBuffers {
-        char filename_string_buffer[PtpStringMaxLength + 1];
-        char capture_date_string_buffer[PtpStringMaxLength + 1];
-        char modification_date_string_buffer[PtpStringMaxLength + 1];
-        char keywords_string_buffer[PtpStringMaxLength + 1];
+        char filename_string_buffer[PtpStringMaxUtf8Length + 1];
+        char capture_date_string_buffer[PtpStringMaxUtf8Length + 1];
+        char modification_date_string_buffer[PtpStringMaxUtf8Length + 1];
+        char keywords_string_buffer[PtpStringMaxUtf8Length + 1];
 
         DirEntry file_system_entry_buffer[DirectoryReadSize];
 
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <haze/common.hpp>
+#include <haze/ptp.hpp>
+
+namespace haze {
+
+    /* PTP strings are UTF-16, while names on the filesystem are UTF-8. */
+    /* Bytes of a filesystem name that are not valid UTF-8 are sent as unpaired low surrogates U+DC80-U+DCFF */
+    /* and decoded back to the same byte, so every name the host sees maps back to the exact name on disk. */
+    constexpr inline u16 PtpStringEscapedByteBase = 0xDC00;
+    constexpr inline u16 PtpStringReplacementCharacter = 0xFFFD;
+
+    /* Every UTF-16 code unit expands to at most three UTF-8 bytes. */
+    constexpr inline u32 PtpStringMaxUtf8Length = PtpStringMaxLength * 3;
+
+    namespace impl {
+
+        constexpr inline bool IsUtf8Continuation(u8 c) {
+            return (c & 0xC0) == 0x80;
+        }
+
+        constexpr inline size_t EncodeUtf8(char *out, u32 cp) {
+            if (cp < 0x80) {
+                out[0] = static_cast<char>(cp);
+                return 1;
+            } else if (cp < 0x800) {
+                out[0] = static_cast<char>(0xC0 | (cp >> 6));
+                out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+                return 2;
+            } else if (cp < 0x10000) {
+                out[0] = static_cast<char>(0xE0 | (cp >> 12));
+                out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+                return 3;
+            } else {
+                out[0] = static_cast<char>(0xF0 | (cp >> 18));
+                out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+                return 4;
+            }
+        }
+
+        /* Decodes one UTF-8 sequence, returning its length or zero if it is not valid (overlong, surrogate, out of range or truncated). */
+        constexpr inline size_t DecodeUtf8(u32 *out_cp, const char *str) {
+            const u8 c = static_cast<u8>(str[0]);
+            if (c < 0x80) {
+                *out_cp = c;
+                return 1;
+            }
+
+            size_t len;
+            u32 cp, min;
+            if ((c & 0xE0) == 0xC0) {
+                len = 2; cp = c & 0x1F; min = 0x80;
+            } else if ((c & 0xF0) == 0xE0) {
+                len = 3; cp = c & 0x0F; min = 0x800;
+            } else if ((c & 0xF8) == 0xF0) {
+                len = 4; cp = c & 0x07; min = 0x10000;
+            } else {
+                return 0;
+            }
+
+            for (size_t i = 1; i < len; i++) {
+                /* The null terminator is not a continuation byte, so this never reads past the end. */
+                if (!IsUtf8Continuation(static_cast<u8>(str[i]))) {
+                    return 0;
+                }
+                cp = (cp << 6) | (str[i] & 0x3F);
+            }
+
+            if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+                return 0;
+            }
+
+            *out_cp = cp;
+            return len;
+        }
+
+    }
+
+    /* Converts a UTF-16 string received from the host into UTF-8. */
+    /* Conversion stops at the first null code unit. out must have room for PtpStringMaxUtf8Length + 1 bytes when len <= PtpStringMaxLength. */
+    constexpr inline size_t ConvertPtpStringToUtf8(char *out, const u16 *str, size_t len) {
+        size_t written = 0;
+
+        for (size_t i = 0; i < len && str[i] != 0; i++) {
+            const u16 unit = str[i];
+
+            if (unit >= 0xD800 && unit <= 0xDBFF && i + 1 < len && str[i + 1] >= 0xDC00 && str[i + 1] <= 0xDFFF) {
+                /* Surrogate pair. */
+                const u32 cp = 0x10000 + ((static_cast<u32>(unit - 0xD800) << 10) | (str[i + 1] - 0xDC00));
+                written += impl::EncodeUtf8(out + written, cp);
+                i++;
+            } else if (unit >= PtpStringEscapedByteBase + 0x80 && unit <= PtpStringEscapedByteBase + 0xFF) {
+                /* Escaped raw byte. */
+                out[written++] = static_cast<char>(unit & 0xFF);
+            } else if (unit >= 0xD800 && unit <= 0xDFFF) {
+                /* Any other unpaired surrogate has no UTF-8 form. */
+                written += impl::EncodeUtf8(out + written, PtpStringReplacementCharacter);
+            } else {
+                written += impl::EncodeUtf8(out + written, unit);
+            }
+        }
+
+        out[written] = '\x00';
+        return written;
+    }
+
+    /* Converts a null-terminated UTF-8 string into UTF-16 for the host, writing at most max_len code units. */
+    /* A surrogate pair is never split by truncation. Returns the number of code units written. */
+    constexpr inline size_t ConvertUtf8ToPtpString(u16 *out, size_t max_len, const char *str) {
+        const char *cur = str;
+        size_t written = 0;
+
+        while (*cur != 0) {
+            u32 cp;
+            size_t len = impl::DecodeUtf8(std::addressof(cp), cur);
+            if (len == 0) {
+                /* Not valid UTF-8, escape the byte so it can be decoded back. */
+                cp = PtpStringEscapedByteBase | static_cast<u8>(*cur);
+                len = 1;
+            }
+
+            if (cp >= 0x10000) {
+                if (written + 2 > max_len) {
+                    break;
+                }
+                out[written++] = static_cast<u16>(0xD800 + ((cp - 0x10000) >> 10));
+                out[written++] = static_cast<u16>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+            } else {
+                if (written + 1 > max_len) {
+                    break;
+                }
+                out[written++] = static_cast<u16>(cp);
+            }
+
+            cur += len;
+        }
+
+        return written;
+    }
+
+}
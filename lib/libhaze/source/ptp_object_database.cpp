@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <haze.hpp>
+#include <string>
 
 namespace haze {
 
@@ -25,6 +26,7 @@ namespace haze {
         std::construct_at(std::addressof(m_object_id_tree));
 
         m_next_object_id = 1;
+        m_enumerated_directories.clear();
     }
 
     void PtpObjectDatabase::Finalize() {
@@ -32,6 +34,8 @@ namespace haze {
         std::destroy_at(std::addressof(m_name_tree));
 
         m_next_object_id = 0;
+        m_enumerated_directories.clear();
+        m_enumerated_directories.shrink_to_fit();
 
         m_object_heap->Finalize();
         m_object_heap = nullptr;
@@ -48,7 +52,11 @@ namespace haze {
         const size_t alloc_len       = sizeof(PtpObject) + parent_name_len + separator_len + name_len + terminator_len;
 
         /* Allocate memory for the object. */
-        PtpObject * const object = m_object_heap->Allocate<PtpObject>(alloc_len);
+        /* If the heap is exhausted, evict the children of directories the host has not enumerated recently. */
+        PtpObject *object = m_object_heap->Allocate<PtpObject>(alloc_len);
+        while (object == nullptr && this->EvictLeastRecentDirectory()) {
+            object = m_object_heap->Allocate<PtpObject>(alloc_len);
+        }
         R_UNLESS(object != nullptr, haze::ResultOutOfMemory());
 
         /* Build the object name. */
@@ -141,6 +149,62 @@ namespace haze {
         R_SUCCEED();
     }
 
+    void PtpObjectDatabase::MarkDirectoryEnumerated(u32 object_id) {
+        /* Move the directory to the most recently enumerated position. */
+        if (auto it = std::find(m_enumerated_directories.begin(), m_enumerated_directories.end(), object_id); it != m_enumerated_directories.end()) {
+            m_enumerated_directories.erase(it);
+        }
+        m_enumerated_directories.push_back(object_id);
+    }
+
+    void PtpObjectDatabase::EvictDirectoryChildren(u32 object_id) {
+        auto * const directory = this->GetObjectById(object_id);
+        if (directory == nullptr) {
+            return;
+        }
+
+        /* All children of the directory sort directly after its name followed by a separator. */
+        std::string prefix(directory->GetName());
+        prefix += "/";
+
+        /* Directories the host is still browsing are kept, along with every ancestor of them, so their parent chain stays resolvable. */
+        std::vector<u32> kept;
+        for (const u32 enumerated_id : m_enumerated_directories) {
+            for (auto *object = this->GetObjectById(enumerated_id); object != nullptr && object->GetObjectId() != object_id; object = this->GetObjectById(object->GetParentId())) {
+                kept.push_back(object->GetObjectId());
+            }
+        }
+        std::sort(kept.begin(), kept.end());
+
+        size_t evicted = 0;
+        for (auto it = m_name_tree.nfind_key(prefix.c_str()); it != m_name_tree.end() && strncasecmp(it->GetName(), prefix.c_str(), prefix.size()) == 0; ) {
+            PtpObject * const object = std::addressof(*it);
+            ++it;
+
+            /* Skip grandchildren, and keep child directories that are or contain a directory the host is still browsing. */
+            if (object->GetParentId() != object_id || std::binary_search(kept.begin(), kept.end(), object->GetObjectId())) {
+                continue;
+            }
+
+            this->DeleteObject(object);
+            evicted++;
+        }
+
+        log_write("Evicted %zu children of object %u (%s)\n", evicted, object_id, directory->GetName());
+    }
+
+    bool PtpObjectDatabase::EvictLeastRecentDirectory() {
+        /* Never evict the children of the directory currently being enumerated. */
+        if (m_enumerated_directories.size() <= 1) {
+            return false;
+        }
+
+        const u32 object_id = m_enumerated_directories.front();
+        m_enumerated_directories.erase(m_enumerated_directories.begin());
+        this->EvictDirectoryChildren(object_id);
+        return true;
+    }
+
     PtpObject *PtpObjectDatabase::GetObjectById(u32 object_id) {
         /* Find in ID mapping. */
         if (auto it = m_object_id_tree.find_key(object_id); it != m_object_id_tree.end()) {
@@ -68,6 +68,12 @@ namespace haze {
         m_next_address       = nullptr;
         m_heap_block_size    = 0;
         m_current_heap_block = 0;
+
+        /* Free blocks pointed into the heap, so they go away with it. */
+        for (size_t i = 0; i < NumFreeLists; i++) {
+            m_free_lists[i] = nullptr;
+        }
+        m_free_size = 0;
         log_write("Heap finalized\n");
     }
 
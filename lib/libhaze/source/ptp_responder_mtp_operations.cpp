@@ -362,6 +362,9 @@ namespace haze {
         R_UNLESS(parentobj != nullptr, haze::ResultInvalidObjectId());
         log_write("Creating new object in parent %u (%s)\n", parent_object, parentobj->GetName());
 
+        /* Keep the parent and its children from being evicted while creating the object. */
+        m_object_database.MarkDirectoryEnumerated(parentobj->GetObjectId());
+
         PtpDataParser dp(m_buffers->usb_bulk_read_buffer, std::addressof(m_usb_server));
 
         /* Ensure we have a data header. */
@@ -499,6 +502,9 @@ namespace haze {
         const bool contains_slashes = std::strchr(m_buffers->filename_string_buffer, '/') != nullptr;
         R_UNLESS(!is_empty && !contains_slashes, haze::ResultInvalidPropertyValue());
 
+        /* Keep the object from being evicted while creating its renamed copy. */
+        m_object_database.MarkDirectoryEnumerated(obj->GetParentId());
+
         /* Add a new object in the database with the new name. */
         PtpObject *newobj;
         {
@@ -188,6 +188,9 @@ namespace haze {
         R_UNLESS(obj != nullptr, haze::ResultInvalidObjectId());
         log_write("Enumerating children of object %u (%s)\n", obj->GetObjectId(), obj->GetName());
 
+        /* Keep this directory's children registered, evicting those of directories the host has left. */
+        m_object_database.MarkDirectoryEnumerated(obj->GetObjectId());
+
         /* Try to read the object as a directory. */
         Dir dir;
         R_TRY(Fs(obj).OpenDirectory(obj->GetName(), std::addressof(dir)));
@@ -427,6 +430,9 @@ namespace haze {
         R_UNLESS(parentobj != nullptr, haze::ResultInvalidObjectId());
         log_write("Creating object %s in parent object %u (%s)\n", m_buffers->filename_string_buffer, parentobj->GetObjectId(), parentobj->GetName());
 
+        /* Keep the parent and its children from being evicted while creating the object. */
+        m_object_database.MarkDirectoryEnumerated(parentobj->GetObjectId());
+
         /* Make a new object with the intended name. */
         PtpNewObjectInfo new_object_info;
         new_object_info.storage_id       = parentobj->GetObjectId();
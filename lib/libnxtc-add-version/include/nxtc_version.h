@@ -33,10 +33,31 @@ typedef struct {
     void *icon_data;    ///< JPEG icon data.
 } NxTitleCacheApplicationMetadata;
 
+/// Read-only view of a title cache entry, filled by nxtcBorrowApplicationMetadataById().
+/// All pointers reference data owned by the internal title cache. They remain valid until the view is released with nxtcReleaseApplicationMetadataView(),
+/// even if the entry is replaced by nxtcAddEntry() or the title cache is freed in the meantime.
+typedef struct {
+    u64 title_id;           ///< Title ID from the application this data belongs to.
+    const char *name;       ///< NULL-terminated UTF-8 title name string in the system language.
+    const char *publisher;  ///< NULL-terminated UTF-8 title publisher string in the system language.
+    const char *version;    ///< NULL-terminated UTF-8 version string in the system language.
+    u32 version_info;       ///< Numeric version info.
+    size_t icon_size;       ///< JPEG icon size.
+    const void *icon_data;  ///< JPEG icon data. May be NULL in lazy load mode until nxtcLoadApplicationMetadataViewIcon() is called.
+    void *handle;           ///< Internal reference to the borrowed entry. Must not be modified.
+} NxTitleCacheApplicationMetadataView;
+
 /// Initializes the title cache interface by loading and parsing the title cache file from the SD card.
 /// Returns false if an error occurs.
 bool nxtcInitialize(void);
 
+/// Initializes the title cache interface in lazy load mode: only the title cache file header and entry table are read.
+/// Strings are read the first time an entry is looked up and icons are read by nxtcLoadApplicationMetadataViewIcon(), keeping the title cache file open in the meantime.
+/// Data blob checksums are verified once the icon for an entry is read. Entries with unreadable or corrupted data blobs are dropped from the internal title cache.
+/// Has no effect on the load mode if the interface has already been initialized.
+/// Returns false if an error occurs.
+bool nxtcInitializeLazy(void);
+
 /// Frees the internal title cache, flushes the title cache file and closes the title cache interface.
 void nxtcExit(void);
 
@@ -48,6 +69,23 @@ bool nxtcCheckIfEntryExists(u64 title_id);
 /// Returns NULL if the provided title ID doesn't exist within the internal title cache or if an error occurs.
 NxTitleCacheApplicationMetadata *nxtcGetApplicationMetadataEntryById(u64 title_id);
 
+/// Fills the provided NxTitleCacheApplicationMetadataView with read-only pointers into the internal title cache. No data is copied and no memory is allocated.
+/// Every successful call must be paired with a call to nxtcReleaseApplicationMetadataView().
+/// Returns false if the provided title ID doesn't exist within the internal title cache or if an error occurs.
+bool nxtcBorrowApplicationMetadataById(u64 title_id, NxTitleCacheApplicationMetadataView *out_view);
+
+/// Reads the icon for a view filled by nxtcBorrowApplicationMetadataById() if it hasn't been read yet (lazy load mode), then updates `icon_data`.
+/// Returns false if the icon can't be read or if its data blob is corrupted. The view must still be released in that case.
+bool nxtcLoadApplicationMetadataViewIcon(NxTitleCacheApplicationMetadataView *view);
+
+/// Frees the icon read for a view by nxtcLoadApplicationMetadataViewIcon() (lazy load mode), then clears `icon_data`. The next nxtcLoadApplicationMetadataViewIcon() call reads it again.
+/// Only icons stored in the open title cache file are freed, and only while the provided view is the entry's only outstanding view. Entries added since the last flush keep their icons.
+/// Returns false if the icon was kept.
+bool nxtcUnloadApplicationMetadataViewIcon(NxTitleCacheApplicationMetadataView *view);
+
+/// Releases a view filled by nxtcBorrowApplicationMetadataById() and clears it. Does nothing if the view holds no entry.
+void nxtcReleaseApplicationMetadataView(NxTitleCacheApplicationMetadataView *view);
+
 /// Updates the internal title cache to add a new entry with information from the provided arguments.
 /// A suitable NacpLanguageEntry is automatically selected depending on the configured system language and the available strings within the provided NacpStruct element.
 /// If empty strings are detected and unavoidable, language-specific placeholders will be used as fallback strings.
@@ -56,6 +94,14 @@ NxTitleCacheApplicationMetadata *nxtcGetApplicationMetadataEntryById(u64 title_i
 /// Returns false if an error occurs.
 bool nxtcAddEntry(u64 title_id, const NacpStruct *nacp, size_t icon_size, const void *icon_data, bool force_add, u32 version_info);
 
+/// Starts a batch of nxtcAddEntry() calls, e.g. while populating an empty title cache.
+/// New entries are appended without re-sorting the internal title cache, which is sorted once by nxtcCommitBatchAdd(). Lookups keep working during the batch.
+/// Batches may be nested: only the outermost nxtcCommitBatchAdd() sorts the title cache. Closing the interface with nxtcExit() ends any open batch.
+void nxtcBeginBatchAdd(void);
+
+/// Ends a batch started with nxtcBeginBatchAdd().
+void nxtcCommitBatchAdd(void);
+
 /// Populates the provided SetLanguage element with a value that represents the language being used by the cache (which should match the system language at all times).
 /// Returns false if an error occurs.
 bool nxtcGetCacheLanguage(SetLanguage *out_lang);
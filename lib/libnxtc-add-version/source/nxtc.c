@@ -14,6 +14,7 @@
 
 #define TITLE_CACHE_FILE_NAME   "nxtc_version.bin"
 #define TITLE_CACHE_PATH        DEVOPTAB_SDMC_DEVICE HBMENU_BASE_PATH TITLE_CACHE_FILE_NAME
+#define TITLE_CACHE_TMP_PATH    TITLE_CACHE_PATH ".tmp"
 
 #define NACP_MAX_ICON_SIZE      0x20000     /* 128 KiB. */
 
@@ -46,16 +47,40 @@ typedef struct {
 
 LIB_ASSERT(NxTitleCacheFileEntry, 0x28);  // 更新为实际大小：8+2+2+2+2+4+4+4+4+4+4=40字节=0x28
 
+/// Internal title cache entry.
+/// The public metadata must be the first member, so entries can be handled as NxTitleCacheApplicationMetadata pointers and freed with nxtcFreeApplicationMetadata().
+typedef struct {
+    NxTitleCacheApplicationMetadata metadata;
+    u32 borrow_count;                   ///< Number of outstanding views handed out by nxtcBorrowApplicationMetadataById().
+    bool retired;                       ///< Set if the entry was removed from the title cache while borrowed. It is freed once the last view is released.
+    bool strings_pending;               ///< Lazy load mode: name, publisher and version strings haven't been read from the title cache file yet.
+    bool icon_pending;                  ///< Lazy load mode: icon hasn't been read from the title cache file yet.
+    u32 strings_crc;                    ///< Lazy load mode: CRC32 of the string area, used as the seed to verify the whole data blob once the icon is read.
+    bool blob_in_file;                  ///< Lazy load mode: `file_entry` describes this entry's data blob in the open title cache file, so its icon can be unloaded and read again.
+    NxTitleCacheFileEntry file_entry;   ///< Lazy load mode: title cache file entry that describes the data blob for this entry.
+} NxTitleCacheEntry;
+
 /* Function prototypes. */
 
 static void nxtcGetSystemLanguage(void);
 static const char *nxtcGetPlaceholderString(void);
 
-static void nxtcLoadFile(void);
+static bool nxtcInitializeInternal(bool lazy);
+
+static void nxtcLoadFile(bool lazy);
 
 static NxTitleCacheFileHeader *nxtcLoadFileHeader(u8 *cache_file_data, size_t cache_file_size, size_t *out_cur_offset);
 static NxTitleCacheFileEntry *nxtcLoadFileEntries(u8 *cache_file_data, size_t cache_file_size, const NxTitleCacheFileHeader *cache_file_header, size_t *out_cur_offset);
 static bool nxtcDeserializeDataBlobs(u8 *cache_file_data, const NxTitleCacheFileHeader *cache_file_header, const NxTitleCacheFileEntry *cache_file_entries, size_t *out_cur_offset);
+static bool nxtcGenerateLazyCacheEntries(const NxTitleCacheFileHeader *cache_file_header, const NxTitleCacheFileEntry *cache_file_entries);
+
+static bool nxtcReadCacheFileBlobData(const NxTitleCacheEntry *cache_entry, u32 offset, void *out, size_t size);
+static bool nxtcLoadCacheEntryStrings(NxTitleCacheEntry *cache_entry);
+static bool nxtcLoadCacheEntryIcon(NxTitleCacheEntry *cache_entry);
+static NxTitleCacheEntry *nxtcGetLoadedCacheEntry(u64 title_id, bool load_icon);
+static void nxtcRemoveCacheEntry(u32 idx);
+static void nxtcCloseCacheFile(void);
+static void nxtcRecoverTempFile(void);
 
 static void nxtcSaveFile(void);
 
@@ -69,7 +94,10 @@ static bool nxtcUpdateCacheEntryWithUserData(NxTitleCacheApplicationMetadata *ca
 static void nxtcFillCacheEntryWithUserData(NxTitleCacheApplicationMetadata *cache_entry, const NacpLanguageEntry *lang_entry, const NacpStruct *nacp, size_t icon_size, const void *icon_data, u32 version_info);
 
 static bool nxtcReallocateTitleCache(u32 extra_entry_count, bool free_entries);
+static bool nxtcReserveTitleCache(u32 entry_count);
+static void nxtcSortPendingCacheEntries(void);
 static void nxtcFreeTitleCache(bool flush);
+static void nxtcDiscardCacheEntry(NxTitleCacheApplicationMetadata **cache_entry);
 
 static bool nxtcAppendDataBlobToFileCacheBuffer(u8 **cache_file_data, const NxTitleCacheApplicationMetadata *cache_entry, NxTitleCacheFileEntry *cache_file_entry, u32 *out_blob_offset, size_t *out_cur_offset);
 
@@ -78,6 +106,7 @@ static const NacpLanguageEntry *nxtcGetNacpLanguageEntry(const NacpStruct *nacp)
 NX_INLINE u32 nxtcCalculateDataBlobSize(u16 name_len, u16 publisher_len, u16 version_len, u32 icon_size);
 
 static NxTitleCacheApplicationMetadata *_nxtcGetApplicationMetadataEntryById(u64 title_id);
+static bool nxtcGetCacheEntryIndex(u64 title_id, u32 *out_index);
 
 static int nxtcEntrySortFunction(const void *a, const void *b);
 
@@ -92,9 +121,16 @@ static const char *g_curPlaceholderString = NULL;
 
 static NxTitleCacheApplicationMetadata **g_titleCache = NULL;
 static u32 g_titleCacheCount = 0;
+static u32 g_titleCacheCapacity = 0;        ///< Number of allocated title cache entry pointers.
+static u32 g_titleCacheSortedCount = 0;     ///< Entries past this index were appended by nxtcAddEntry() and haven't been sorted yet.
+static u32 g_titleCacheBatchRefCount = 0;   ///< Nesting level of nxtcBeginBatchAdd() calls.
 
 static bool g_cacheFlushRequired = false;
 
+static bool g_lazyLoad = false;                 ///< Set if the interface was initialized with nxtcInitializeLazy().
+static FILE *g_cacheFile = NULL;                ///< Title cache file, kept open in lazy load mode to read data blobs on demand.
+static size_t g_cacheFileBlobAreaOffset = 0;    ///< Offset to the data blob area within the title cache file.
+
 /// Provides language-specific placeholders used when a title name/publisher isn't available.
 static const char *g_placeholderStrings[SetLanguage_Total] = {
     [SetLanguage_JA]     = "[未知]",            ///< "Michi".
@@ -140,6 +176,16 @@ static const u8 g_nacpLangTable[SetLanguage_Total] = {
 };
 
 bool nxtcInitialize(void)
+{
+    return nxtcInitializeInternal(false);
+}
+
+bool nxtcInitializeLazy(void)
+{
+    return nxtcInitializeInternal(true);
+}
+
+static bool nxtcInitializeInternal(bool lazy)
 {
     bool ret = false;
 
@@ -158,7 +204,8 @@ bool nxtcInitialize(void)
             g_curPlaceholderString = nxtcGetPlaceholderString();
 
             /* Load title cache file. */
-            nxtcLoadFile();
+            g_lazyLoad = lazy;
+            nxtcLoadFile(lazy);
         }
 
         /* Update flags. */
@@ -180,8 +227,10 @@ void nxtcExit(void)
         g_nxtcRefCount--;
         if (g_nxtcRefCount) break;
 
-        /* Write title cache file and free our title cache. */
+        /* Write title cache file and free our title cache. This also ends any open batch. */
         nxtcFreeTitleCache(true);
+        g_titleCacheBatchRefCount = 0;
+        g_lazyLoad = false;
 
         /* Restore language variables. */
         g_systemLanguage = g_defaultSystemLanguage;
@@ -211,8 +260,8 @@ NxTitleCacheApplicationMetadata *nxtcGetApplicationMetadataEntryById(u64 title_i
 
     SCOPED_LOCK(&g_nxtcMutex)
     {
-        /* Retrieve title cache entry. */
-        NxTitleCacheApplicationMetadata *cache_entry = _nxtcGetApplicationMetadataEntryById(title_id);
+        /* Retrieve title cache entry. Its whole data blob is needed here. */
+        NxTitleCacheApplicationMetadata *cache_entry = (NxTitleCacheApplicationMetadata*)nxtcGetLoadedCacheEntry(title_id, true);
         if (!cache_entry)
         {
             NXTC_LOG_MSG("Title cache entry with ID %016lX is unavailable!", title_id);
@@ -248,6 +297,125 @@ NxTitleCacheApplicationMetadata *nxtcGetApplicationMetadataEntryById(u64 title_i
     return out;
 }
 
+bool nxtcBorrowApplicationMetadataById(u64 title_id, NxTitleCacheApplicationMetadataView *out_view)
+{
+    bool ret = false;
+
+    SCOPED_LOCK(&g_nxtcMutex)
+    {
+        if (!out_view)
+        {
+            NXTC_LOG_MSG("Invalid parameters!");
+            break;
+        }
+
+        /* Retrieve title cache entry. The icon is left for nxtcLoadApplicationMetadataViewIcon() if it hasn't been read yet. */
+        NxTitleCacheEntry *cache_entry = nxtcGetLoadedCacheEntry(title_id, false);
+        if (!cache_entry)
+        {
+            NXTC_LOG_MSG("Title cache entry with ID %016lX is unavailable!", title_id);
+            break;
+        }
+
+        /* Populate output view. The entry can't be freed while it's borrowed. */
+        out_view->title_id = cache_entry->metadata.title_id;
+        out_view->name = cache_entry->metadata.name;
+        out_view->publisher = cache_entry->metadata.publisher;
+        out_view->version = cache_entry->metadata.version;
+        out_view->version_info = cache_entry->metadata.version_info;
+        out_view->icon_size = cache_entry->metadata.icon_size;
+        out_view->icon_data = cache_entry->metadata.icon_data;
+        out_view->handle = cache_entry;
+
+        cache_entry->borrow_count++;
+        ret = true;
+    }
+
+    return ret;
+}
+
+bool nxtcLoadApplicationMetadataViewIcon(NxTitleCacheApplicationMetadataView *view)
+{
+    bool ret = false;
+
+    SCOPED_LOCK(&g_nxtcMutex)
+    {
+        if (!view || !view->handle)
+        {
+            NXTC_LOG_MSG("Invalid parameters!");
+            break;
+        }
+
+        NxTitleCacheEntry *cache_entry = (NxTitleCacheEntry*)view->handle;
+
+        if (!nxtcLoadCacheEntryIcon(cache_entry))
+        {
+            /* Drop the entry from the title cache, so it gets regenerated the next time it's added. */
+            u32 idx = 0;
+            if (!cache_entry->retired && nxtcGetCacheEntryIndex(cache_entry->metadata.title_id, &idx) && g_titleCache[idx] == &(cache_entry->metadata)) nxtcRemoveCacheEntry(idx);
+            break;
+        }
+
+        /* Update output view. */
+        view->icon_size = cache_entry->metadata.icon_size;
+        view->icon_data = cache_entry->metadata.icon_data;
+
+        ret = true;
+    }
+
+    return ret;
+}
+
+bool nxtcUnloadApplicationMetadataViewIcon(NxTitleCacheApplicationMetadataView *view)
+{
+    bool ret = false;
+
+    SCOPED_LOCK(&g_nxtcMutex)
+    {
+        if (!view || !view->handle)
+        {
+            NXTC_LOG_MSG("Invalid parameters!");
+            break;
+        }
+
+        NxTitleCacheEntry *cache_entry = (NxTitleCacheEntry*)view->handle;
+
+        /* Only free icons that can be read again from the title cache file, and only if no other view may be referencing them. */
+        if (!g_cacheFile || cache_entry->retired || !cache_entry->blob_in_file || cache_entry->icon_pending || cache_entry->borrow_count != 1) break;
+
+        free(cache_entry->metadata.icon_data);
+        cache_entry->metadata.icon_data = NULL;
+        cache_entry->icon_pending = true;
+
+        /* Update output view. */
+        view->icon_data = NULL;
+
+        ret = true;
+    }
+
+    return ret;
+}
+
+void nxtcReleaseApplicationMetadataView(NxTitleCacheApplicationMetadataView *view)
+{
+    if (!view || !view->handle) return;
+
+    SCOPED_LOCK(&g_nxtcMutex)
+    {
+        NxTitleCacheEntry *cache_entry = (NxTitleCacheEntry*)view->handle;
+
+        /* Free the entry if it was removed from the title cache while borrowed and this was its last view. */
+        if (cache_entry->borrow_count) cache_entry->borrow_count--;
+        if (!cache_entry->borrow_count && cache_entry->retired)
+        {
+            NxTitleCacheApplicationMetadata *metadata = &(cache_entry->metadata);
+            nxtcFreeApplicationMetadata(&metadata);
+        }
+    }
+
+    memset(view, 0, sizeof(NxTitleCacheApplicationMetadataView));
+}
+
 bool nxtcAddEntry(u64 title_id, const NacpStruct *nacp, size_t icon_size, const void *icon_data, bool force_add, u32 version_info)
 {
     bool ret = false;
@@ -277,25 +445,37 @@ bool nxtcAddEntry(u64 title_id, const NacpStruct *nacp, size_t icon_size, const
                 break;
             }
 
-            /* Update cache entry with the provided data. */
-            if (!nxtcUpdateCacheEntryWithUserData(cache_entry, lang_entry, nacp, icon_size, icon_data, version_info)) break;
+            if (((NxTitleCacheEntry*)cache_entry)->borrow_count)
+            {
+                /* Borrowed views still point at the current data, so replace the whole entry instead of updating it in place. */
+                NxTitleCacheApplicationMetadata *new_cache_entry = nxtcGenerateCacheEntryFromUserData(title_id, lang_entry, nacp, icon_size, icon_data, version_info);
+                if (!new_cache_entry) break;
+
+                u32 idx = 0;
+                nxtcGetCacheEntryIndex(title_id, &idx);
+                nxtcDiscardCacheEntry(&(g_titleCache[idx]));
+                g_titleCache[idx] = new_cache_entry;
+            } else {
+                /* Update cache entry with the provided data. */
+                if (!nxtcUpdateCacheEntryWithUserData(cache_entry, lang_entry, nacp, icon_size, icon_data, version_info)) break;
+            }
         } else {
             /* Generate title cache entry. */
             cache_entry = nxtcGenerateCacheEntryFromUserData(title_id, lang_entry, nacp, icon_size, icon_data, version_info);
             if (!cache_entry) break;
 
-            /* Reallocate title cache entry pointer array. */
-            if (!nxtcReallocateTitleCache(1, false))
+            /* Make room for the new title cache entry pointer. */
+            if (!nxtcReserveTitleCache(g_titleCacheCount + 1))
             {
                 nxtcFreeApplicationMetadata(&cache_entry);
                 break;
             }
 
-            /* Set title cache entry pointer. */
+            /* Append title cache entry pointer. */
             g_titleCache[g_titleCacheCount++] = cache_entry;
 
-            /* Sort title cache entries by title ID. */
-            if (g_titleCacheCount > 1) qsort(g_titleCache, g_titleCacheCount, sizeof(NxTitleCacheApplicationMetadata*), &nxtcEntrySortFunction);
+            /* Merge it into the sorted title cache entries, unless a batch is in progress. */
+            if (!g_titleCacheBatchRefCount) nxtcSortPendingCacheEntries();
         }
 
         /* Update flags. */
@@ -305,6 +485,24 @@ bool nxtcAddEntry(u64 title_id, const NacpStruct *nacp, size_t icon_size, const
     return ret;
 }
 
+void nxtcBeginBatchAdd(void)
+{
+    SCOPED_LOCK(&g_nxtcMutex) g_titleCacheBatchRefCount++;
+}
+
+void nxtcCommitBatchAdd(void)
+{
+    SCOPED_LOCK(&g_nxtcMutex)
+    {
+        /* Check if there's an open batch. It may have already been ended by nxtcExit(). */
+        if (!g_titleCacheBatchRefCount) break;
+
+        /* Sort the appended title cache entries once the outermost batch ends. */
+        g_titleCacheBatchRefCount--;
+        if (!g_titleCacheBatchRefCount) nxtcSortPendingCacheEntries();
+    }
+}
+
 bool nxtcGetCacheLanguage(SetLanguage *out_lang)
 {
     bool ret = false;
@@ -341,6 +539,7 @@ void nxtcWipeCache(void)
 
         /* Delete title cache file. */
         remove(TITLE_CACHE_PATH);
+        remove(TITLE_CACHE_TMP_PATH);
         nxtcUtilsCommitSdCardFileSystemChanges();
 
         /* Update flag. */
@@ -384,7 +583,7 @@ static const char *nxtcGetPlaceholderString(void)
     return (g_systemLanguage < SetLanguage_Total ? g_placeholderStrings[g_systemLanguage] : g_placeholderStrings[SetLanguage_ENUS]);
 }
 
-static void nxtcLoadFile(void)
+static void nxtcLoadFile(bool lazy)
 {
     FILE *cache_file = NULL;
     size_t cache_file_size = 0;
@@ -393,10 +592,13 @@ static void nxtcLoadFile(void)
     NxTitleCacheFileHeader *cache_file_header = NULL;
     NxTitleCacheFileEntry *cache_file_entries = NULL;
 
-    size_t cur_offset = 0;
+    size_t cur_offset = 0, read_size = 0;
 
     bool success = false;
 
+    /* Recover from a title cache file swap that was interrupted after the old file was removed. */
+    nxtcRecoverTempFile();
+
     /* Open title cache file. */
     cache_file = fopen(TITLE_CACHE_PATH, "rb");
     if (!cache_file)
@@ -416,18 +618,42 @@ static void nxtcLoadFile(void)
         goto end;
     }
 
-    /* Allocate memory for the whole cache file. */
-    cache_file_data = malloc(cache_file_size);
+    /* Read the whole title cache file, unless we're in lazy load mode. */
+    /* In that case, only the header and the entry table are read. Data blobs are read on demand. */
+    read_size = cache_file_size;
+
+    if (lazy)
+    {
+        NxTitleCacheFileHeader tmp_cache_file_header = {0};
+
+        if (cache_file_size < sizeof(NxTitleCacheFileHeader) || fread(&tmp_cache_file_header, 1, sizeof(NxTitleCacheFileHeader), cache_file) != sizeof(NxTitleCacheFileHeader))
+        {
+            NXTC_LOG_MSG("Failed to read title cache file header! (%d).", errno);
+            goto end;
+        }
+
+        read_size = (sizeof(NxTitleCacheFileHeader) + ((size_t)tmp_cache_file_header.entry_count * sizeof(NxTitleCacheFileEntry)));
+        if (read_size > cache_file_size)
+        {
+            NXTC_LOG_MSG("Title cache file size is too small to hold all entries! (0x%lX < 0x%lX).", cache_file_size, read_size);
+            goto end;
+        }
+
+        rewind(cache_file);
+    }
+
+    /* Allocate memory for the title cache file data. */
+    cache_file_data = malloc(read_size);
     if (!cache_file_data)
     {
-        NXTC_LOG_MSG("Failed to allocate 0x%lX byte-long block for the title cache file!", cache_file_size);
+        NXTC_LOG_MSG("Failed to allocate 0x%lX byte-long block for the title cache file!", read_size);
         goto end;
     }
 
-    /* Read whole title cache file. */
-    if (fread(cache_file_data, 1, cache_file_size, cache_file) != cache_file_size)
+    /* Read title cache file data. */
+    if (fread(cache_file_data, 1, read_size, cache_file) != read_size)
     {
-        NXTC_LOG_MSG("Failed to read 0x%lX byte-long title cache file! (%d).", cache_file_size, errno);
+        NXTC_LOG_MSG("Failed to read 0x%lX bytes from the title cache file! (%d).", read_size, errno);
         goto end;
     }
 
@@ -437,15 +663,28 @@ static void nxtcLoadFile(void)
     /* Read title cache file entries. */
     if (!(cache_file_entries = nxtcLoadFileEntries(cache_file_data, cache_file_size, cache_file_header, &cur_offset))) goto end;
 
-    /* Deserialize data blobs. */
-    success = nxtcDeserializeDataBlobs(cache_file_data, cache_file_header, cache_file_entries, &cur_offset);
+    if (lazy)
+    {
+        /* Generate title cache entries from the entry table alone. */
+        success = nxtcGenerateLazyCacheEntries(cache_file_header, cache_file_entries);
+    } else {
+        /* Deserialize data blobs. */
+        success = nxtcDeserializeDataBlobs(cache_file_data, cache_file_header, cache_file_entries, &cur_offset);
+    }
 
 end:
     if (cache_file_data) free(cache_file_data);
 
     if (cache_file)
     {
-        fclose(cache_file);
+        if (success && lazy)
+        {
+            /* Keep the title cache file open to read data blobs on demand. */
+            g_cacheFile = cache_file;
+            g_cacheFileBlobAreaOffset = cur_offset;
+        } else {
+            fclose(cache_file);
+        }
 
         if (!success)
         {
@@ -606,6 +845,7 @@ static bool nxtcDeserializeDataBlobs(u8 *cache_file_data, const NxTitleCacheFile
 
     /* Sort title cache entries by title ID. */
     if (g_titleCacheCount > 1) qsort(g_titleCache, g_titleCacheCount, sizeof(NxTitleCacheApplicationMetadata*), &nxtcEntrySortFunction);
+    g_titleCacheSortedCount = g_titleCacheCount;
 
     /* Update flag. */
     success = true;
@@ -617,6 +857,236 @@ end:
     return success;
 }
 
+static bool nxtcGenerateLazyCacheEntries(const NxTitleCacheFileHeader *cache_file_header, const NxTitleCacheFileEntry *cache_file_entries)
+{
+    if (!cache_file_header || !cache_file_entries)
+    {
+        NXTC_LOG_MSG("Invalid parameters!");
+        return false;
+    }
+
+    u32 entry_count = cache_file_header->entry_count, extra_entry_count = 0;
+    bool success = false;
+
+    /* Reallocate title cache entry pointer array. */
+    if (!nxtcReallocateTitleCache(entry_count, false)) return false;
+
+    /* Fill new title cache entries. Only the fields available in the entry table are set. */
+    for(u32 i = 0; i < entry_count; i++)
+    {
+        const NxTitleCacheFileEntry *cur_cache_file_entry = &(cache_file_entries[i]);
+
+        NxTitleCacheEntry *cache_entry = calloc(1, sizeof(NxTitleCacheEntry));
+        if (!cache_entry)
+        {
+            NXTC_LOG_MSG("Failed to allocate memory for title cache entry %016lX!", cur_cache_file_entry->title_id);
+            goto end;
+        }
+
+        cache_entry->metadata.title_id = cur_cache_file_entry->title_id;
+        cache_entry->metadata.version_info = cur_cache_file_entry->version_info;
+        cache_entry->metadata.icon_size = cur_cache_file_entry->icon_size;
+        cache_entry->strings_pending = cache_entry->icon_pending = cache_entry->blob_in_file = true;
+        memcpy(&(cache_entry->file_entry), cur_cache_file_entry, sizeof(NxTitleCacheFileEntry));
+
+        /* Set title cache entry pointer. */
+        g_titleCache[g_titleCacheCount + extra_entry_count] = &(cache_entry->metadata);
+
+        /* Increase extra title cache entry counter. */
+        extra_entry_count++;
+    }
+
+    /* Update title cache entry count. */
+    g_titleCacheCount += extra_entry_count;
+
+    /* Sort title cache entries by title ID. */
+    if (g_titleCacheCount > 1) qsort(g_titleCache, g_titleCacheCount, sizeof(NxTitleCacheApplicationMetadata*), &nxtcEntrySortFunction);
+    g_titleCacheSortedCount = g_titleCacheCount;
+
+    /* Update flag. */
+    success = true;
+
+end:
+    /* Free previously allocated title cache entry pointers. Ignore return value. */
+    if (!success) nxtcReallocateTitleCache(extra_entry_count, true);
+
+    return success;
+}
+
+static bool nxtcReadCacheFileBlobData(const NxTitleCacheEntry *cache_entry, u32 offset, void *out, size_t size)
+{
+    /* Retired entries may point to data blobs that no longer exist in the title cache file. */
+    if (!g_cacheFile || cache_entry->retired)
+    {
+        NXTC_LOG_MSG("Data blob for %016lX is unavailable!", cache_entry->metadata.title_id);
+        return false;
+    }
+
+    size_t file_offset = (g_cacheFileBlobAreaOffset + cache_entry->file_entry.blob_offset + offset);
+
+    if (fseek(g_cacheFile, (long)file_offset, SEEK_SET) != 0 || fread(out, 1, size, g_cacheFile) != size)
+    {
+        NXTC_LOG_MSG("Failed to read 0x%lX bytes at offset 0x%lX from the title cache file! (title %016lX) (%d).", size, file_offset, cache_entry->metadata.title_id, errno);
+        return false;
+    }
+
+    return true;
+}
+
+static bool nxtcLoadCacheEntryStrings(NxTitleCacheEntry *cache_entry)
+{
+    if (!cache_entry->strings_pending) return true;
+
+    const NxTitleCacheFileEntry *cache_file_entry = &(cache_entry->file_entry);
+    u32 strings_size = (cache_file_entry->blob_size - cache_file_entry->icon_size);
+    size_t data_offset = 0;
+    char *strings = NULL;
+    bool success = false;
+
+    /* Read the string area from the data blob. */
+    strings = malloc(strings_size);
+    if (!strings)
+    {
+        NXTC_LOG_MSG("Failed to allocate 0x%X byte-long string buffer! (title %016lX).", strings_size, cache_file_entry->title_id);
+        goto end;
+    }
+
+    if (!nxtcReadCacheFileBlobData(cache_entry, 0, strings, strings_size)) goto end;
+
+    /* The blob checksum is verified once the icon is read. */
+    cache_entry->strings_crc = crc32Calculate(strings, strings_size);
+
+    /* Populate title cache entry strings. */
+    cache_entry->metadata.name = strndup(strings + data_offset, cache_file_entry->name_len);
+    data_offset += ALIGN_UP(cache_file_entry->name_len, TITLE_CACHE_ALIGNMENT);
+
+    cache_entry->metadata.publisher = strndup(strings + data_offset, cache_file_entry->publisher_len);
+    data_offset += ALIGN_UP(cache_file_entry->publisher_len, TITLE_CACHE_ALIGNMENT);
+
+    cache_entry->metadata.version = strndup(strings + data_offset, cache_file_entry->version_len);
+
+    if (!cache_entry->metadata.name || !cache_entry->metadata.publisher || !cache_entry->metadata.version)
+    {
+        NXTC_LOG_MSG("Failed to populate title cache entry strings! (title %016lX).", cache_file_entry->title_id);
+
+        free(cache_entry->metadata.name);
+        free(cache_entry->metadata.publisher);
+        free(cache_entry->metadata.version);
+        cache_entry->metadata.name = cache_entry->metadata.publisher = cache_entry->metadata.version = NULL;
+
+        goto end;
+    }
+
+    /* Update flags. */
+    cache_entry->strings_pending = false;
+    success = true;
+
+end:
+    if (strings) free(strings);
+
+    return success;
+}
+
+static bool nxtcLoadCacheEntryIcon(NxTitleCacheEntry *cache_entry)
+{
+    if (!cache_entry->icon_pending) return true;
+
+    /* The string area CRC32 is needed to verify the whole data blob. */
+    if (!nxtcLoadCacheEntryStrings(cache_entry)) return false;
+
+    const NxTitleCacheFileEntry *cache_file_entry = &(cache_entry->file_entry);
+    u32 icon_offset = (cache_file_entry->blob_size - cache_file_entry->icon_size), data_blob_crc = 0;
+    void *icon_data = NULL;
+
+    /* Read the icon from the data blob. */
+    icon_data = malloc(cache_file_entry->icon_size);
+    if (!icon_data)
+    {
+        NXTC_LOG_MSG("Failed to allocate 0x%X byte-long icon buffer! (title %016lX).", cache_file_entry->icon_size, cache_file_entry->title_id);
+        return false;
+    }
+
+    if (!nxtcReadCacheFileBlobData(cache_entry, icon_offset, icon_data, cache_file_entry->icon_size))
+    {
+        free(icon_data);
+        return false;
+    }
+
+    /* Verify blob checksum. */
+    data_blob_crc = crc32CalculateWithSeed(cache_entry->strings_crc, icon_data, cache_file_entry->icon_size);
+    if (data_blob_crc != cache_file_entry->blob_crc)
+    {
+        NXTC_LOG_MSG("Data blob checksum mismatch! (title %016lX) (%08X != %08X).", cache_file_entry->title_id, data_blob_crc, cache_file_entry->blob_crc);
+        free(icon_data);
+        return false;
+    }
+
+    /* Update title cache entry. */
+    cache_entry->metadata.icon_data = icon_data;
+    cache_entry->icon_pending = false;
+
+    return true;
+}
+
+static NxTitleCacheEntry *nxtcGetLoadedCacheEntry(u64 title_id, bool load_icon)
+{
+    u32 idx = 0;
+
+    if (!g_nxtcRefCount || !g_titleCache || !g_titleCacheCount || !title_id || !nxtcGetCacheEntryIndex(title_id, &idx)) return NULL;
+
+    NxTitleCacheEntry *cache_entry = (NxTitleCacheEntry*)g_titleCache[idx];
+
+    /* Read pending data from the title cache file. This is a no-op for fully loaded entries. */
+    if (!nxtcLoadCacheEntryStrings(cache_entry) || (load_icon && !nxtcLoadCacheEntryIcon(cache_entry)))
+    {
+        /* Drop the entry from the title cache, so it gets regenerated the next time it's added. */
+        nxtcRemoveCacheEntry(idx);
+        return NULL;
+    }
+
+    return cache_entry;
+}
+
+static void nxtcRemoveCacheEntry(u32 idx)
+{
+    nxtcDiscardCacheEntry(&(g_titleCache[idx]));
+
+    memmove(g_titleCache + idx, g_titleCache + idx + 1, (size_t)(g_titleCacheCount - idx - 1) * sizeof(NxTitleCacheApplicationMetadata*));
+    g_titleCache[--g_titleCacheCount] = NULL;
+    if (idx < g_titleCacheSortedCount) g_titleCacheSortedCount--;
+
+    /* The title cache file must be rewritten without this entry. */
+    g_cacheFlushRequired = true;
+}
+
+static void nxtcCloseCacheFile(void)
+{
+    if (!g_cacheFile) return;
+
+    fclose(g_cacheFile);
+    g_cacheFile = NULL;
+    g_cacheFileBlobAreaOffset = 0;
+}
+
+static void nxtcRecoverTempFile(void)
+{
+    struct stat st = {0};
+
+    if (stat(TITLE_CACHE_TMP_PATH, &st) != 0) return;
+
+    if (stat(TITLE_CACHE_PATH, &st) == 0)
+    {
+        /* The swap never started, so the temporary file may be incomplete. */
+        remove(TITLE_CACHE_TMP_PATH);
+    } else {
+        /* The old file is only removed once the temporary file has been fully written, so it holds the latest title cache. */
+        NXTC_LOG_MSG("Restoring title cache file from \"" TITLE_CACHE_TMP_PATH "\".");
+        rename(TITLE_CACHE_TMP_PATH, TITLE_CACHE_PATH);
+    }
+
+    nxtcUtilsCommitSdCardFileSystemChanges();
+}
+
 static void nxtcSaveFile(void)
 {
     u8 *cache_file_data = NULL;
@@ -627,8 +1097,9 @@ static void nxtcSaveFile(void)
     NxTitleCacheFileEntry *cache_file_entries = NULL;
 
     FILE *cache_file = NULL;
+    const char *new_cache_path = TITLE_CACHE_PATH;
 
-    bool success = false;
+    bool success = false, written = false;
 
     if (!g_nxtcRefCount || !g_titleCache || !g_titleCacheCount)
     {
@@ -666,21 +1137,53 @@ static void nxtcSaveFile(void)
         goto end;
     }
 
-    /* Open title cache file. */
-    cache_file = fopen(TITLE_CACHE_PATH, "wb");
+    /* Write the new title cache to a temporary file first. The old file, and the handle kept open to it in lazy load mode, stay untouched until it has been fully written. */
+    cache_file = fopen(TITLE_CACHE_TMP_PATH, "wb");
     if (!cache_file)
     {
-        NXTC_LOG_MSG("Unable to open title cache at \"" TITLE_CACHE_PATH "\" for writing!");
+        NXTC_LOG_MSG("Unable to open title cache at \"" TITLE_CACHE_TMP_PATH "\" for writing!");
         goto end;
     }
 
     /* Write full title cache file. */
-    if (fwrite(cache_file_data, 1, full_cache_size, cache_file) != full_cache_size)
+    written = (fwrite(cache_file_data, 1, full_cache_size, cache_file) == full_cache_size && fflush(cache_file) == 0);
+    if (fclose(cache_file) != 0) written = false;
+    cache_file = NULL;
+
+    if (!written)
     {
         NXTC_LOG_MSG("Failed to write 0x%lX byte-long title cache file! (%d).", full_cache_size, errno);
+        remove(TITLE_CACHE_TMP_PATH);
+        nxtcUtilsCommitSdCardFileSystemChanges();
         goto end;
     }
 
+    /* Close the title cache file kept open in lazy load mode. Pending data blobs have already been copied into our buffer. */
+    nxtcCloseCacheFile();
+
+    /* Swap the files. Renaming can't overwrite an existing file on FAT, so the old one is removed first. */
+    /* If the rename still fails, the temporary file is the only copy: keep it and read from it until nxtcRecoverTempFile() restores it on the next load. */
+    remove(TITLE_CACHE_PATH);
+    if (rename(TITLE_CACHE_TMP_PATH, TITLE_CACHE_PATH) != 0)
+    {
+        NXTC_LOG_MSG("Failed to rename \"" TITLE_CACHE_TMP_PATH "\" to \"" TITLE_CACHE_PATH "\"! (%d).", errno);
+        new_cache_path = TITLE_CACHE_TMP_PATH;
+    }
+
+    nxtcUtilsCommitSdCardFileSystemChanges();
+
+    /* Point title cache entries to their new data blobs. Their string area checksums are updated as well, so unloaded icons can be verified when they're read again. */
+    for(u32 i = 0; i < g_titleCacheCount; i++)
+    {
+        NxTitleCacheEntry *cache_entry = (NxTitleCacheEntry*)g_titleCache[i];
+        const NxTitleCacheFileEntry *cache_file_entry = &(cache_file_entries[i]);
+        const u8 *blob = (cache_file_data + sizeof(NxTitleCacheFileHeader) + ((size_t)g_titleCacheCount * sizeof(NxTitleCacheFileEntry)) + cache_file_entry->blob_offset);
+
+        memcpy(&(cache_entry->file_entry), cache_file_entry, sizeof(NxTitleCacheFileEntry));
+        cache_entry->strings_crc = crc32Calculate(blob, cache_file_entry->blob_size - cache_file_entry->icon_size);
+        cache_entry->blob_in_file = true;
+    }
+
     /* Update flags. */
     g_cacheFlushRequired = false;
     success = true;
@@ -688,11 +1191,11 @@ static void nxtcSaveFile(void)
 end:
     if (cache_file_data) free(cache_file_data);
 
-    if (cache_file)
+    /* Reopen the new title cache file to keep reading pending data blobs. */
+    if (success && g_lazyLoad)
     {
-        fclose(cache_file);
-        if (!success) remove(TITLE_CACHE_PATH);
-        nxtcUtilsCommitSdCardFileSystemChanges();
+        g_cacheFile = fopen(new_cache_path, "rb");
+        if (g_cacheFile) g_cacheFileBlobAreaOffset = (sizeof(NxTitleCacheFileHeader) + ((size_t)g_titleCacheCount * sizeof(NxTitleCacheFileEntry)));
     }
 }
 
@@ -782,7 +1285,7 @@ static NxTitleCacheApplicationMetadata *nxtcGenerateCacheEntryFromFileEntry(u8 *
     }
 
     /* Allocate memory for the output title cache entry. */
-    out = malloc(sizeof(NxTitleCacheApplicationMetadata));
+    out = calloc(1, sizeof(NxTitleCacheEntry));
     if (!out)
     {
         NXTC_LOG_MSG("Failed to allocate memory for the output title cache entry! (title %016lX).", cache_file_entry->title_id);
@@ -834,7 +1337,7 @@ static NxTitleCacheApplicationMetadata *nxtcGenerateCacheEntryFromUserData(u64 t
     bool success = false;
 
     /* Allocate memory for the output title cache entry. */
-    out = malloc(sizeof(NxTitleCacheApplicationMetadata));
+    out = calloc(1, sizeof(NxTitleCacheEntry));
     if (!out)
     {
         NXTC_LOG_MSG("Failed to allocate memory for the output title cache entry! (title %016lX).", title_id);
@@ -892,6 +1395,9 @@ static bool nxtcUpdateCacheEntryWithUserData(NxTitleCacheApplicationMetadata *ca
     free(bkp_cache_entry.version);
     free(bkp_cache_entry.icon_data);
 
+    /* Nothing is left to read from the title cache file for this entry. */
+    ((NxTitleCacheEntry*)cache_entry)->strings_pending = ((NxTitleCacheEntry*)cache_entry)->icon_pending = false;
+
     return true;
 }
 
@@ -955,7 +1461,7 @@ static bool nxtcReallocateTitleCache(u32 extra_entry_count, bool free_entries)
         }
 
         /* Free previously allocated title cache entries. */
-        for(u32 i = 0; i <= extra_entry_count; i++) nxtcFreeApplicationMetadata(&(g_titleCache[g_titleCacheCount + i]));
+        for(u32 i = 0; i <= extra_entry_count; i++) nxtcDiscardCacheEntry(&(g_titleCache[g_titleCacheCount + i]));
     }
 
     if (realloc_entry_count)
@@ -966,6 +1472,7 @@ static bool nxtcReallocateTitleCache(u32 extra_entry_count, bool free_entries)
         {
             /* Update title cache entry pointer. */
             g_titleCache = tmp_title_cache;
+            g_titleCacheCapacity = realloc_entry_count;
             tmp_title_cache = NULL;
 
             /* Clear new title cache entry pointer array area (if needed). */
@@ -980,6 +1487,7 @@ static bool nxtcReallocateTitleCache(u32 extra_entry_count, bool free_entries)
         /* Free title cache entry pointer array. */
         free(g_titleCache);
         g_titleCache = NULL;
+        g_titleCacheCapacity = 0;
     }
 
     /* Update flag. */
@@ -989,6 +1497,68 @@ end:
     return success;
 }
 
+static bool nxtcReserveTitleCache(u32 entry_count)
+{
+    if (entry_count <= g_titleCacheCapacity) return true;
+
+    /* Grow geometrically, so populating an empty title cache doesn't reallocate the pointer array for every new entry. */
+    u32 new_capacity = (g_titleCacheCapacity ? g_titleCacheCapacity : 16);
+    while(new_capacity < entry_count) new_capacity *= 2;
+
+    NxTitleCacheApplicationMetadata **tmp_title_cache = realloc(g_titleCache, new_capacity * sizeof(NxTitleCacheApplicationMetadata*));
+    if (!tmp_title_cache)
+    {
+        NXTC_LOG_MSG("Failed to reallocate title cache entry pointer array! (%u element[s]).", new_capacity);
+        return false;
+    }
+
+    /* Clear new title cache entry pointer array area. */
+    memset(tmp_title_cache + g_titleCacheCapacity, 0, (new_capacity - g_titleCacheCapacity) * sizeof(NxTitleCacheApplicationMetadata*));
+
+    g_titleCache = tmp_title_cache;
+    g_titleCacheCapacity = new_capacity;
+
+    return true;
+}
+
+static void nxtcSortPendingCacheEntries(void)
+{
+    u32 sorted_count = g_titleCacheSortedCount, pending_count = (g_titleCacheCount - g_titleCacheSortedCount);
+    if (!pending_count) return;
+
+    /* Sort the pending title cache entries on their own. */
+    NxTitleCacheApplicationMetadata **pending = (g_titleCache + sorted_count);
+    if (pending_count > 1) qsort(pending, pending_count, sizeof(NxTitleCacheApplicationMetadata*), &nxtcEntrySortFunction);
+
+    /* Merge them into the sorted title cache entries, starting from the back. Nothing to do if they already follow the last sorted entry. */
+    if (sorted_count && g_titleCache[sorted_count - 1]->title_id > pending[0]->title_id)
+    {
+        NxTitleCacheApplicationMetadata **tmp_pending = malloc(pending_count * sizeof(NxTitleCacheApplicationMetadata*));
+        if (tmp_pending)
+        {
+            memcpy(tmp_pending, pending, pending_count * sizeof(NxTitleCacheApplicationMetadata*));
+
+            u32 i = sorted_count, j = pending_count, k = g_titleCacheCount;
+            while(j)
+            {
+                if (i && g_titleCache[i - 1]->title_id > tmp_pending[j - 1]->title_id)
+                {
+                    g_titleCache[--k] = g_titleCache[--i];
+                } else {
+                    g_titleCache[--k] = tmp_pending[--j];
+                }
+            }
+
+            free(tmp_pending);
+        } else {
+            /* Fall back to sorting the whole title cache in place. */
+            qsort(g_titleCache, g_titleCacheCount, sizeof(NxTitleCacheApplicationMetadata*), &nxtcEntrySortFunction);
+        }
+    }
+
+    g_titleCacheSortedCount = g_titleCacheCount;
+}
+
 static void nxtcFreeTitleCache(bool flush)
 {
     if (g_titleCache)
@@ -997,16 +1567,34 @@ static void nxtcFreeTitleCache(bool flush)
         /* This will return immediately if there's no pending changes. */
         if (flush) nxtcSaveFile();
 
-        /* Free title cache entries. */
-        for(u32 i = 0; i < g_titleCacheCount; i++) nxtcFreeApplicationMetadata(&(g_titleCache[i]));
+        /* Free title cache entries. Borrowed entries are freed once their last view is released. */
+        for(u32 i = 0; i < g_titleCacheCount; i++) nxtcDiscardCacheEntry(&(g_titleCache[i]));
 
         /* Free title cache pointer array. */
         free(g_titleCache);
         g_titleCache = NULL;
     }
 
-    /* Reset title cache entry count. */
-    g_titleCacheCount = 0;
+    /* Close the title cache file kept open in lazy load mode. Pending data blobs of borrowed entries can no longer be read. */
+    nxtcCloseCacheFile();
+
+    /* Reset title cache entry counts. */
+    g_titleCacheCount = g_titleCacheCapacity = g_titleCacheSortedCount = 0;
+}
+
+static void nxtcDiscardCacheEntry(NxTitleCacheApplicationMetadata **cache_entry)
+{
+    NxTitleCacheEntry *entry = NULL;
+    if (!cache_entry || !(entry = (NxTitleCacheEntry*)*cache_entry)) return;
+
+    if (entry->borrow_count)
+    {
+        /* Keep the entry alive for its outstanding views. */
+        entry->retired = true;
+        *cache_entry = NULL;
+    } else {
+        nxtcFreeApplicationMetadata(cache_entry);
+    }
 }
 
 static bool nxtcAppendDataBlobToFileCacheBuffer(u8 **cache_file_data, const NxTitleCacheApplicationMetadata *cache_entry, NxTitleCacheFileEntry *cache_file_entry, u32 *out_blob_offset, size_t *out_cur_offset)
@@ -1023,16 +1611,26 @@ static bool nxtcAppendDataBlobToFileCacheBuffer(u8 **cache_file_data, const NxTi
 
     bool success = false;
 
+    /* Entries with data that hasn't been read yet (lazy load mode) have their data blobs copied as-is from the current title cache file. */
+    const NxTitleCacheEntry *lazy_cache_entry = (const NxTitleCacheEntry*)cache_entry;
+    bool copy_blob = (lazy_cache_entry->strings_pending || lazy_cache_entry->icon_pending);
+
     /* Populate current title cache file entry. */
-    cache_file_entry->title_id = cache_entry->title_id;
-    cache_file_entry->name_len = (u16)strlen(cache_entry->name);
-    cache_file_entry->publisher_len = (u16)strlen(cache_entry->publisher);
-    cache_file_entry->version_len = (u16)strlen(cache_entry->version);
-    cache_file_entry->reserved = 0;  // 保留字段设为0 / Set reserved field to 0
-    cache_file_entry->version_info = cache_entry->version_info;  // 序列化数值版本信息 / Serialize numeric version info
-    cache_file_entry->icon_size = cache_entry->icon_size;
+    if (copy_blob)
+    {
+        memcpy(cache_file_entry, &(lazy_cache_entry->file_entry), sizeof(NxTitleCacheFileEntry));
+    } else {
+        cache_file_entry->title_id = cache_entry->title_id;
+        cache_file_entry->name_len = (u16)strlen(cache_entry->name);
+        cache_file_entry->publisher_len = (u16)strlen(cache_entry->publisher);
+        cache_file_entry->version_len = (u16)strlen(cache_entry->version);
+        cache_file_entry->reserved = 0;  // 保留字段设为0 / Set reserved field to 0
+        cache_file_entry->version_info = cache_entry->version_info;  // 序列化数值版本信息 / Serialize numeric version info
+        cache_file_entry->icon_size = cache_entry->icon_size;
+        cache_file_entry->blob_size = nxtcCalculateDataBlobSize(cache_file_entry->name_len, cache_file_entry->publisher_len, cache_file_entry->version_len, cache_file_entry->icon_size);
+    }
+
     cache_file_entry->blob_offset = *out_blob_offset;
-    cache_file_entry->blob_size = nxtcCalculateDataBlobSize(cache_file_entry->name_len, cache_file_entry->publisher_len, cache_file_entry->version_len, cache_file_entry->icon_size);
 
     /* Reallocate title cache file data buffer to append blob data. */
     aligned_blob_size = ALIGN_UP(cache_file_entry->blob_size, TITLE_CACHE_ALIGNMENT);
@@ -1049,23 +1647,29 @@ static bool nxtcAppendDataBlobToFileCacheBuffer(u8 **cache_file_data, const NxTi
     cache_file_entry = (NxTitleCacheFileEntry*)(ptr + cache_file_entry_offset);
     ptr += *out_cur_offset;
 
-    /* Populate data blob. */
-    memset(ptr + data_offset, 0, ALIGN_UP(cache_file_entry->name_len, TITLE_CACHE_ALIGNMENT));
-    memcpy(ptr + data_offset, cache_entry->name, cache_file_entry->name_len);
-    data_offset += ALIGN_UP(cache_file_entry->name_len, TITLE_CACHE_ALIGNMENT);
+    if (copy_blob)
+    {
+        /* Copy data blob. Its checksum is verified once it's read again. */
+        if (!nxtcReadCacheFileBlobData(lazy_cache_entry, 0, ptr, cache_file_entry->blob_size)) goto end;
+    } else {
+        /* Populate data blob. */
+        memset(ptr + data_offset, 0, ALIGN_UP(cache_file_entry->name_len, TITLE_CACHE_ALIGNMENT));
+        memcpy(ptr + data_offset, cache_entry->name, cache_file_entry->name_len);
+        data_offset += ALIGN_UP(cache_file_entry->name_len, TITLE_CACHE_ALIGNMENT);
 
-    memset(ptr + data_offset, 0, ALIGN_UP(cache_file_entry->publisher_len, TITLE_CACHE_ALIGNMENT));
-    memcpy(ptr + data_offset, cache_entry->publisher, cache_file_entry->publisher_len);
-    data_offset += ALIGN_UP(cache_file_entry->publisher_len, TITLE_CACHE_ALIGNMENT);
+        memset(ptr + data_offset, 0, ALIGN_UP(cache_file_entry->publisher_len, TITLE_CACHE_ALIGNMENT));
+        memcpy(ptr + data_offset, cache_entry->publisher, cache_file_entry->publisher_len);
+        data_offset += ALIGN_UP(cache_file_entry->publisher_len, TITLE_CACHE_ALIGNMENT);
 
-    memset(ptr + data_offset, 0, ALIGN_UP(cache_file_entry->version_len, TITLE_CACHE_ALIGNMENT));
-    memcpy(ptr + data_offset, cache_entry->version, cache_file_entry->version_len);
-    data_offset += ALIGN_UP(cache_file_entry->version_len, TITLE_CACHE_ALIGNMENT);
+        memset(ptr + data_offset, 0, ALIGN_UP(cache_file_entry->version_len, TITLE_CACHE_ALIGNMENT));
+        memcpy(ptr + data_offset, cache_entry->version, cache_file_entry->version_len);
+        data_offset += ALIGN_UP(cache_file_entry->version_len, TITLE_CACHE_ALIGNMENT);
 
-    memcpy(ptr + data_offset, cache_entry->icon_data, cache_entry->icon_size);
+        memcpy(ptr + data_offset, cache_entry->icon_data, cache_entry->icon_size);
 
-    /* Update title cache file entry checksums. */
-    cache_file_entry->blob_crc = crc32Calculate(ptr, cache_file_entry->blob_size);
+        /* Update title cache file entry checksums. */
+        cache_file_entry->blob_crc = crc32Calculate(ptr, cache_file_entry->blob_size);
+    }
 
     volatile u32 *crc = (volatile u32*)&(cache_file_entry->crc); // Used to prevent the compiler from optimizing away store/load operations.
     *crc = 0;
@@ -1121,13 +1725,42 @@ static NxTitleCacheApplicationMetadata *_nxtcGetApplicationMetadataEntryById(u64
 {
     if (!g_nxtcRefCount || !g_titleCache || !g_titleCacheCount || !title_id) return NULL;
 
-    for(u32 i = 0; i < g_titleCacheCount; i++)
+    u32 idx = 0;
+    return (nxtcGetCacheEntryIndex(title_id, &idx) ? g_titleCache[idx] : NULL);
+}
+
+/* Binary search over the sorted title cache entries, followed by a linear search over any entries appended during a batch. */
+static bool nxtcGetCacheEntryIndex(u64 title_id, u32 *out_index)
+{
+    u32 low = 0, high = g_titleCacheSortedCount;
+
+    while(low < high)
     {
-        NxTitleCacheApplicationMetadata *cur_cache_entry = g_titleCache[i];
-        if (cur_cache_entry && cur_cache_entry->title_id == title_id) return cur_cache_entry;
+        u32 mid = (low + ((high - low) / 2));
+        if (g_titleCache[mid]->title_id < title_id)
+        {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low < g_titleCacheSortedCount && g_titleCache[low]->title_id == title_id)
+    {
+        *out_index = low;
+        return true;
+    }
+
+    for(u32 i = g_titleCacheSortedCount; i < g_titleCacheCount; i++)
+    {
+        if (g_titleCache[i]->title_id == title_id)
+        {
+            *out_index = i;
+            return true;
+        }
     }
 
-    return NULL;
+    return false;
 }
 
 static int nxtcEntrySortFunction(const void *a, const void *b)
@@ -21,6 +21,7 @@
 #include <time.h>
 #include <math.h>
 #include <assert.h>
+#include <sys/stat.h>
 #include <nxtc_version.h>
 
 #include "nxtc_log.h"
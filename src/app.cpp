@@ -12,8 +12,8 @@
 #include "json_manager.hpp"
 // 虚拟键盘辅助工具 (Virtual keyboard helper)
 #include "keyboard_helper.hpp"
-// 拼音库 (Pinyin library)
-#include "Pinyin-onefile.cpp"
+// 选中项脉冲颜色 (Selection pulse colour)
+#include "pulse_colour.hpp"
 // 时间计算 (Time calculation)
 #include <chrono>
 
@@ -100,46 +100,15 @@ struct ApplicationOccupiedSize {
 constexpr float SCREEN_WIDTH = 1280.f;  // 屏幕宽度 (Screen width)
 constexpr float SCREEN_HEIGHT = 720.f;  // 屏幕高度 (Screen height)
 constexpr int BATCH_SIZE = 4; // 首批加载的应用数量 (Initial batch size for loading apps)
-
-// 验证JPEG数据完整性的辅助函数
-// Helper function to validate JPEG data integrity
-bool IsValidJpegData(const std::vector<unsigned char>& data) {
-    if (data.size() < 4) return false;
-    
-    // 检查JPEG文件头和文件尾
-    // Check JPEG file header and trailer
-    bool has_jpeg_header = (data[0] == 0xFF && data[1] == 0xD8);
-    bool has_jpeg_trailer = (data[data.size()-2] == 0xFF && data[data.size()-1] == 0xD9);
-    return has_jpeg_header && has_jpeg_trailer;
-}
+constexpr const char* CATALOG_SNAPSHOT_PATH = "/mods2/catalog_snapshot.bin"; // 主页游戏列表快照 (Home game list snapshot)
 
 
 // 异步删除应用程序函数 (Asynchronous application deletion function)
-// 来自游戏卡安装器的脉冲颜色结构体 (Pulse color structure from gamecard installer)
-struct PulseColour {
-    NVGcolor col{0, 255, 187, 255}; // 颜色值 (Color value)
-    u8 delay;                       // 延迟时间 (Delay time)
-    bool increase_blue;             // 是否增加蓝色分量 (Whether to increase blue component)
-};
-
-PulseColour pulse; //脉冲颜色对象(Pulse color object)
+tj::PulseColour pulse; //脉冲颜色对象(Pulse color object)
 
-void update_pulse_colour() { //更新脉冲颜色函数(Update pulse color function)
-    if (pulse.col.g == 255) { //当绿色分量达到最大值时(When green component reaches maximum)
-        pulse.increase_blue = true; //开始增加蓝色分量(Start increasing blue component)
-    } else if (pulse.col.b == 255 && pulse.delay == 10) { //当蓝色分量达到最大值且延迟达到10时(When blue component reaches maximum and delay reaches 10)
-        pulse.increase_blue = false; //停止增加蓝色分量(Stop increasing blue component)
-        pulse.delay = 0; //重置延迟计数器(Reset delay counter)
-    }
-
-    
-    
-    if (pulse.col.b == 255 && pulse.increase_blue == true) { //当蓝色分量为最大值且正在增加蓝色时(When blue component is at maximum and increasing blue)
-        pulse.delay++; //增加延迟计数器(Increment delay counter)
-    } else {
-        pulse.col.b = pulse.increase_blue ? pulse.col.b + 2 : pulse.col.b - 2; //根据方向调整蓝色分量(Adjust blue component based on direction)
-        pulse.col.g = pulse.increase_blue ? pulse.col.g - 2 : pulse.col.g + 2; //根据方向调整绿色分量(Adjust green component based on direction)
-    }
+// 每个绘制高亮的画面都调用一次 (Called once by every screen that draws the highlight)
+void update_pulse_colour(tj::FrameScheduler& frame_scheduler) { //更新脉冲颜色函数(Update pulse color function)
+    pulse.Update(frame_scheduler, tj::FrameScheduler::Clock::now());
 }
 
 } // namespace
@@ -296,7 +265,12 @@ void App::Loop() { // 应用程序主循环方法 (Application main loop method)
         // 执行每帧的核心操作 (Execute core operations per frame)
         this->Poll(); // 处理输入事件 (Process input events)
         this->Update(); // 更新游戏逻辑 (Update game logic)
-        this->Draw(); // 渲染画面 (Render graphics)
+        // 画面没有变化时跳过绘制，屏幕保留上一帧，把CPU留给后台安装、校验和MTP传输
+        // (Skip drawing when nothing changed, the screen keeps the last frame and the CPU is left to background installs,
+        // checksums and MTP transfers)
+        if (this->frame_scheduler.ShouldDraw(frame_start)) {
+            this->Draw(); // 渲染画面 (Render graphics)
+        }
         
         // 计算帧时间并限制到60FPS (Calculate frame time and limit to 60FPS)
         // 这是帧率控制的关键部分 (This is the key part of frame rate control)
@@ -353,6 +327,12 @@ void App::Poll() { // 输入事件轮询方法 (Input event polling method)
     const auto down = padGetButtonsDown(&this->pad); // 获取本帧新按下的按钮 (Get buttons pressed this frame)
     const auto held = padGetButtons(&this->pad); // 获取当前持续按住的按钮 (Get buttons currently held)
 
+    // 有按键或触摸时重绘 (Redraw on buttons or touch)
+    HidTouchScreenState touch_state{};
+    if (down || held || (hidGetTouchScreenStates(&touch_state, 1) && touch_state.count > 0)) {
+        this->frame_scheduler.MarkActive(input_start);
+    }
+
     // 检查是否超时，如果超时则跳过复杂的按键处理 (Check for timeout, skip complex key processing if timed out)
     // 这是第一个超时检查点，确保基础输入获取不会超时 (This is the first timeout checkpoint, ensuring basic input acquisition doesn't timeout)
     auto current_time = std::chrono::steady_clock::now(); // 获取当前时间 (Get current time)
@@ -456,6 +436,14 @@ void App::Update() {
     if (enable_frame_load_limit) { // 检查是否启用了帧限制资源加载 (Check if frame-limited resource loading is enabled)
         resource_manager.processFrameLoads(); // 处理当前帧允许的资源加载任务 (Process resource loading tasks allowed for current frame)
     }
+
+    // 上传后台解码好的图标纹理 (Upload icon textures decoded in the background)
+    this->UploadDecodedIcons();
+
+    // 扫描期间列表持续增长，逐帧绘制 (The lists keep growing while scanning, draw every frame)
+    if (is_scan_running || addgame_scan_running) {
+        this->frame_scheduler.MarkDirty();
+    }
     
     // 处理对话框更新 (Handle dialog update)
     if (this->show_newdialog) {
@@ -699,12 +687,12 @@ void App::DrawList() {
         // 检查是否为当前光标选中的项 (Check if this is the currently cursor-selected item)
         if (i == this->index) {
             // 当前选中项：绘制彩色边框和半透明背景 (Current selected item: draw colored border and semi-transparent background)
-            auto col = pulse.col;  // 获取脉冲颜色 (Get pulse color)
+            auto col = pulse.GetColour();  // 获取脉冲颜色 (Get pulse color)
             col.r /= 255.f;        // 红色通道归一化(0-1范围) (Normalize red channel to 0-1 range)
             col.g /= 255.f;        // 绿色通道归一化 (Normalize green channel)
             col.b /= 255.f;        // 蓝色通道归一化 (Normalize blue channel)
             col.a = 1.f;           // 设置不透明度为1(完全不透明) (Set alpha to 1 - fully opaque)
-            update_pulse_colour(); // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
+            update_pulse_colour(this->frame_scheduler); // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
             
             // 绘制选中项的彩色边框 (Draw colored border for selected item)
             gfx::drawRect(this->vg, item_x - 5.f, item_y - 5.f, item_width + 10.f, item_height + 10.f, col);
@@ -953,12 +941,12 @@ void App::DrawAddGameList() {
         // 检查是否为当前光标选中的项 (Check if this is the currently cursor-selected item)
         if (i == this->index_AddGame) {
             // 当前选中项：绘制彩色边框和半透明背景 (Current selected item: draw colored border and semi-transparent background)
-            auto col = pulse.col;  // 获取脉冲颜色 (Get pulse color)
+            auto col = pulse.GetColour();  // 获取脉冲颜色 (Get pulse color)
             col.r /= 255.f;        // 红色通道归一化(0-1范围) (Normalize red channel to 0-1 range)
             col.g /= 255.f;        // 绿色通道归一化 (Normalize green channel)
             col.b /= 255.f;        // 蓝色通道归一化 (Normalize blue channel)
             col.a = 1.f;           // 设置不透明度为1(完全不透明) (Set alpha to 1 - fully opaque)
-            update_pulse_colour(); // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
+            update_pulse_colour(this->frame_scheduler); // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
             
             // 绘制选中项的彩色边框 (Draw colored border for selected item)
             gfx::drawRect(this->vg, item_x - 5.f, item_y - 5.f, item_width + 10.f, item_height + 10.f, col);
@@ -1111,12 +1099,12 @@ void App::DrawModList() {
         // 检查是否为当前光标选中的项 (Check if this is the currently cursor-selected item)
         if (i == this->mod_index) {
             // 当前选中项：绘制彩色边框和黑色背景 (Current selected item: draw colored border and black background)
-            auto col = pulse.col;  // 获取脉冲颜色 (Get pulse color)
+            auto col = pulse.GetColour();  // 获取脉冲颜色 (Get pulse color)
             col.r /= 255.f;        // 红色通道归一化(0-1范围) (Normalize red channel to 0-1 range)
             col.g /= 255.f;        // 绿色通道归一化 (Normalize green channel)
             col.b /= 255.f;        // 蓝色通道归一化 (Normalize blue channel)
             col.a = 1.f;           // 设置不透明度为1(完全不透明) (Set alpha to 1 - fully opaque)
-            update_pulse_colour(); // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
+            update_pulse_colour(this->frame_scheduler); // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
             // 绘制选中项的彩色边框 (Draw colored border for selected item)
             gfx::drawRect(this->vg, x - 5.f, y - 5.f, box_width + 10.f, box_height + 10.f, col);
             // 绘制选中项的黑色背景 (Draw black background for selected item)
@@ -1416,6 +1404,14 @@ void App::DrawMTP() {
 }    
 
 void App::UpdateMTP() {
+
+    // 传输信息变化时重绘，传输期间画面不变的帧仍然跳过 (Redraw when the transfer info changes, unchanged frames are still
+    // skipped during transfers)
+    std::string transfer_info = this->mtp_manager->GetTransferInfo();
+    if (transfer_info != this->mtp_last_transfer_info) {
+        this->mtp_last_transfer_info = std::move(transfer_info);
+        this->frame_scheduler.MarkDirty();
+    }
  
     // 处理B键返回逻辑 (Handle B key return logic)
     if (this->controller.B) {
@@ -1509,64 +1505,22 @@ bool App::CompareModGameVersion(const std::string& mod_version, const std::strin
     return simple_mod == simple_game;
 }
 
-// 拼音排序辅助函数：获取游戏名称第一个字符的拼音用于排序 (Pinyin sorting helper function: get pinyin of first character for sorting)
-std::string App::GetFirstCharPinyin(const std::string& chinese_text) {
-    if (chinese_text.empty()) {
-        return ""; // 空字符串直接返回 (Return empty for empty string)
+// 按映射名的排序键排序游戏目录：每个目录只计算一次排序键 (Sort game directories by the sort key of their mapped name,
+// computing each directory's key only once)
+void App::SortGameDirsByMappedName(std::vector<std::string>& game_dirs) {
+    std::vector<std::pair<std::string, std::string>> keyed_dirs;
+    keyed_dirs.reserve(game_dirs.size());
+    for (auto& game_dir : game_dirs) {
+        // 从缓存中获取映射名称，如果没有则使用目录名 (Get mapped name from cache, use directory name if not found)
+        auto it = game_name_cache.find(game_dir);
+        keyed_dirs.emplace_back(tj::MakeCollationKey(it != game_name_cache.end() ? it->second.display_name : game_dir), std::move(game_dir));
     }
-    
-    // 特殊处理"传"字 (Special handling for "传" character)
-    // 检查是否以"传"字开头 - UTF-8编码的"传"字为 E4 BC A0
-    if (chinese_text.length() >= 3 && 
-        (unsigned char)chinese_text[0] == 0xE4 && 
-        (unsigned char)chinese_text[1] == 0xBC && 
-        (unsigned char)chinese_text[2] == 0xA0) {
-        return "CHUAN"; // 直接返回"传"的正确拼音 (Directly return correct pinyin for "传")
-    }
-   
-    
-    wchar_t wch = 0;
-    int bytes = 1;
-    
-    // UTF-8解码第一个字符 (UTF-8 decode first character)
-    unsigned char c = chinese_text[0];
-    if (c < 0x80) {
-        wch = c;
-        bytes = 1;
-    } else if ((c & 0xE0) == 0xC0 && chinese_text.length() >= 2) {
-        wch = ((c & 0x1F) << 6) | (chinese_text[1] & 0x3F);
-        bytes = 2;
-    } else if ((c & 0xF0) == 0xE0 && chinese_text.length() >= 3) {
-        wch = ((c & 0x0F) << 12) | ((chinese_text[1] & 0x3F) << 6) | (chinese_text[2] & 0x3F);
-        bytes = 3;
-    } else if ((c & 0xF8) == 0xF0 && chinese_text.length() >= 4) {
-        wch = ((c & 0x07) << 18) | ((chinese_text[1] & 0x3F) << 12) | ((chinese_text[2] & 0x3F) << 6) | (chinese_text[3] & 0x3F);
-        bytes = 4;
-    }
-    
-    // 检查是否为中文字符并获取拼音 (Check if Chinese character and get pinyin)
-    if (WzhePinYin::Pinyin::IsChinese(wch)) {
-        auto pinyins = WzhePinYin::Pinyin::GetPinyins(wch);
-        if (!pinyins.empty()) {
-            return pinyins[0]; // 返回第一个拼音 (Return first pinyin)
-        }
-    }
-    
-    // 非中文字符直接返回原字符 (Return original character for non-Chinese)
-    return chinese_text.substr(0, bytes);
-}
 
-// 游戏目录排序辅助函数 (Game directory sorting helper function)
-bool App::gamedirsort(const std::string& a, const std::string& b) {
-    // 从缓存中获取映射名称，如果没有则使用目录名 (Get mapped name from cache, use directory name if not found)
-    std::string mapped_name_a = game_name_cache.count(a) ? game_name_cache[a].display_name : a;
-    std::string mapped_name_b = game_name_cache.count(b) ? game_name_cache[b].display_name : b;
-    
-    // 获取拼音首字符并进行比较 (Get pinyin first character and compare)
-    std::string pinyin_a = GetFirstCharPinyin(mapped_name_a);
-    std::string pinyin_b = GetFirstCharPinyin(mapped_name_b);
-    
-    return pinyin_a < pinyin_b;
+    std::ranges::sort(keyed_dirs);
+
+    for (size_t i = 0; i < keyed_dirs.size(); ++i) {
+        game_dirs[i] = std::move(keyed_dirs[i].second);
+    }
 }
 
 // 辅助函数：通用的应用条目比较函数
@@ -1589,19 +1543,18 @@ bool App::CompareAppEntries(const AppEntry& a, const AppEntry& b, bool reverse_o
     
     // 在同一组内按拼音顺序排序
     // Within the same group, sort by pinyin order
-    std::string pinyin_a = this->GetFirstCharPinyin(a.FILE_NAME2);
-    std::string pinyin_b = this->GetFirstCharPinyin(b.FILE_NAME2);
-    
     if (reverse_order) {
-        return pinyin_a < pinyin_b; // A-Z排序 (A-Z order)
+        return a.sort_key < b.sort_key; // A-Z排序 (A-Z order)
     } else {
-        return pinyin_a > pinyin_b; // Z-A排序 (Z-A order)
+        return a.sort_key > b.sort_key; // Z-A排序 (Z-A order)
     }
 }
 
 void App::Sort()
 {
-    // std::scoped_lock lock{entries_mutex}; // 保护entries向量的排序操作 (Protect entries vector sorting operation)
+    // 调用方需持有entries_mutex：收藏切换可能在后台扫描期间调用，扫描线程同样在此锁下修改entries和entry_slots
+    // (The caller must hold entries_mutex: favorite toggling can run while the background scan does, and the scan thread
+    // mutates entries and entry_slots under the same lock)
     switch (static_cast<SortType>(this->sort_type)) {
         case SortType::Alphabetical:
             // 按应用名称拼音Z-A排序，但先按喜欢-安装状态分组
@@ -1625,6 +1578,7 @@ void App::Sort()
             });
             break;
     }
+    ReindexEntrySlots(0);
 }
 
 // ADDGAMELIST界面专用的排序函数 (Dedicated sorting function for ADDGAMELIST interface)
@@ -1636,45 +1590,31 @@ void App::Sort2()
             // 按游戏名称拼音Z-A排序
             // Sort by game name pinyin Z-A
             std::ranges::sort(this->entries_AddGame, [this](const AppEntry_AddGame& a, const AppEntry_AddGame& b) {
-                // 获取游戏名称的拼音首字母
-                // Get pinyin of first character of game name
-                std::string pinyin_a = this->GetFirstCharPinyin(a.name);
-                std::string pinyin_b = this->GetFirstCharPinyin(b.name);
-                
                 // 按拼音Z-A排序
                 // Sort by pinyin Z-A
-                return pinyin_a > pinyin_b;
+                return a.sort_key > b.sort_key;
             });
             break;
         case SortType_AddGame::Alphabetical:
             // 按游戏名称拼音A-Z排序
             // Sort by game name pinyin A-Z
             std::ranges::sort(this->entries_AddGame, [this](const AppEntry_AddGame& a, const AppEntry_AddGame& b) {
-                // 获取游戏名称的拼音首字母
-                // Get pinyin of first character of game name
-                std::string pinyin_a = this->GetFirstCharPinyin(a.name);
-                std::string pinyin_b = this->GetFirstCharPinyin(b.name);
-                
                 // 按拼音A-Z排序
                 // Sort by pinyin A-Z
-                return pinyin_a < pinyin_b;
+                return a.sort_key < b.sort_key;
             });
             break;
         default:
             // 默认按游戏名称拼音A-Z排序
             // Default sort by game name pinyin A-Z
             std::ranges::sort(this->entries_AddGame, [this](const AppEntry_AddGame& a, const AppEntry_AddGame& b) {
-                // 获取游戏名称的拼音首字母
-                // Get pinyin of first character of game name
-                std::string pinyin_a = this->GetFirstCharPinyin(a.name);
-                std::string pinyin_b = this->GetFirstCharPinyin(b.name);
-                
                 // 按拼音A-Z排序
                 // Sort by pinyin A-Z
-                return pinyin_a < pinyin_b;
+                return a.sort_key < b.sort_key;
             });
             break;
     }
+    ReindexAddGameEntrySlots(0);
 }
 
 const char* App::GetSortStr() {
@@ -2227,6 +2167,7 @@ void App::UpdateAddGameList() {
         {
             std::lock_guard<std::mutex> lock(this->entries_AddGame_mutex);
             this->entries_AddGame.clear();
+            this->addgame_entry_slots.clear();
         }
         
         // 重置扫描计数器 (Reset scan counters)
@@ -2571,27 +2512,25 @@ bool App::TryGetAppBasicInfoWithIconCache(u64 application_id, AppEntry& entry) {
 
     // 1. 优先尝试从缓存获取应用名称
     // 1. Try to get application name from cache first
-    NxTitleCacheApplicationMetadata* cached_metadata = nxtcGetApplicationMetadataEntryById(application_id);
-    if (cached_metadata != nullptr && version_32 == cached_metadata->version_info) {
-        entry.name = cached_metadata->name;
-        entry.id = cached_metadata->title_id;
-        entry.display_version = cached_metadata->version; 
+    // 借用缓存条目而不是复制，图标直接引用缓存内的数据
+    // Borrow the cache entry instead of copying it, the icon references the cache's own bytes
+    NxTitleCacheApplicationMetadataView cached_metadata{};
+    if (nxtcBorrowApplicationMetadataById(application_id, &cached_metadata) && version_32 != cached_metadata.version_info) {
+        nxtcReleaseApplicationMetadataView(&cached_metadata);
+    }
+    if (cached_metadata.handle != nullptr) {
+        entry.name = cached_metadata.name;
+        entry.id = cached_metadata.title_id;
+        entry.display_version = cached_metadata.version; 
         // 暂时设置默认值，稍后异步加载
         // Set default values temporarily, load asynchronously later
         entry.image = this->default_icon_image;
         entry.own_image = false;
         
-        // 缓存图标数据到AppEntry中
-        // Cache icon data in AppEntry
-        if (cached_metadata->icon_data && cached_metadata->icon_size > 0) {
-            entry.cached_icon_data.resize(cached_metadata->icon_size);
-            memcpy(entry.cached_icon_data.data(), cached_metadata->icon_data, cached_metadata->icon_size);
-            entry.has_cached_icon = true;
-        } else {
-            entry.has_cached_icon = false;
-        }
-        
-        nxtcFreeApplicationMetadata(&cached_metadata);
+        // 缓存图标数据到AppEntry中，由图标数据接管视图并在最后一个引用释放时归还
+        // Cache icon data in AppEntry, the icon data takes over the view and returns it when the last reference goes away
+        entry.cached_icon_data = tj::IconData::FromTitleCache(cached_metadata);
+        entry.has_cached_icon = entry.cached_icon_data != nullptr;
         
         return true;
     }
@@ -2628,17 +2567,18 @@ bool App::TryGetAppBasicInfoWithIconCache(u64 application_id, AppEntry& entry) {
     entry.image = this->default_icon_image;
     entry.own_image = false;
     
-    // 缓存图标数据到AppEntry中，避免后续重复读取
-    // Cache icon data in AppEntry to avoid repeated reads later
+    // 添加到缓存系统并传递版本信息，图标借用新的缓存条目，缓存文件写入后纹理上传完即可释放；添加失败时才复制一份
+    // Add to the cache system with the version info, the icon borrows the new cache entry so it can be freed after the
+    // texture upload once the cache file is written; only copied if adding fails
     if (jpeg_size > sizeof(NacpStruct)) {
         size_t icon_size = jpeg_size - sizeof(NacpStruct);
-        entry.cached_icon_data.resize(icon_size);
-        memcpy(entry.cached_icon_data.data(), control_data->icon, icon_size);
-        entry.has_cached_icon = true;
-        
-        // 仍然添加到缓存系统以供其他用途，并传递版本信息
-        // Still add to cache system for other uses, and pass version info
-        nxtcAddEntry(application_id, &control_data->nacp, icon_size, control_data->icon, true, version_32);
+        if (nxtcAddEntry(application_id, &control_data->nacp, icon_size, control_data->icon, true, version_32) &&
+            nxtcBorrowApplicationMetadataById(application_id, &cached_metadata)) {
+            entry.cached_icon_data = tj::IconData::FromTitleCache(cached_metadata);
+        } else {
+            entry.cached_icon_data = tj::IconData::FromBytes(control_data->icon, icon_size);
+        }
+        entry.has_cached_icon = entry.cached_icon_data != nullptr;
     } else {
         entry.has_cached_icon = false;
     }
@@ -2654,28 +2594,27 @@ bool App::TryGetAppBasicInfoWithIconCacheForAddGame(u64 application_id, AppEntry
 
     // 2. entries中不存在，优先尝试从缓存获取应用名称
     // 2. Not found in entries, try to get application name from cache first
-    NxTitleCacheApplicationMetadata* cached_metadata = nxtcGetApplicationMetadataEntryById(application_id);
-    if (cached_metadata != nullptr && version_32 == cached_metadata->version_info) {
-        entry.name = cached_metadata->name;
-        entry.id = cached_metadata->title_id;
-        entry.display_version = cached_metadata->version; 
+    // 借用缓存条目而不是复制，图标直接引用缓存内的数据
+    // Borrow the cache entry instead of copying it, the icon references the cache's own bytes
+    NxTitleCacheApplicationMetadataView cached_metadata{};
+    if (nxtcBorrowApplicationMetadataById(application_id, &cached_metadata) && version_32 != cached_metadata.version_info) {
+        nxtcReleaseApplicationMetadataView(&cached_metadata);
+    }
+    if (cached_metadata.handle != nullptr) {
+        entry.name = cached_metadata.name;
+        entry.sort_key = tj::MakeCollationKey(entry.name);
+        entry.id = cached_metadata.title_id;
+        entry.display_version = cached_metadata.version; 
         // 暂时设置默认值，稍后异步加载
         // Set default values temporarily, load asynchronously later
         entry.image = this->default_icon_image;
         entry.own_image = false;
         entry.unique_id = unique_id++;
         
-        // 缓存图标数据到AppEntry_AddGame中
-        // Cache icon data in AppEntry_AddGame
-        if (cached_metadata->icon_data && cached_metadata->icon_size > 0) {
-            entry.cached_icon_data.resize(cached_metadata->icon_size);
-            memcpy(entry.cached_icon_data.data(), cached_metadata->icon_data, cached_metadata->icon_size);
-            entry.has_cached_icon = true;
-        } else {
-            entry.has_cached_icon = false;
-        }
-        
-        nxtcFreeApplicationMetadata(&cached_metadata);
+        // 缓存图标数据到AppEntry_AddGame中，由图标数据接管视图并在最后一个引用释放时归还
+        // Cache icon data in AppEntry_AddGame, the icon data takes over the view and returns it when the last reference goes away
+        entry.cached_icon_data = tj::IconData::FromTitleCache(cached_metadata);
+        entry.has_cached_icon = entry.cached_icon_data != nullptr;
         
         return true;
     }
@@ -2705,6 +2644,7 @@ bool App::TryGetAppBasicInfoWithIconCacheForAddGame(u64 application_id, AppEntry
     }
     
     entry.name = language_entry->name;
+    entry.sort_key = tj::MakeCollationKey(entry.name);
     entry.id = application_id;
     entry.display_version = control_data->nacp.display_version; // 从NACP获取显示版本 (Get display version from NACP)
     // 暂时设置默认值，稍后异步加载
@@ -2717,8 +2657,7 @@ bool App::TryGetAppBasicInfoWithIconCacheForAddGame(u64 application_id, AppEntry
     // Cache icon data in AppEntry_AddGame to avoid repeated reads later
     if (jpeg_size > sizeof(NacpStruct)) {
         size_t icon_size = jpeg_size - sizeof(NacpStruct);
-        entry.cached_icon_data.resize(icon_size);
-        memcpy(entry.cached_icon_data.data(), control_data->icon, icon_size);
+        entry.cached_icon_data = tj::IconData::FromBytes(control_data->icon, icon_size);
         entry.has_cached_icon = true;
         
         // 仍然添加到缓存系统以供其他用途
@@ -2731,76 +2670,6 @@ bool App::TryGetAppBasicInfoWithIconCacheForAddGame(u64 application_id, AppEntry
     return true;
 }
 
-// 辅助函数：根据filename_path获取其下面的modid和mod目录数量（使用标准C库）
-// Helper function: Get modid and mod directory count under filename_path (using standard C library)
-std::pair<u64, std::string> App::GetModIdAndSubdirCountStdio(const std::string& filename_path) {
-    // 打开filename目录
-    // Open filename directory
-    DIR* filename_dir = opendir(filename_path.c_str());
-    if (!filename_dir) {
-        return {0, "0"}; // 返回空结果
-    }
-    
-    // 读取第一个有效目录条目（应该是唯一的modid文件夹）
-    // Read the first valid directory entry (should be the only modid folder)
-    struct dirent* entry;
-    u64 application_id = 0;
-    std::string modid_name; // 保存modid目录名，避免在closedir后访问失效指针
-    
-    while ((entry = readdir(filename_dir)) != nullptr) {
-        // 跳过当前目录和父目录
-        // Skip current and parent directory entries
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
-        }
-        
-        // 将modid字符串转换为u64类型的应用ID
-        // Convert modid string to u64 application ID
-        char* endptr;
-        application_id = strtoull(entry->d_name, &endptr, 16);
-        
-        // 检查转换是否成功（modid应该是16进制字符串）
-        // Check if conversion was successful (modid should be hex string)
-        if (*endptr == '\0' && application_id != 0) {
-            modid_name = entry->d_name; // 保存有效的modid目录名
-            break;
-        }
-    }
-    
-    closedir(filename_dir);
-    
-    if (application_id == 0 || modid_name.empty()) {
-        return {0, "0"}; // 未找到有效的modid
-    }
-    
-    // 读取modid目录下的子目录数量
-    // Read subdirectory count under modid directory
-    std::string modid_path = filename_path + "/" + modid_name;
-    DIR* modid_dir = opendir(modid_path.c_str());
-    
-    int mod_count = 0; // MOD目录数量计数器
-    if (modid_dir) {
-        struct dirent* subentry;
-        while ((subentry = readdir(modid_dir)) != nullptr) {
-            // 跳过当前目录和父目录和带点的文件
-            // Skip current and parent directory entries and files with dots
-            std::string dirname = subentry->d_name;
-            if (strcmp(subentry->d_name, ".") == 0 || strcmp(subentry->d_name, "..") == 0 ||(dirname.find('.') != std::string::npos)) {
-                continue;
-            }
-            
-            mod_count++; // 计数有效的MOD目录
-        }
-        closedir(modid_dir);
-    }
-    
-    return {application_id, std::to_string(mod_count)};
-}
-
-
-
-
-
 void App::FastScanModInfo() {
     // 清空之前的MOD信息
     // Clear previous MOD information
@@ -2868,6 +2737,7 @@ void App::FastScanModInfo() {
             mod_info_item.MOD_TYPE = NONE_TYPE_TEXT;
         }
         mod_info_item.MOD_NAME2 = GetMappedModName(mod_info_item.MOD_NAME, mod_info_item.MOD_TYPE);
+        mod_info_item.sort_key = tj::MakeCollationKey(mod_info_item.MOD_NAME2);
         // 将解析的MOD信息添加到容器中
         // Add parsed MOD information to container
         this->mod_info.push_back(mod_info_item);
@@ -2939,14 +2809,8 @@ std::vector<std::string> App::scanmodgamedir() {
 
 
     // 这里对JOSN中收集到的目录进行排序，按映射名的拼音排序
-    std::ranges::sort(non_favorites_games_array, [this](const std::string& game_dir_a, const std::string& game_dir_b) {
-        return gamedirsort(game_dir_a, game_dir_b);
-    });
-    
-    
-    std::ranges::sort(favorites_games_array, [this](const std::string& game_dir_a, const std::string& game_dir_b) {
-        return gamedirsort(game_dir_a, game_dir_b);
-    });
+    SortGameDirsByMappedName(non_favorites_games_array);
+    SortGameDirsByMappedName(favorites_games_array);
 
     // 排序完成后，在favorites_games_array最后添加一个END$180作为标记
     favorites_games_array.push_back("END::FAVORITES");
@@ -3014,17 +2878,63 @@ void App::FastScanNames(std::stop_token stop_token) {
 
     }
 
+    // 扫描期间新增的缓存条目只追加，结束时统一排序一次 (Cache entries added during the scan are only appended and sorted once at the end)
+    nxtcBeginBatchAdd();
+
     // 获取需要扫描的目录名字
     std::vector<std::string> gamedirname = scanmodgamedir();
 
+    // 目录读取交给工作线程并行进行，这里按收藏优先的顺序逐个取结果
+    // Directory reads run in parallel on worker threads, results are taken here one by one in favorites-first order
+    tj::GameDirScanner dir_scanner;
+    dir_scanner.Start(gamedirname);
+
+    // 目录列表和game_name.json都没变时，先直接显示上次的扫描结果，下面的扫描只在原位校正
+    // When neither the directory list nor game_name.json changed, show the last scan result right away, the scan below
+    // only corrects it in place
+    const u64 snapshot_key = tj::CatalogSnapshot::ComputeKey(gamedirname, "/mods2/game_name.json");
+    std::unordered_map<std::string, size_t> snapshot_ids; // 目录名 -> unique_id (Directory name -> unique_id)
+    {
+        std::vector<tj::CatalogSnapshotEntry> snapshot_entries;
+        if (tj::CatalogSnapshot::Read(CATALOG_SNAPSHOT_PATH, snapshot_key, snapshot_entries) && !snapshot_entries.empty()) {
+            std::scoped_lock lock{entries_mutex};
+            this->entries.reserve(snapshot_entries.size());
+            for (auto& snapshot_entry : snapshot_entries) {
+                AppEntry entry;
+                entry.name = std::move(snapshot_entry.name);
+                entry.display_version = std::move(snapshot_entry.display_version);
+                entry.id = snapshot_entry.id;
+                entry.image = this->default_icon_image;
+                entry.own_image = false;
+                entry.FILE_NAME = std::move(snapshot_entry.FILE_NAME);
+                entry.FILE_NAME2 = std::move(snapshot_entry.FILE_NAME2);
+                entry.sort_key = tj::MakeCollationKey(entry.FILE_NAME2);
+                entry.FILE_PATH = std::move(snapshot_entry.FILE_PATH);
+                entry.MOD_VERSION = std::move(snapshot_entry.MOD_VERSION);
+                entry.MOD_TOTAL = std::move(snapshot_entry.MOD_TOTAL);
+                entry.unique_id = unique_id++;
+                entry.is_favorite = snapshot_entry.is_favorite;
+                snapshot_ids[snapshot_entry.dirname] = entry.unique_id;
+                this->entry_slots[entry.unique_id] = this->entries.size();
+                this->entries.emplace_back(std::move(entry));
+            }
+            // 立即切换到列表界面 (Switch to the list screen immediately)
+            scanned_count = this->entries.size();
+            initial_batch_loaded = true;
+        }
+    }
+
+    // 校正时新条目插入的位置，完整扫描时始终是列表末尾
+    // Where reconciled new entries are inserted, always the end of the list for a full scan
+    size_t insert_pos = 0;
+
     bool is_favorite = true;
 
     // 直接遍历gamedirname数组中的目录名
     // Directly iterate through directory names in gamedirname array
-    for (const std::string& dirname : gamedirname) {
+    for (size_t dir_index = 0; dir_index < gamedirname.size(); ++dir_index) {
+        const std::string& dirname = gamedirname[dir_index];
         if (stop_token.stop_requested()) {
-            avmExit();
-            nxtcExit();
             break;
         }
 
@@ -3059,18 +2969,39 @@ void App::FastScanNames(std::stop_token stop_token) {
         // Build full path for filename folder
         std::string filename_path = "/mods2/" + dirname;
         
-        // 获取当前filename目录下的modid和mod目录数量
-        // Get modid and mod directory count under current filename directory
-        std::pair<u64, std::string> modid_count_result = GetModIdAndSubdirCountStdio(filename_path);
+        // 获取当前filename目录下的modid和mod目录数量（由工作线程预先读取）
+        // Get modid and mod directory count under current filename directory (read ahead by the workers)
+        tj::GameDirScanResult scan_result;
+        if (!dir_scanner.Wait(dir_index, scan_result, stop_token)) {
+            continue; // 已请求停止，下一轮循环处理 (Stop requested, handled by the next iteration)
+        }
         
-        // 从返回的pair中提取application_id和mod目录数量字符串
-        // Extract application_id and mod directory count string from returned pair
-        u64 application_id = modid_count_result.first;
-        std::string mod_count = modid_count_result.second;
+        // 从扫描结果中提取application_id和mod目录数量字符串
+        // Extract application_id and mod directory count string from the scan result
+        u64 application_id = scan_result.application_id;
+        std::string mod_count = scan_result.mod_count;
         
         // 如果没有找到有效的modid，跳过当前目录
         // Skip current directory if no valid modid found
         if (application_id == 0 || mod_count == "0") {
+            // 快照中的条目已失效，从列表中移除 (The snapshot entry is no longer valid, remove it from the list)
+            auto snapshot_it = snapshot_ids.find(dirname);
+            if (snapshot_it != snapshot_ids.end()) {
+                std::scoped_lock lock{entries_mutex};
+                if (AppEntry* stale_entry = FindEntryByUniqueId(snapshot_it->second)) {
+                    // 图像和纹理缓存只能在界面线程释放 (The image and texture cache can only be released on the UI thread)
+                    bool own_image = stale_entry->own_image && stale_entry->image != this->default_icon_image;
+                    this->removed_entry_icons.emplace_back(stale_entry->unique_id, own_image ? stale_entry->image : 0);
+                    size_t erase_pos = stale_entry - this->entries.data();
+                    this->entry_slots.erase(stale_entry->unique_id);
+                    this->entries.erase(this->entries.begin() + erase_pos);
+                    ReindexEntrySlots(erase_pos);
+                    if (this->index > erase_pos || this->index >= this->entries.size()) {
+                        this->index = this->index > 0 ? this->index - 1 : 0;
+                    }
+                    scanned_count--;
+                }
+            }
             continue;
         }
 
@@ -3093,6 +3024,7 @@ void App::FastScanNames(std::stop_token stop_token) {
             entry.MOD_TOTAL = mod_count;
             entry.MOD_VERSION = MOD_VERSION;
             entry.FILE_NAME2 = GetMappedGameName(FILE_NAME, MOD_VERSION);
+            entry.sort_key = tj::MakeCollationKey(entry.FILE_NAME2);
             entry.unique_id = unique_id++;
             entry.is_favorite = is_favorite;
         }
@@ -3114,6 +3046,7 @@ void App::FastScanNames(std::stop_token stop_token) {
             entry.MOD_TOTAL = mod_count;
             entry.MOD_VERSION = MOD_VERSION;
             entry.FILE_NAME2 = GetMappedGameName(FILE_NAME, MOD_VERSION);
+            entry.sort_key = tj::MakeCollationKey(entry.FILE_NAME2);
             entry.unique_id = unique_id++;
             entry.is_favorite = is_favorite;
         }
@@ -3121,10 +3054,36 @@ void App::FastScanNames(std::stop_token stop_token) {
         // 加锁保护entries列表
         {
             std::scoped_lock lock{entries_mutex};
-            // 将应用条目添加到列表
-            this->entries.emplace_back(std::move(entry));
-            // 更新扫描计数器
-            scanned_count++;
+            auto snapshot_it = snapshot_ids.find(dirname);
+            AppEntry* it = snapshot_it == snapshot_ids.end() ? nullptr : FindEntryByUniqueId(snapshot_it->second);
+
+            if (it) {
+                // 快照条目原位更新，保留unique_id和已加载的图标，收藏和映射名可能已被用户修改，不覆盖
+                // Update the snapshot entry in place, keeping its unique_id and loaded icon; favorite and mapped name may
+                // have been changed by the user meanwhile, leave them alone
+                it->name = std::move(entry.name);
+                it->display_version = std::move(entry.display_version);
+                it->id = entry.id;
+                it->MOD_TOTAL = std::move(entry.MOD_TOTAL);
+                it->cached_icon_data = std::move(entry.cached_icon_data);
+                it->has_cached_icon = entry.has_cached_icon;
+                entry.unique_id = it->unique_id;
+                insert_pos = (it - this->entries.data()) + 1;
+                if (it->has_cached_icon && it->image == this->default_icon_image) {
+                    icon_range_stale = true;
+                }
+            } else {
+                // 将应用条目添加到列表
+                insert_pos = snapshot_ids.empty() ? this->entries.size() : std::min(insert_pos, this->entries.size());
+                this->entries.emplace(this->entries.begin() + insert_pos, std::move(entry));
+                ReindexEntrySlots(insert_pos);
+                if (!snapshot_ids.empty() && this->index >= insert_pos && this->index + 1 < this->entries.size()) {
+                    this->index++;
+                }
+                insert_pos++;
+                // 更新扫描计数器
+                scanned_count++;
+            }
             count++;
         }
 
@@ -3137,47 +3096,8 @@ void App::FastScanNames(std::stop_token stop_token) {
             icon_task.submit_time = std::chrono::steady_clock::now();
             icon_task.task_type = ResourceTaskType::ICON;
             
-            icon_task.load_callback = [this, unique_id = entry.unique_id]() {
-                std::vector<unsigned char> icon_data;
-                bool has_icon_data = false;
-                
-                // 获取缓存的图标数据
-                // Get cached icon data
-                {
-                    std::scoped_lock lock{entries_mutex};
-                    auto it = std::find_if(entries.begin(), entries.end(),
-                        [unique_id](const AppEntry& entry) {
-                            return entry.unique_id == unique_id && entry.has_cached_icon;
-                        });
-                    
-                    if (it != entries.end()) {
-                        icon_data = it->cached_icon_data;
-                        has_icon_data = true;
-                    }
-                }
-                
-                // 验证并创建图像
-                // Validate and create image
-                if (has_icon_data && !icon_data.empty() && IsValidJpegData(icon_data)) {
-                    int image_id = nvgCreateImageMem(this->vg, 0, icon_data.data(), icon_data.size());
-                    if (image_id > 0) {
-                        std::scoped_lock lock{entries_mutex};
-                        auto it = std::find_if(entries.begin(), entries.end(),
-                            [unique_id](const AppEntry& entry) {
-                                return entry.unique_id == unique_id;
-                            });
-                        
-                        if (it != entries.end()) {
-                            // 如果之前有自己的图像，先删除
-                            // If previously had own image, delete it first
-                            if (it->own_image && it->image != this->default_icon_image) {
-                                nvgDeleteImage(this->vg, it->image);
-                            }
-                            it->image = image_id;
-                            it->own_image = true;
-                        }
-                    }
-                }
+            icon_task.load_callback = [this, unique_id = entry.unique_id, priority = icon_task.priority]() {
+                this->LoadEntryIcon(unique_id, priority);
             };
             
             resource_manager.submitLoadTask(icon_task);
@@ -3189,15 +3109,47 @@ void App::FastScanNames(std::stop_token stop_token) {
             initial_batch_loaded = true;
         }
 
-        //线程休息1ms避免卡死（比原来更快）
-        svcSleepThread(1000000ULL);
+        // 让出CPU给界面线程，避免卡死；目录读取已在工作线程完成，不再固定休眠1ms
+        // Yield the CPU to the UI thread to avoid stalls; directory reads already happen on the workers, so no fixed 1ms sleep
+        svcSleepThread(YieldType_ToAnyThread);
+    }
+
+    dir_scanner.Stop();
+
+    // 完整扫描结束后保存快照，供下次启动直接显示 (Save the snapshot after a complete scan for the next startup)
+    if (!stop_token.stop_requested()) {
+        std::vector<tj::CatalogSnapshotEntry> snapshot_entries;
+        {
+            std::scoped_lock lock{entries_mutex};
+            snapshot_entries.reserve(this->entries.size());
+            for (const auto& app_entry : this->entries) {
+                tj::CatalogSnapshotEntry snapshot_entry;
+                // FILE_PATH格式为/mods2/<目录名>/<modid> (FILE_PATH is /mods2/<dirname>/<modid>)
+                size_t dir_begin = sizeof("/mods2/") - 1;
+                size_t dir_end = app_entry.FILE_PATH.find('/', dir_begin);
+                snapshot_entry.dirname = app_entry.FILE_PATH.substr(dir_begin, dir_end - dir_begin);
+                snapshot_entry.name = app_entry.name;
+                snapshot_entry.display_version = app_entry.display_version;
+                snapshot_entry.FILE_NAME = app_entry.FILE_NAME;
+                snapshot_entry.FILE_NAME2 = app_entry.FILE_NAME2;
+                snapshot_entry.FILE_PATH = app_entry.FILE_PATH;
+                snapshot_entry.MOD_VERSION = app_entry.MOD_VERSION;
+                snapshot_entry.MOD_TOTAL = app_entry.MOD_TOTAL;
+                snapshot_entry.id = app_entry.id;
+                snapshot_entry.is_favorite = app_entry.is_favorite;
+                snapshot_entries.push_back(std::move(snapshot_entry));
+            }
+        }
+        tj::CatalogSnapshot::Write(CATALOG_SNAPSHOT_PATH, snapshot_key, snapshot_entries);
     }
 
 done:
     // 标记扫描结束
     is_scan_running = false;
 
-    // 刷新缓存文件
+    // 排序扫描期间新增的缓存条目并刷新缓存文件
+    // Sort the cache entries added during the scan and flush the cache file
+    nxtcCommitBatchAdd();
     nxtcFlushCacheFile();
 
     // 退出libnxtc库
@@ -3243,18 +3195,20 @@ void App::FastScanAllGames(std::stop_token stop_token) {
 
     Result rc = avmInitialize();
     if (R_FAILED(rc)) {
+        nxtcExit();
         addgame_scan_running = false;
         return; // AVM服务初始化失败，直接返回 (AVM service initialization failed, return directly)
     }
 
+    // 扫描期间新增的缓存条目只追加，结束时统一排序一次 (Cache entries added during the scan are only appended and sorted once at the end)
+    nxtcBeginBatchAdd();
+
     size_t count = 0;
     
     // 遍历所有应用ID
     // Iterate through all application IDs
     for (u64 application_id : app_ids) {
         if (stop_token.stop_requested()) {
-            avmExit();
-            nxtcExit();
             break; // 如果请求停止，退出循环 (If stop requested, exit loop)
         }
 
@@ -3270,6 +3224,7 @@ void App::FastScanAllGames(std::stop_token stop_token) {
             // Failed to get info, mark as corrupted installation
             is_corrupted = true;
             entry.name = "Unknown Game";
+            entry.sort_key = tj::MakeCollationKey(entry.name);
             entry.id = application_id;
             entry.display_version = "Unknown";
             entry.image = this->default_icon_image;
@@ -3288,6 +3243,7 @@ void App::FastScanAllGames(std::stop_token stop_token) {
             std::scoped_lock lock{entries_AddGame_mutex};
             // 将应用条目添加到列表
             // Add application entry to list
+            this->addgame_entry_slots[entry.unique_id] = this->entries_AddGame.size();
             this->entries_AddGame.emplace_back(entry);
             count++;
         }
@@ -3305,47 +3261,8 @@ void App::FastScanAllGames(std::stop_token stop_token) {
             icon_task.submit_time = std::chrono::steady_clock::now();
             icon_task.task_type = ResourceTaskType::ICON;
             
-            icon_task.load_callback = [this, unique_id = entry.unique_id]() {
-                std::vector<unsigned char> icon_data;
-                bool has_icon_data = false;
-                
-                // 获取缓存的图标数据
-                // Get cached icon data
-                {
-                    std::scoped_lock lock{entries_AddGame_mutex};
-                    auto it = std::find_if(entries_AddGame.begin(), entries_AddGame.end(),
-                        [unique_id](const AppEntry_AddGame& entry) {
-                            return entry.unique_id == unique_id && entry.has_cached_icon;
-                        });
-                    
-                    if (it != entries_AddGame.end()) {
-                        icon_data = it->cached_icon_data;
-                        has_icon_data = true;
-                    }
-                }
-                
-                // 验证并创建图像
-                // Validate and create image
-                if (has_icon_data && !icon_data.empty() && IsValidJpegData(icon_data)) {
-                    int image_id = nvgCreateImageMem(this->vg, 0, icon_data.data(), icon_data.size());
-                    if (image_id > 0) {
-                        std::scoped_lock lock{entries_AddGame_mutex};
-                        auto it = std::find_if(entries_AddGame.begin(), entries_AddGame.end(),
-                            [unique_id](const AppEntry_AddGame& entry) {
-                                return entry.unique_id == unique_id;
-                            });
-                        
-                        if (it != entries_AddGame.end()) {
-                            // 如果之前有自己的图像，先删除
-                            // If previously had own image, delete it first
-                            if (it->own_image && it->image != this->default_icon_image) {
-                                nvgDeleteImage(this->vg, it->image);
-                            }
-                            it->image = image_id;
-                            it->own_image = true;
-                        }
-                    }
-                }
+            icon_task.load_callback = [this, unique_id = entry.unique_id, priority = icon_task.priority]() {
+                this->LoadAddGameEntryIcon(unique_id, priority);
             };
             
             resource_manager.submitLoadTask(icon_task);
@@ -3356,7 +3273,9 @@ void App::FastScanAllGames(std::stop_token stop_token) {
         svcSleepThread(1000000ULL);
     }
     
-    // 刷新缓存文件
+    // 排序扫描期间新增的缓存条目并刷新缓存文件
+    // Sort the cache entries added during the scan and flush the cache file
+    nxtcCommitBatchAdd();
     nxtcFlushCacheFile();
     // 退出libnxtc库
     // Exit libnxtc library
@@ -3391,6 +3310,198 @@ std::pair<size_t, size_t> App::GetVisibleRange() const {
 // 获取列表界面的可见范围 (Get visible range for list interface)
 
 
+// 按unique_id查找条目：槽位表随列表的插入、删除和排序同步更新，查不到说明条目已被移除，调用方需持有对应的锁
+// Find an entry by unique_id: the slot table is kept in step with inserts, erases and sorts, so a miss means the entry
+// was removed; the caller must hold the matching lock
+template <typename Entry>
+static Entry* FindEntryBySlot(std::vector<Entry>& list, const std::unordered_map<size_t, size_t>& slots, size_t unique_id) {
+    auto it = slots.find(unique_id);
+    if (it != slots.end() && it->second < list.size() && list[it->second].unique_id == unique_id) {
+        return &list[it->second];
+    }
+    return nullptr;
+}
+
+// 重新记录from之后每个元素的下标，与vector插入、删除本身移动元素的开销同阶 (Record the index of every element from
+// from onwards again, the same order of cost as the vector insert or erase that moved them)
+template <typename Entry>
+static void ReindexSlots(const std::vector<Entry>& list, std::unordered_map<size_t, size_t>& slots, size_t from) {
+    if (from == 0) {
+        slots.clear();
+        slots.reserve(list.size());
+    }
+    for (size_t i = from; i < list.size(); ++i) {
+        slots[list[i].unique_id] = i;
+    }
+}
+
+AppEntry* App::FindEntryByUniqueId(size_t unique_id) {
+    return FindEntryBySlot(this->entries, this->entry_slots, unique_id);
+}
+
+AppEntry_AddGame* App::FindAddGameEntryByUniqueId(size_t unique_id) {
+    return FindEntryBySlot(this->entries_AddGame, this->addgame_entry_slots, unique_id);
+}
+
+void App::ReindexEntrySlots(size_t from) {
+    ReindexSlots(this->entries, this->entry_slots, from);
+}
+
+void App::ReindexAddGameEntrySlots(size_t from) {
+    ReindexSlots(this->entries_AddGame, this->addgame_entry_slots, from);
+}
+
+// 图标加载任务：锁内只取出图标数据的共享引用，交给后台解码器，界面线程不做JPEG解码
+// Icon load task: only a shared reference to the icon data is taken under the lock and handed to the background
+// decoder, the UI thread does no JPEG decoding
+template <typename Entry>
+void App::RequestIconDecode(std::mutex& list_mutex, Entry* (App::*find_entry)(size_t), bool is_addgame, size_t unique_id, int priority) {
+    tj::IconDataPtr icon_data;
+    {
+        std::scoped_lock lock{list_mutex};
+        Entry* entry = (this->*find_entry)(unique_id);
+        if (entry && entry->has_cached_icon) {
+            icon_data = entry->cached_icon_data;
+        }
+    }
+
+    // 没有可用的图标数据，直接返回；JPEG校验在解码线程读取图标后进行
+    // (No usable icon data, return directly; the JPEG check runs on the decoder thread once the icon is read)
+    if (!icon_data || icon_data->empty()) {
+        return;
+    }
+
+    this->icon_decoder.Submit(unique_id, is_addgame, std::move(icon_data), priority);
+}
+
+// 把上传好的纹理交给条目，条目已有图像或已被移除时返回false
+// Attach an uploaded texture to its entry, returns false if the entry already has an image or was removed
+template <typename Entry>
+bool App::AttachIconImage(std::mutex& list_mutex, Entry* (App::*find_entry)(size_t), const tj::DecodedIcon& icon) {
+    Entry* entry = nullptr;
+    {
+        std::scoped_lock lock{list_mutex};
+        entry = (this->*find_entry)(icon.unique_id);
+        if (!entry || (entry->own_image && entry->image != this->default_icon_image)) {
+            return false;
+        }
+    }
+
+    int image_id = nvgCreateImageRGBA(this->vg, icon.width, icon.height, 0, icon.pixels.get());
+    if (image_id <= 0) {
+        return false;
+    }
+
+    tj::IconDataPtr icon_data;
+    {
+        std::scoped_lock lock{list_mutex};
+        entry = (this->*find_entry)(icon.unique_id);
+        if (!entry) {
+            nvgDeleteImage(this->vg, image_id); // 条目已被移除 (Entry was removed meanwhile)
+            return false;
+        }
+
+        // 如果之前有自己的图像，先删除
+        // If previously had own image, delete it first
+        if (entry->own_image && entry->image != this->default_icon_image) {
+            nvgDeleteImage(this->vg, entry->image);
+        }
+        entry->image = image_id;
+        entry->own_image = true;
+        icon_data = entry->cached_icon_data;
+    }
+
+    // 纹理已上传，不再保留JPEG字节，纹理被淘汰后从标题缓存文件重新读取
+    // (The texture is uploaded, so the JPEG bytes aren't kept, they are read again from the title cache file once the
+    // texture is evicted)
+    if (icon_data) {
+        icon_data->Unload();
+    }
+    return true;
+}
+
+void App::LoadEntryIcon(size_t unique_id, int priority) {
+    RequestIconDecode<AppEntry>(entries_mutex, &App::FindEntryByUniqueId, false, unique_id, priority);
+}
+
+void App::LoadAddGameEntryIcon(size_t unique_id, int priority) {
+    RequestIconDecode<AppEntry_AddGame>(entries_AddGame_mutex, &App::FindAddGameEntryByUniqueId, true, unique_id, priority);
+}
+
+// 每帧上传解码好的图标，受时间预算限制，至少上传一个以保证进度
+// Upload decoded icons every frame within a time budget, always at least one so loading keeps progressing
+void App::UploadDecodedIcons() {
+    ReleaseRemovedEntryIcons();
+
+    const auto upload_start = std::chrono::steady_clock::now();
+    std::vector<size_t> evicted;
+
+    tj::DecodedIcon icon;
+    while (this->icon_decoder.PopDecoded(icon)) {
+        if (icon.pixels) {
+            if (icon.is_addgame) {
+                // 添加游戏界面退出时整体释放图标，不经过纹理缓存 (The AddGame list frees all icons on exit, it bypasses the texture cache)
+                if (AttachIconImage<AppEntry_AddGame>(entries_AddGame_mutex, &App::FindAddGameEntryByUniqueId, icon)) {
+                    this->frame_scheduler.MarkDirty();
+                }
+            } else if (AttachIconImage<AppEntry>(entries_mutex, &App::FindEntryByUniqueId, icon)) {
+                this->icon_cache.Insert(icon.unique_id, static_cast<size_t>(icon.width) * icon.height * 4, evicted);
+                this->frame_scheduler.MarkDirty();
+            }
+        }
+
+        if (std::chrono::steady_clock::now() - upload_start >= ICON_UPLOAD_BUDGET) {
+            break;
+        }
+    }
+
+    ReleaseEvictedIcons(evicted);
+}
+
+// 删除扫描线程移除的条目的图像并移出纹理缓存 (Delete images of entries removed by the scan thread and drop them from the texture cache)
+void App::ReleaseRemovedEntryIcons() {
+    std::vector<std::pair<size_t, int>> removed;
+    {
+        std::scoped_lock lock{entries_mutex};
+        if (this->removed_entry_icons.empty()) {
+            return;
+        }
+        removed.swap(this->removed_entry_icons);
+    }
+
+    for (const auto& [removed_id, image] : removed) {
+        if (image > 0) {
+            nvgDeleteImage(this->vg, image);
+        }
+        this->icon_cache.Erase(removed_id);
+    }
+    this->frame_scheduler.MarkDirty();
+}
+
+// 删除被纹理缓存淘汰的图像，条目恢复默认图标，再次可见时从cached_icon_data重新读取并解码
+// Delete images evicted by the texture cache and restore the default icon, they are read again through cached_icon_data
+// and decoded when the entries become visible again
+void App::ReleaseEvictedIcons(const std::vector<size_t>& evicted) {
+    if (evicted.empty()) {
+        return;
+    }
+
+    std::scoped_lock lock{entries_mutex};
+    for (size_t evicted_id : evicted) {
+        AppEntry* entry = FindEntryByUniqueId(evicted_id);
+        if (entry && entry->own_image && entry->image != this->default_icon_image) {
+            nvgDeleteImage(this->vg, entry->image);
+            entry->image = this->default_icon_image;
+            entry->own_image = false;
+        }
+    }
+
+    const auto& stats = this->icon_cache.GetStats();
+    LOG("icon cache: hits %llu misses %llu evictions %llu resident %zu (%zu bytes)\n",
+        (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.evictions,
+        stats.resident_count, stats.resident_bytes);
+}
+
 // 基于视口的智能图标加载：根据光标位置优先加载可见区域的图标
 // Viewport-aware smart icon loading: prioritize loading icons in visible area based on cursor position
 
@@ -3416,6 +3527,11 @@ void App::LoadVisibleAreaIcons() {
     
     auto [visible_start, visible_end] = GetVisibleRange();
     
+    // 后台校正补上了图标数据时强制重新加载 (Force a reload when the background reconcile filled in icon data)
+    if (icon_range_stale.exchange(false)) {
+        last_loaded_range = {SIZE_MAX, SIZE_MAX};
+    }
+    
     // 如果可见区域没有变化且不是强制重置状态，则跳过
     // Skip if visible range hasn't changed and not in force reset state
     if (last_loaded_range.first == visible_start && last_loaded_range.second == visible_end && 
@@ -3457,9 +3573,13 @@ void App::LoadVisibleAreaIcons() {
             
             // 优化：同时检查图标状态和损坏状态，减少后续处理
             // Optimization: check both icon status and corruption status to reduce subsequent processing
-            if (entry.image == this->default_icon_image && entry.display_version != NONE_GAME_TEXT) {
+            if (entry.own_image && entry.image != this->default_icon_image) {
+                // 纹理仍在缓存中，回滚到这里无需重新解码 (Texture is still cached, scrolling back needs no decode)
+                this->icon_cache.Touch(entry.unique_id);
+            } else if (entry.image == this->default_icon_image && entry.display_version != NONE_GAME_TEXT) {
                 LoadInfo info;
                 info.unique_id = entry.unique_id;  // 使用unique_id替代application_id (Use unique_id instead of application_id)
+                this->icon_cache.RecordMiss();
                 
                 // 优先级策略：首屏4个应用最高优先级(0)，当前可见区域次高优先级(1)，其他为低优先级(2)
                 // Priority strategy: first screen 4 apps highest priority(0), current visible area medium priority(1), others low priority(2)
@@ -3494,54 +3614,8 @@ void App::LoadVisibleAreaIcons() {
         icon_task.submit_time = std::chrono::steady_clock::now();
         icon_task.task_type = ResourceTaskType::ICON; // 标记为图标任务 (Mark as icon task)
         
-        icon_task.load_callback = [this, unique_id = info.unique_id]() {
-            // 获取图标数据
-            // Get icon data
-            std::vector<unsigned char> icon_data;
-            bool has_icon_data = false;
-            
-            // 优先使用AppEntry中缓存的图标数据，避免重复的缓存读取
-            // Prioritize using cached icon data in AppEntry to avoid repeated cache reads
-            {
-                std::scoped_lock lock{entries_mutex};
-                auto it = std::find_if(entries.begin(), entries.end(),
-                    [unique_id](const AppEntry& entry) {
-                        return entry.unique_id == unique_id && entry.has_cached_icon;  // 使用unique_id替代application_id (Use unique_id instead of application_id)
-                    });
-                
-                if (it != entries.end()) {
-                    icon_data = it->cached_icon_data;
-                    has_icon_data = true;
-                }
-            }
-            
-            
-             if (!has_icon_data) {
-                 return; // 没有可用的图标数据，直接返回
-             }
-            
-            // 验证并创建图像
-            // Validate and create image
-            if (has_icon_data && !icon_data.empty() && IsValidJpegData(icon_data)) {
-                int image_id = nvgCreateImageMem(this->vg, 0, icon_data.data(), icon_data.size());
-                if (image_id > 0) {
-                    std::scoped_lock lock{entries_mutex};
-                    auto it = std::find_if(entries.begin(), entries.end(),
-                        [unique_id](const AppEntry& entry) {
-                            return entry.unique_id == unique_id;  // 使用unique_id替代application_id (Use unique_id instead of application_id)
-                        });
-                    
-                    if (it != entries.end()) {
-                        // 如果之前有自己的图像，先删除
-                        // If previously had own image, delete it first
-                        if (it->own_image && it->image != this->default_icon_image) {
-                            nvgDeleteImage(this->vg, it->image);
-                        }
-                        it->image = image_id;
-                        it->own_image = true;
-                    }
-                }
-            }
+        icon_task.load_callback = [this, unique_id = info.unique_id, priority = icon_task.priority]() {
+            this->LoadEntryIcon(unique_id, priority);
         };
         
         this->resource_manager.submitLoadTask(icon_task);
@@ -3664,54 +3738,8 @@ void App::LoadAddGameVisibleAreaIcons() {
         icon_task.submit_time = std::chrono::steady_clock::now();
         icon_task.task_type = ResourceTaskType::ICON; // 标记为图标任务 (Mark as icon task)
         
-        icon_task.load_callback = [this, unique_id = info.unique_id]() {
-            // 获取图标数据
-            // Get icon data
-            std::vector<unsigned char> icon_data;
-            bool has_icon_data = false;
-            
-            // 优先使用AppEntry_AddGame中缓存的图标数据，避免重复的缓存读取
-            // Prioritize using cached icon data in AppEntry_AddGame to avoid repeated cache reads
-            {
-                std::scoped_lock lock{entries_AddGame_mutex};
-                auto it = std::find_if(entries_AddGame.begin(), entries_AddGame.end(),
-                    [unique_id](const AppEntry_AddGame& entry) {
-                        return entry.unique_id == unique_id && entry.has_cached_icon;  // 使用unique_id替代application_id (Use unique_id instead of application_id)
-                    });
-                
-                if (it != entries_AddGame.end()) {
-                    icon_data = it->cached_icon_data;
-                    has_icon_data = true;
-                }
-            }
-            
-            
-             if (!has_icon_data) {
-                 return; // 没有可用的图标数据，直接返回
-             }
-            
-            // 验证并创建图像
-            // Validate and create image
-            if (has_icon_data && !icon_data.empty() && IsValidJpegData(icon_data)) {
-                int image_id = nvgCreateImageMem(this->vg, 0, icon_data.data(), icon_data.size());
-                if (image_id > 0) {
-                    std::scoped_lock lock{entries_AddGame_mutex};
-                    auto it = std::find_if(entries_AddGame.begin(), entries_AddGame.end(),
-                        [unique_id](const AppEntry_AddGame& entry) {
-                            return entry.unique_id == unique_id;  // 使用unique_id替代application_id (Use unique_id instead of application_id)
-                        });
-                    
-                    if (it != entries_AddGame.end()) {
-                        // 如果之前有自己的图像，先删除
-                        // If previously had own image, delete it first
-                        if (it->own_image && it->image != this->default_icon_image) {
-                            nvgDeleteImage(this->vg, it->image);
-                        }
-                        it->image = image_id;
-                        it->own_image = true;
-                    }
-                }
-            }
+        icon_task.load_callback = [this, unique_id = info.unique_id, priority = icon_task.priority]() {
+            this->LoadAddGameEntryIcon(unique_id, priority);
         };
         
         this->resource_manager.submitLoadTask(icon_task);
@@ -3723,6 +3751,9 @@ App::App() {
 
     CheckMods2Path();
 
+    // 上次安装中途崩溃或断电时，按安装日志删除残留文件 (If the last install was cut off by a crash or power loss, remove its leftovers from the install journal)
+    this->mod_manager.RecoverInterruptedInstall();
+
     // 使用封装后的方法自动加载系统语言
     // Automatically load the system language using lang_manager
     tj::LangManager::getInstance().loadSystemLanguage();
@@ -3814,6 +3845,13 @@ App::App() {
     // 这样可以显著提升应用启动速度 (This significantly improves app startup speed)
 
 
+    // 以按需加载模式打开标题缓存，由应用持有一份引用直到退出；启动时只读取缓存文件头和条目表，
+    // 图标在解码时才读取。扫描线程中的初始化只会增加引用计数
+    // Open the title cache in lazy load mode and hold a reference to it until the app exits; only the cache file
+    // header and entry table are read at startup, icons are read when they're decoded. Initialization in the scan
+    // threads only bumps the reference count
+    nxtcInitializeLazy();
+
     // 启动快速信息扫描
     // Start fast info scanning
     this->async_thread = util::async([this](std::stop_token stop_token){
@@ -4095,137 +4133,15 @@ void App::FilterSearchResults(const std::string& search_text) {
     std::string search_lower = search_text;
     std::transform(search_lower.begin(), search_lower.end(), search_lower.begin(), ::tolower);
     
-    for (size_t idx = 0; idx < search_context.size(); ++idx) {
-        // 使用search_context中的字符串作为搜索目标 (Use string from search_context as search target)
-        const std::string& mapped_name = search_context[idx];
-        bool matched = false;
-        
-        // 1. 直接匹配原始名称 (Direct match with original name)
-        std::string name_lower = mapped_name;
-        std::transform(name_lower.begin(), name_lower.end(), name_lower.begin(), ::tolower);
-        if (name_lower.find(search_lower) != std::string::npos) {
-            matched = true;
-        }
-        
-        // 2. 拼音匹配：将中文转换为拼音进行匹配，支持多音字 (Pinyin matching: convert Chinese to pinyin for matching, support polyphonic characters)
-        if (!matched) {
-            // 存储所有可能的拼音组合 (Store all possible pinyin combinations)
-            std::vector<std::string> all_pinyin_combinations;
-            std::vector<std::string> all_initial_combinations;
-            
-            // 解析字符串中的每个字符，收集所有可能的拼音 (Parse each character in string, collect all possible pinyins)
-            std::vector<std::vector<std::string>> char_pinyins; // 每个字符的所有拼音 (All pinyins for each character)
-            std::vector<std::vector<char>> char_initials; // 每个字符的所有首字母 (All initials for each character)
-            
-            const char* str = mapped_name.c_str();
-            size_t len = mapped_name.length();
-            size_t i = 0;
-            
-            while (i < len) {
-                wchar_t ch = 0;
-                // 解析UTF-8字符 (Parse UTF-8 character)
-                if ((str[i] & 0x80) == 0) {
-                    // ASCII字符 (ASCII character)
-                    ch = str[i];
-                    i++;
-                } else if ((str[i] & 0xE0) == 0xC0 && i + 1 < len) {
-                    // 2字节UTF-8字符 (2-byte UTF-8 character)
-                    ch = ((str[i] & 0x1F) << 6) | (str[i + 1] & 0x3F);
-                    i += 2;
-                } else if ((str[i] & 0xF0) == 0xE0 && i + 2 < len) {
-                    // 3字节UTF-8字符 (3-byte UTF-8 character)
-                    ch = ((str[i] & 0x0F) << 12) | ((str[i + 1] & 0x3F) << 6) | (str[i + 2] & 0x3F);
-                    i += 3;
-                } else {
-                    // 跳过无效字符 (Skip invalid character)
-                    i++;
-                    continue;
-                }
-                
-                if (WzhePinYin::Pinyin::IsChinese(ch)) {
-                    // 获取中文字符的所有拼音 (Get all pinyins for Chinese character)
-                    auto pinyins = WzhePinYin::Pinyin::GetPinyins(ch);
-                    if (!pinyins.empty()) {
-                        std::vector<std::string> current_pinyins;
-                        std::vector<char> current_initials;
-                        
-                        // 处理所有拼音读音 (Process all pinyin pronunciations)
-                        for (const auto& py : pinyins) {
-                            std::string processed_py = py;
-                            std::transform(processed_py.begin(), processed_py.end(), processed_py.begin(), ::tolower);
-                            current_pinyins.push_back(processed_py);
-                            if (!processed_py.empty()) {
-                                current_initials.push_back(processed_py[0]);
-                            }
-                        }
-                        
-                        char_pinyins.push_back(current_pinyins);
-                        char_initials.push_back(current_initials);
-                    }
-                } else {
-                    // 非中文字符：忽略标点符号，只添加字母和数字 (Non-Chinese characters: ignore punctuation, only add letters and numbers)
-                    if (ch < 128) { // 只处理ASCII字符 (Only handle ASCII characters)
-                        char ascii_ch = static_cast<char>(ch);
-                        if (std::isalnum(ascii_ch)) { // 只添加字母和数字，忽略标点符号 (Only add alphanumeric, ignore punctuation)
-                            char_pinyins.push_back({std::string(1, ascii_ch)});
-                            char_initials.push_back({ascii_ch});
-                        }
-                    }
-                }
-            }
-            
-            // 生成所有可能的拼音组合 (Generate all possible pinyin combinations)
-            std::function<void(size_t, std::string, std::string)> generate_combinations = 
-                [&](size_t pos, std::string current_full, std::string current_initials) {
-                    if (pos >= char_pinyins.size()) {
-                        if (!current_full.empty()) {
-                            all_pinyin_combinations.push_back(current_full);
-                        }
-                        if (!current_initials.empty()) {
-                            all_initial_combinations.push_back(current_initials);
-                        }
-                        return;
-                    }
-                    
-                    // 为当前位置的每个拼音生成组合 (Generate combinations for each pinyin at current position)
-                    for (size_t j = 0; j < char_pinyins[pos].size(); ++j) {
-                        std::string new_full = current_full + char_pinyins[pos][j];
-                        std::string new_initials = current_initials;
-                        if (j < char_initials[pos].size()) {
-                            new_initials += char_initials[pos][j];
-                        }
-                        generate_combinations(pos + 1, new_full, new_initials);
-                    }
-                };
-            
-            generate_combinations(0, "", "");
-            
-            // 检查所有拼音组合是否匹配 (Check if any pinyin combination matches)
-            for (const auto& pinyin_combo : all_pinyin_combinations) {
-                if (pinyin_combo.find(search_lower) != std::string::npos) {
-                    matched = true;
-                    break;
-                }
-            }
-            
-            // 如果完整拼音没匹配，检查首字母组合 (If full pinyin doesn't match, check initial combinations)
-            if (!matched) {
-                for (const auto& initial_combo : all_initial_combinations) {
-                    if (initial_combo.find(search_lower) != std::string::npos) {
-                        matched = true;
-                        break;
-                    }
-                }
-            }
-        }
-        
-        // 如果匹配成功，添加字符串和索引到结果中 (If matched, add string and index to results)
-        if (matched) {
-            search_results.emplace_back(mapped_name, idx);  // 直接存储字符串结果和整数索引 (Directly store string result and integer index)
-            // 限制最多显示6个结果 (Limit to maximum 6 results)
-            if (search_results.size() >= 6) {
-                break;
-            }
+    // 使用预构建的拼音索引匹配原始名称、全拼和首字母，支持多音字 (Match original name, full pinyin and initials through the prebuilt index, with polyphonic support)
+    const std::vector<uint32_t>& matched_indices = search_index.Query(search_lower);
+    
+    for (uint32_t idx : matched_indices) {
+        // 直接存储字符串结果和整数索引 (Directly store string result and integer index)
+        search_results.emplace_back(search_context[idx], idx);
+        // 限制最多显示6个结果 (Limit to maximum 6 results)
+        if (search_results.size() >= 6) {
+            break;
         }
     }
     
@@ -4245,10 +4161,11 @@ void App::clearaddgamelist() {
                 entry.own_image = false;
             }
             // 清理缓存的图标数据 (Clear cached icon data)
-            entry.cached_icon_data.clear();
+            entry.cached_icon_data.reset();
             entry.has_cached_icon = false;
         }
         this->entries_AddGame.clear(); // 清空列表 (Clear the list)
+        this->addgame_entry_slots.clear();
     }
     
     // 重置所有AddGame相关状态 (Reset all AddGame related states)
@@ -4570,6 +4487,7 @@ void App::changemodname(){
     if (!JsonManager::UpdateNestedJsonKeyValue(json_path, root_key, "display_name", mod_name)) return;
   
     this->mod_info[this->mod_index].MOD_NAME2 = mod_name;
+    this->mod_info[this->mod_index].sort_key = tj::MakeCollationKey(mod_name);
     this->audio_manager.PlayConfirmSound(1.0);
  
 }
@@ -4632,10 +4550,9 @@ void App::tofavorite(){
     {
         std::scoped_lock lock{entries_mutex};
         this->entries[this->index].is_favorite = true;
+        Sort();
     }
 
-    Sort();
-
 }
 
 void App::notfavorite(){
@@ -4662,10 +4579,9 @@ void App::notfavorite(){
     {
         std::scoped_lock lock{entries_mutex};
         this->entries[this->index].is_favorite = false;
+        Sort();
     }
 
-    Sort();
-
 
 }
 
@@ -4696,7 +4612,15 @@ void App::RemoveGame(){
     {
         std::scoped_lock lock{entries_mutex};
         if (this->index < this->entries.size()) {
+            // 释放该游戏的图标纹理 (Release the game's icon texture)
+            AppEntry& removed_entry = this->entries[this->index];
+            if (removed_entry.own_image && removed_entry.image != this->default_icon_image) {
+                nvgDeleteImage(this->vg, removed_entry.image);
+            }
+            this->icon_cache.Erase(removed_entry.unique_id);
+            this->entry_slots.erase(removed_entry.unique_id);
             this->entries.erase(this->entries.begin() + this->index);
+            ReindexEntrySlots(this->index);
             // 如果删除的是最后一个元素，调整索引
             if (this->index >= this->entries.size() && this->index > 0) {
                 this->index--;
@@ -4880,6 +4804,7 @@ void App::changegamename() {
     {
         std::scoped_lock lock{entries_mutex};
         this->entries[this->index].FILE_NAME2 = name;
+        this->entries[this->index].sort_key = tj::MakeCollationKey(name);
     }
     this->audio_manager.PlayConfirmSound(1.0);
 
@@ -4939,6 +4864,9 @@ void App::Dialog_MODLIST_TYPE_Menu(const std::string& type) {
 
     if (rename(old_mod_path.c_str(), new_mod_path.c_str()) != 0) return;
 
+    // 安装清单以MOD目录名命名，随目录一起改名 (The install manifest is named after the MOD directory, rename it along)
+    this->mod_manager.RenameInstalledFiles(old_mod_path, new_mod_path);
+
     std::string old_root_key = GetModDirName();
 
     std::string new_root_key = MOD_NAME + mod_type;
@@ -5041,6 +4969,7 @@ void App::Dialog_APPENDMOD_Menu(const std::vector<std::string>& selected_items)
             MODINFO mod_info2;
             mod_info2.MOD_NAME = new_dir_name;
             mod_info2.MOD_NAME2 = new_dir_name;
+            mod_info2.sort_key = tj::MakeCollationKey(new_dir_name);
             mod_info2.MOD_PATH = new_dir_path;
             mod_info2.MOD_TYPE = NONE_TYPE_TEXT;
             mod_info2.MOD_STATE = false;
@@ -5088,7 +5017,7 @@ void App::Dialog_ADDGAME_Menu(const std::vector<std::string>& selected_items) {
     u64 application_id;
     std::string name;
     std::string display_version;
-    std::vector<unsigned char> cached_icon_data;
+    tj::IconDataPtr cached_icon_data;
     bool has_cached_icon;
 
     {
@@ -5254,6 +5183,7 @@ void App::Dialog_ADDGAME_Menu(const std::vector<std::string>& selected_items) {
         app_entry.has_cached_icon = has_cached_icon;
         app_entry.FILE_NAME = app_english_name;
         app_entry.FILE_NAME2 = name;
+        app_entry.sort_key = tj::MakeCollationKey(name);
         app_entry.FILE_PATH = game_name_id_path;
         app_entry.MOD_VERSION = NONE_TYPE_TEXT;
         app_entry.MOD_TOTAL = std::to_string(successfully_added_mods);
@@ -5267,6 +5197,7 @@ void App::Dialog_ADDGAME_Menu(const std::vector<std::string>& selected_items) {
             std::scoped_lock lock{entries_mutex};
             // 将应用条目添加到列表最前面
             this->entries.emplace(this->entries.begin(), std::move(app_entry));
+            ReindexEntrySlots(0);
         }
 
         // 重置主界面光标和页面位置，让用户返回桌面时能看到新添加的游戏 (Reset main interface cursor and page position so user can see newly added game when returning to desktop)
@@ -5283,47 +5214,8 @@ void App::Dialog_ADDGAME_Menu(const std::vector<std::string>& selected_items) {
             icon_task.submit_time = std::chrono::steady_clock::now();
             icon_task.task_type = ResourceTaskType::ICON;
             
-            icon_task.load_callback = [this, unique_id = app_entry.unique_id]() {
-                std::vector<unsigned char> icon_data;
-                bool has_icon_data = false;
-                
-                // 获取缓存的图标数据 (Get cached icon data)
-                {
-                    std::scoped_lock lock{entries_mutex};
-                    auto it = std::find_if(entries.begin(), entries.end(),
-                        [unique_id](const AppEntry& entry) {
-                            return entry.unique_id == unique_id && entry.has_cached_icon;
-                        });
-                    
-                    if (it != entries.end()) {
-                        icon_data = it->cached_icon_data;
-                        has_icon_data = true;
-                    }
-                }
-                
-                if (!has_icon_data) {
-                    return;
-                }
-                
-                // 验证并创建图像 (Validate and create image)
-                if (!icon_data.empty() && IsValidJpegData(icon_data)) {
-                    int image_id = nvgCreateImageMem(this->vg, 0, icon_data.data(), icon_data.size());
-                    if (image_id > 0) {
-                        std::scoped_lock lock{entries_mutex};
-                        auto it = std::find_if(entries.begin(), entries.end(),
-                            [unique_id](const AppEntry& entry) {
-                                return entry.unique_id == unique_id;
-                            });
-                        
-                        if (it != entries.end()) {
-                            if (it->own_image && it->image != this->default_icon_image) {
-                                nvgDeleteImage(this->vg, it->image);
-                            }
-                            it->image = image_id;
-                            it->own_image = true;
-                        }
-                    }
-                }
+            icon_task.load_callback = [this, unique_id = app_entry.unique_id, priority = icon_task.priority]() {
+                this->LoadEntryIcon(unique_id, priority);
             };
             
             this->resource_manager.submitLoadTask(icon_task);
@@ -5371,6 +5263,11 @@ void App::UpdateInstruction() {
             }
         }
     }
+
+    // 动画进行中逐帧绘制 (Draw every frame while an animation runs)
+    if (this->boundary_flash_animation > 0 || this->triangle_alpha_animation > 0) {
+        this->frame_scheduler.RequestFrameWithin(tj::FrameScheduler::Clock::duration::zero());
+    }
     
     // B键返回到主菜单 (B key to return to main menu)
     if (this->controller.B) {
@@ -5633,14 +5530,10 @@ void App::Sort_Mod() {
             if (a.MOD_TYPE != b.MOD_TYPE) {
                 return a.MOD_TYPE < b.MOD_TYPE; // 直接按类型字符串排序 (Sort directly by type string)
             }
-            std::string pinyin_a = this->GetFirstCharPinyin(a.MOD_NAME2);
-            std::string pinyin_b = this->GetFirstCharPinyin(b.MOD_NAME2);
-            return pinyin_a < pinyin_b; // 类型相同，按名称拼音顺序 (Same type, sort by name pinyin)
+            return a.sort_key < b.sort_key; // 类型相同，按名称拼音顺序 (Same type, sort by name pinyin)
         } else {
             // 都是无类型(NONE_TYPE_TEXT)，直接按名称拼音排序 (Both are NONE_TYPE_TEXT, sort by name pinyin directly)
-            std::string pinyin_a = this->GetFirstCharPinyin(a.MOD_NAME2);
-            std::string pinyin_b = this->GetFirstCharPinyin(b.MOD_NAME2);
-            return pinyin_a < pinyin_b; // 按名称拼音顺序 (Sort by name pinyin)
+            return a.sort_key < b.sort_key; // 按名称拼音顺序 (Sort by name pinyin)
         }
     });
 }
@@ -6162,12 +6055,12 @@ void App::newDrawDialogSearch() {
             
             if (is_selected) {
                 // 当前选中项：绘制彩色边框和黑色背景 (Current selected item: draw colored border and black background)
-                auto col_pulse = pulse.col;  // 获取脉冲颜色 (Get pulse color)
+                auto col_pulse = pulse.GetColour();  // 获取脉冲颜色 (Get pulse color)
                 col_pulse.r /= 255.f;        // 红色通道归一化(0-1范围) (Normalize red channel to 0-1 range)
                 col_pulse.g /= 255.f;        // 绿色通道归一化 (Normalize green channel)
                 col_pulse.b /= 255.f;        // 蓝色通道归一化 (Normalize blue channel)
                 col_pulse.a = 1.f;           // 设置不透明度为1(完全不透明) (Set alpha to 1 - fully opaque)
-                update_pulse_colour();       // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
+                update_pulse_colour(this->frame_scheduler);       // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
                 // 绘制选中项的彩色边框 (Draw colored border for selected item)
                 gfx::drawRect(this->vg, game_x - 5.f, game_y - 5.f, game_w + 10.f, game_h + 10.f, col_pulse);
                 // 绘制选中项的黑色背景 (Draw black background for selected item)
@@ -6279,12 +6172,12 @@ void App::newDrawDialogSearch() {
             
             if (is_selected && (!this->left_l_button_selected && !this->right_l_button_selected)) {
                 // 当前选中项：绘制彩色边框和黑色背景 (Current selected item: draw colored border and black background)
-                auto col_pulse = pulse.col;  // 获取脉冲颜色 (Get pulse color)
+                auto col_pulse = pulse.GetColour();  // 获取脉冲颜色 (Get pulse color)
                 col_pulse.r /= 255.f;        // 红色通道归一化(0-1范围) (Normalize red channel to 0-1 range)
                 col_pulse.g /= 255.f;        // 绿色通道归一化 (Normalize green channel)
                 col_pulse.b /= 255.f;        // 蓝色通道归一化 (Normalize blue channel)
                 col_pulse.a = 1.f;           // 设置不透明度为1(完全不透明) (Set alpha to 1 - fully opaque)
-                update_pulse_colour();       // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
+                update_pulse_colour(this->frame_scheduler);       // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
                 // 绘制选中项的彩色边框 (Draw colored border for selected item)
                 gfx::drawRect(this->vg, key_x - 5.f, row_y - 5.f, key_width + 10.f, key_height + 10.f, col_pulse);
                 // 绘制选中项的黑色背景 (Draw black background for selected item)
@@ -6312,12 +6205,12 @@ void App::newDrawDialogSearch() {
 
     if (this->left_l_button_selected) { // 左侧L形按钮选中 (Left L-shaped button selected)
         // 当前选中项：绘制彩色边框和黑色背景 (Current selected item: draw colored border and black background)
-        auto col_pulse = pulse.col;  // 获取脉冲颜色 (Get pulse color)
+        auto col_pulse = pulse.GetColour();  // 获取脉冲颜色 (Get pulse color)
         col_pulse.r /= 255.f;        // 红色通道归一化(0-1范围) (Normalize red channel to 0-1 range)
         col_pulse.g /= 255.f;        // 绿色通道归一化 (Normalize green channel)
         col_pulse.b /= 255.f;        // 蓝色通道归一化 (Normalize blue channel)
         col_pulse.a = 1.f;           // 设置不透明度为1(完全不透明) (Set alpha to 1 - fully opaque)
-        update_pulse_colour();       // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
+        update_pulse_colour(this->frame_scheduler);       // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
         // 绘制选中项的彩色边框 (Draw colored border for selected item)
         // 绘制L形按钮边框 (Draw L-shaped button border)
         // 上边框 (Top border)
@@ -6385,12 +6278,12 @@ void App::newDrawDialogSearch() {
 
     if (this->right_l_button_selected) { // 右侧L形按钮选中
         // 当前选中项：绘制彩色边框和黑色背景 (Current selected item: draw colored border and black background)
-        auto col_pulse = pulse.col;  // 获取脉冲颜色 (Get pulse color)
+        auto col_pulse = pulse.GetColour();  // 获取脉冲颜色 (Get pulse color)
         col_pulse.r /= 255.f;        // 红色通道归一化(0-1范围) (Normalize red channel to 0-1 range)
         col_pulse.g /= 255.f;        // 绿色通道归一化 (Normalize green channel)
         col_pulse.b /= 255.f;        // 蓝色通道归一化 (Normalize blue channel)
         col_pulse.a = 1.f;           // 设置不透明度为1(完全不透明) (Set alpha to 1 - fully opaque)
-        update_pulse_colour();       // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
+        update_pulse_colour(this->frame_scheduler);       // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
         // 绘制选中项的彩色边框 (Draw colored border for selected item)
         // 绘制L形按钮边框 (Draw L-shaped button border)
         // 上边框 (Top border)
@@ -6733,6 +6626,7 @@ void App::newHideDialogSearch() {
     this->search_selected_index = 0;
     this->newdialog_search_callback = nullptr;
     this->search_context.clear();
+    this->search_index.Clear();
     this->right_l_button_selected = false;
     this->left_l_button_selected = false;
 
@@ -7034,6 +6928,8 @@ void App::newShowDialogSearch(std::vector<std::string>& search_context, DialogSe
     this->keyboard_selected_col = 4;
     LOADING_TEXT = SEARCH_TEXT;
     this->search_context = search_context;
+    // 搜索上下文设置时一次性构建拼音索引 (Build the pinyin index once when the search context is set)
+    this->search_index.Build(this->search_context);
     this->newdialog_search_callback= callback;
 }
 
@@ -7083,13 +6979,13 @@ void App::newDrawDialogConfirm() {
                                 0.0f, 0.0f, 6.0f, 0.0f, 45, 45, 45); // 右半部分，右下角圆角 (Right half, bottom-right corner rounded)
     
     // 然后绘制选中状态的彩色边框 (Then draw selected state colored borders)
-    auto col = pulse.col;  // 获取脉冲颜色 (Get pulse color)
+    auto col = pulse.GetColour();  // 获取脉冲颜色 (Get pulse color)
     col.r /= 255.f;        // 红色通道归一化(0-1范围) (Normalize red channel to 0-1 range)
     col.g /= 255.f;        // 绿色通道归一化 (Normalize green channel)
     col.b /= 255.f;        // 蓝色通道归一化 (Normalize blue channel)
     col.a = 1.f;           // 设置不透明度为1(完全不透明) (Set alpha to 1 - fully opaque)
     // 更新脉冲颜色动画 (Update pulse color animation)
-    update_pulse_colour();
+    update_pulse_colour(this->frame_scheduler);
 
     // 先绘制按钮分界线 (Draw button divider lines first)
     // 绘制按钮顶部分界线 (Draw top divider line)
@@ -7262,12 +7158,12 @@ void App::newDrawDialogListSelect(){
         // 检查是否为当前光标选中的项 (Check if this is the currently cursor-selected item)
         if (i == this->newdialog_list_selected_index) {
             // 当前选中项：绘制彩色边框和黑色背景 (Current selected item: draw colored border and black background)
-            auto col = pulse.col;  // 获取脉冲颜色 (Get pulse color)
+            auto col = pulse.GetColour();  // 获取脉冲颜色 (Get pulse color)
             col.r /= 255.f;        // 红色通道归一化(0-1范围) (Normalize red channel to 0-1 range)
             col.g /= 255.f;        // 绿色通道归一化 (Normalize green channel)
             col.b /= 255.f;        // 蓝色通道归一化 (Normalize blue channel)
             col.a = 1.f;           // 设置不透明度为1(完全不透明) (Set alpha to 1 - fully opaque)
-            update_pulse_colour(); // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
+            update_pulse_colour(this->frame_scheduler); // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
             // 绘制选中项的彩色边框 (Draw colored border for selected item)
             gfx::drawRect(this->vg, list_dialog_x + offset_to_right, item_y - list_item_height / 2, 
                             list_dialog_width - offset_to_right * 2, list_item_height, col);
@@ -7638,6 +7534,7 @@ void App::newUpdateCopyProgress(const CopyProgressInfo& progress){
     // 更新复制进度 (Update copy progress)
     std::lock_guard<std::mutex> lock(this->copy_progress_mutex);
     this->copy_progress = progress;
+    this->frame_scheduler.MarkDirty();
 }
 
 void App::newHideDialogCopyProgress(){
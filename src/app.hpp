@@ -6,11 +6,20 @@
 #include "audio_manager.hpp"
 #include "mod_manager.hpp"
 #include "mtp_manager.hpp"
+#include "search_index.hpp"
+#include "game_dir_scanner.hpp"
+#include "catalog_snapshot.hpp"
+#include "icon_cache.hpp"
+#include "icon_decoder.hpp"
+#include "icon_data.hpp"
+#include "frame_scheduler.hpp"
+#include "collation_key.hpp"
 #include "yyjson/yyjson.h"
 
 #include <switch.h>
 #include <cstdint>
 #include <vector>
+#include <memory>
 #include <string>
 #include <future>
 #include <mutex>
@@ -102,12 +111,14 @@ struct AppEntry final {
     bool selected{false};
     bool own_image{false};
     
-    // 缓存的原始图标数据，避免重复从缓存读取
-    // Cached raw icon data to avoid repeated cache reads
-    std::vector<unsigned char> cached_icon_data;
+    // 原始图标数据，纹理上传后释放字节，需要重新解码时从缓存文件读取；共享所有权，图标任务取用时无需复制
+    // Raw icon data, its bytes are freed after the texture upload and read from the cache file when it has to be decoded
+    // again; shared ownership so icon tasks take it without copying
+    tj::IconDataPtr cached_icon_data;
     bool has_cached_icon{false};
     std::string FILE_NAME;
     std::string FILE_NAME2;
+    std::string sort_key; // FILE_NAME2的排序键 (Sort key of FILE_NAME2)
     std::string FILE_PATH; //mods2/游戏名字/ID
     std::string MOD_VERSION;
     std::string MOD_TOTAL;
@@ -122,17 +133,20 @@ struct AppEntry_AddGame final {
     int image;
     bool own_image{false};
     
-    // 缓存的原始图标数据，避免重复从缓存读取
-    // Cached raw icon data to avoid repeated cache reads
-    std::vector<unsigned char> cached_icon_data;
+    // 原始图标数据，纹理上传后释放字节，需要重新解码时从缓存文件读取；共享所有权，图标任务取用时无需复制
+    // Raw icon data, its bytes are freed after the texture upload and read from the cache file when it has to be decoded
+    // again; shared ownership so icon tasks take it without copying
+    tj::IconDataPtr cached_icon_data;
     bool has_cached_icon{false};
     size_t unique_id;
+    std::string sort_key; // name的排序键 (Sort key of name)
 };
 
 
 struct MODINFO final {
     std::string MOD_NAME;
     std::string MOD_NAME2;
+    std::string sort_key; // MOD_NAME2的排序键 (Sort key of MOD_NAME2)
     std::string MOD_PATH; //mods2/游戏名字/ID/模组的名字
     std::string MOD_TYPE;
     bool MOD_STATE{false};
@@ -169,7 +183,7 @@ private:
     
     std::priority_queue<ResourceLoadTask, std::vector<ResourceLoadTask>, TaskComparator> pending_tasks;
     mutable std::mutex task_mutex;
-    static constexpr int MAX_ICON_LOADS_PER_FRAME = 2;  // 每帧最大图标加载数量 (Max icon loads per frame)
+    static constexpr int MAX_ICON_LOADS_PER_FRAME = 16; // 每帧最多提交的图标任务，解码在后台进行，上传另有时间预算 (Max icon tasks per frame; decoding runs in the background and uploads have their own time budget)
     
 public:
     void submitLoadTask(const ResourceLoadTask& task);
@@ -208,10 +222,26 @@ private:
     void LoadVisibleAreaIcons();
     void LoadAddGameVisibleAreaIcons(); // 为AddGame界面加载可见区域图标 (Load visible area icons for AddGame interface)
 
-    // 辅助函数：根据filename_path获取其下面的modid和modid下面的子目录名称（使用标准C库）
-    // Helper function: Get modid and subdirectory names under filename_path (using standard C library)
-    std::pair<u64, std::string> GetModIdAndSubdirCountStdio(const std::string& filename_path);
-    
+    // 按unique_id查找条目，调用方需持有entries_mutex/entries_AddGame_mutex (Find an entry by unique_id, the caller must
+    // hold entries_mutex/entries_AddGame_mutex)
+    AppEntry* FindEntryByUniqueId(size_t unique_id);
+    AppEntry_AddGame* FindAddGameEntryByUniqueId(size_t unique_id);
+    // 列表从from开始的元素移动过（插入、删除、排序）后更新槽位表，调用方需持有对应的锁 (Update the slot table after
+    // elements from from onwards moved by an insert, erase or sort; the caller must hold the matching lock)
+    void ReindexEntrySlots(size_t from);
+    void ReindexAddGameEntrySlots(size_t from);
+
+    // 图标加载任务：把条目缓存的图标数据交给后台解码 (Icon load task: hand the entry's cached icon data to the background decoder)
+    void LoadEntryIcon(size_t unique_id, int priority);
+    void LoadAddGameEntryIcon(size_t unique_id, int priority);
+    template <typename Entry>
+    void RequestIconDecode(std::mutex& list_mutex, Entry* (App::*find_entry)(size_t), bool is_addgame, size_t unique_id, int priority);
+    template <typename Entry>
+    bool AttachIconImage(std::mutex& list_mutex, Entry* (App::*find_entry)(size_t), const tj::DecodedIcon& icon);
+    void UploadDecodedIcons(); // 每帧在时间预算内上传解码好的图标 (Upload decoded icons each frame within a time budget)
+    void ReleaseEvictedIcons(const std::vector<size_t>& evicted);
+    void ReleaseRemovedEntryIcons(); // 释放扫描线程移除的条目的图标 (Release icons of entries removed by the scan thread)
+
     // 对比mod版本和游戏版本是否一致的辅助函数 (Helper function to compare mod version and game version consistency)
     bool CompareModGameVersion(const std::string& mod_version, const std::string& game_version);
     
@@ -231,6 +261,10 @@ private:
     mutable std::pair<size_t, size_t> last_addgame_loaded_range{SIZE_MAX, SIZE_MAX};
     mutable std::chrono::steady_clock::time_point last_addgame_load_time{};
     
+    // 后台校正快照条目时补上了图标数据，可见区域需要重新提交图标任务 (The background reconcile filled in icon data for snapshot
+    // entries, the visible range must resubmit icon tasks)
+    std::atomic<bool> icon_range_stale{false};
+    
     // 列表界面视口感知图标加载的防抖和缓存机制 (Debouncing and caching mechanism for list interface viewport-aware icon loading)
 
     static constexpr auto LOAD_DEBOUNCE_MS = std::chrono::milliseconds(100); // 防抖延迟100ms (100ms debounce delay)
@@ -238,6 +272,13 @@ private:
     NVGcontext* vg{nullptr};
     std::vector<AppEntry> entries;
     std::vector<AppEntry_AddGame> entries_AddGame;
+    std::unordered_map<size_t, size_t> entry_slots;         // unique_id -> entries下标，受entries_mutex保护 (unique_id -> index in entries, guarded by entries_mutex)
+    std::unordered_map<size_t, size_t> addgame_entry_slots; // unique_id -> entries_AddGame下标 (unique_id -> index in entries_AddGame)
+    tj::IconDecoder icon_decoder;                           // 后台图标解码线程 (Background icon decoding threads)
+    tj::FrameScheduler frame_scheduler;                     // 跳过画面未变化的帧 (Skips frames where nothing changed)
+    static constexpr auto ICON_UPLOAD_BUDGET = std::chrono::microseconds(3000); // 每帧纹理上传时间预算 (Per-frame texture upload time budget)
+    tj::IconTextureCache icon_cache;                        // 主页图标纹理的LRU预算，只在界面线程使用 (LRU budget for home list icon textures, UI thread only)
+    std::vector<std::pair<size_t, int>> removed_entry_icons; // 扫描线程移除的条目(unique_id, 图像)，由界面线程释放，受entries_mutex保护 (Entries removed by the scan thread as (unique_id, image), released on the UI thread, guarded by entries_mutex)
     size_t unique_id{0};
     std::vector<MODINFO> mod_info;
 
@@ -308,6 +349,7 @@ private:
     // MTP相关成员变量 (MTP related member variables)
     mtp::MtpManager* mtp_manager{nullptr};  // MTP管理器实例 (MTP manager instance)
     std::vector<std::string> mtp_log_history;  // MTP日志历史记录 (MTP log history)
+    std::string mtp_last_transfer_info;        // 上次看到的传输信息，变化时重绘 (Last seen transfer info, redraw when it changes)
     mtp::MtpStatus last_mtp_status{mtp::MtpStatus::Stopped};  // 上次MTP状态 (Last MTP status)
     // 注意：已移除last_connection_status和last_transfer_active，因为现在直接使用格式化字符串
 
@@ -385,6 +427,7 @@ DialogSearchCallback newdialog_search_callback{nullptr};
     // 搜索功能相关 (Search functionality related)
     std::vector<std::pair<std::string, int>> search_results{};  // 搜索结果数组：first存储字符串结果，second存储在search_context中的索引位置 (Search results array: first stores string result, second stores index position in search_context)
     std::vector<std::string> search_context{}; // 搜索上下文 (Search context)
+    PinyinSearchIndex search_index{};          // 搜索上下文的拼音索引 (Pinyin index of the search context)
     int search_selected_index{0};          // 搜索结果中当前选中的索引 (Currently selected index in search results)
     bool search_has_results{false};        // 是否有搜索结果 (Whether there are search results)
     
@@ -618,10 +661,8 @@ DialogSearchCallback newdialog_search_callback{nullptr};
     std::vector<std::string> scanmodgamedir(); 
     
     
-    std::string GetFirstCharPinyin(const std::string& chinese_text); // 获取首字符拼音的辅助函数 (Helper function to get first character pinyin)
-    
     // 游戏目录排序辅助函数 (Game directory sorting helper function)
-    bool gamedirsort(const std::string& game_dir_a, const std::string& game_dir_b);
+    void SortGameDirsByMappedName(std::vector<std::string>& game_dirs);
     
     u32 getgameversioninfo(u64 application_id);
 
@@ -0,0 +1,70 @@
+#include "atomic_file.hpp"
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tj {
+
+namespace atomic_file {
+
+std::string TempPath(const std::string& path) {
+    return path + ".tmp";
+}
+
+bool Write(const std::string& path, const void* data, size_t size) {
+    std::string temp_path = TempPath(path);
+    FILE* file = fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    // 重命名前确保内容已落盘，否则断电后可能留下已替换但不完整的文件
+    // Make sure the content is on disk before renaming, otherwise power loss can leave a replaced but incomplete file
+    bool written = fwrite(data, 1, size, file) == size && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    if (fclose(file) != 0) {
+        written = false;
+    }
+    if (!written) {
+        // 旧文件还在，不完整的临时文件可以直接删除 (The old file is still there, the incomplete temp file can go)
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    if (std::rename(temp_path.c_str(), path.c_str()) == 0) {
+        return true;
+    }
+
+    // FAT上重命名不能覆盖，删除旧文件后重试；此后临时文件是唯一副本，失败也保留给Recover()
+    // Rename cannot overwrite on FAT, remove the old file and retry; the temp file is the only copy from here on and is
+    // left for Recover() even on failure
+    std::remove(path.c_str());
+    return std::rename(temp_path.c_str(), path.c_str()) == 0;
+}
+
+void Recover(const std::string& path) {
+    std::string temp_path = TempPath(path);
+    struct stat st;
+    if (stat(temp_path.c_str(), &st) != 0) {
+        return;
+    }
+
+    if (stat(path.c_str(), &st) == 0) {
+        // 目标文件仍在，说明替换前就中断了，临时文件可能不完整 (The target is still there, so the replace was
+        // interrupted before it started and the temp file may be incomplete)
+        std::remove(temp_path.c_str());
+        return;
+    }
+
+    // 旧文件只会在临时文件同步之后删除，此时临时文件就是最新的完整内容
+    // The old file is only removed after the temp file is synced, so the temp file holds the latest complete content
+    std::rename(temp_path.c_str(), path.c_str());
+}
+
+void Remove(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove(TempPath(path).c_str());
+}
+
+} // namespace atomic_file
+
+} // namespace tj
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace tj {
+
+/**
+ * 原子文件写入 - 先写入并同步<path>.tmp，再重命名覆盖<path>
+ * Atomic file writes - write and sync <path>.tmp first, then rename it over <path>
+ *
+ * FAT文件系统上重命名不能覆盖已存在的文件，只能先删除旧文件再重命名；这之后临时文件是唯一的副本，
+ * 因此任何失败都不会删除它，下次读取时由Recover()把它恢复为<path>
+ * Rename cannot overwrite an existing file on FAT, so the old file has to be removed first; from then on the temp file
+ * is the only copy, so no failure ever deletes it and Recover() restores it as <path> on the next read
+ */
+namespace atomic_file {
+
+/**
+ * 获取临时文件路径
+ * Get the temp file path
+ * @param path 目标文件路径 (Target file path)
+ */
+std::string TempPath(const std::string& path);
+
+/**
+ * 原子写入文件
+ * Write a file atomically
+ * @param path 目标文件路径 (Target file path)
+ * @param data 文件内容 (File content)
+ * @param size 内容长度 (Content size)
+ * @return 成功返回true；失败时旧文件或完整的临时文件至少保留一个 (Returns true on success; on failure either the
+ *         old file or the complete temp file is kept)
+ */
+bool Write(const std::string& path, const void* data, size_t size);
+
+/**
+ * 读取前调用：目标文件缺失时把遗留的临时文件恢复为目标文件，目标文件存在时删除遗留的临时文件
+ * Call before reading: restores a leftover temp file as the target when the target is missing, removes the leftover
+ * temp file when the target exists
+ * @param path 目标文件路径 (Target file path)
+ */
+void Recover(const std::string& path);
+
+/**
+ * 删除目标文件及其临时文件
+ * Remove the target file and its temp file
+ * @param path 目标文件路径 (Target file path)
+ */
+void Remove(const std::string& path);
+
+} // namespace atomic_file
+
+} // namespace tj
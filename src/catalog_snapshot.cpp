@@ -0,0 +1,120 @@
+#include "catalog_snapshot.hpp"
+#include <cstdio>
+#include <initializer_list>
+
+namespace tj {
+
+namespace {
+
+void AppendString(std::string& buffer, const std::string& value) {
+    manifest_io::AppendInt<u16>(buffer, static_cast<u16>(value.size()));
+    buffer.append(value);
+}
+
+bool ReadString(const std::string& buffer, size_t& offset, std::string& value) {
+    u16 length = 0;
+    if (!manifest_io::ReadInt<u16>(buffer, offset, length) || offset + length > buffer.size()) {
+        return false;
+    }
+    value.assign(buffer.data() + offset, length);
+    offset += length;
+    return true;
+}
+
+} // namespace
+
+u64 CatalogSnapshot::ComputeKey(const std::vector<std::string>& dirnames, const std::string& game_name_json_path) {
+    // 目录名连同结束符一起计算，避免相邻目录名拼接后相同 (Hash names with their terminator so adjacent names cannot merge)
+    u32 dir_crc32 = 0;
+    for (const auto& dirname : dirnames) {
+        dir_crc32 = crc32CalculateWithSeed(dir_crc32, dirname.c_str(), dirname.size() + 1);
+    }
+
+    // 映射名和收藏都来自game_name.json，按内容而不是修改时间判断 (Mapped names and favorites come from game_name.json, compare
+    // by content rather than modification time)
+    u32 json_crc32 = 0;
+    FILE* file = fopen(game_name_json_path.c_str(), "rb");
+    if (file) {
+        char buffer[4096];
+        size_t bytes_read;
+        while ((bytes_read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            json_crc32 = crc32CalculateWithSeed(json_crc32, buffer, bytes_read);
+        }
+        fclose(file);
+    }
+
+    return (static_cast<u64>(dir_crc32) << 32) | json_crc32;
+}
+
+bool CatalogSnapshot::Write(const std::string& snapshot_path, u64 key, const std::vector<CatalogSnapshotEntry>& entries) {
+    std::string buffer;
+    buffer.reserve(24 + entries.size() * 160);
+    manifest_io::AppendInt<u32>(buffer, SNAPSHOT_MAGIC);
+    manifest_io::AppendInt<u32>(buffer, SNAPSHOT_VERSION);
+    manifest_io::AppendInt<u64>(buffer, key);
+    manifest_io::AppendInt<u32>(buffer, static_cast<u32>(entries.size()));
+
+    for (const auto& entry : entries) {
+        manifest_io::AppendInt<u64>(buffer, entry.id);
+        manifest_io::AppendInt<u8>(buffer, entry.is_favorite ? 1 : 0);
+        for (const std::string* value : {&entry.dirname, &entry.name, &entry.display_version, &entry.FILE_NAME,
+                                         &entry.FILE_NAME2, &entry.FILE_PATH, &entry.MOD_VERSION, &entry.MOD_TOTAL}) {
+            if (value->size() > UINT16_MAX) {
+                return false;
+            }
+            AppendString(buffer, *value);
+        }
+    }
+
+    return manifest_io::WriteFileAtomic(snapshot_path, buffer);
+}
+
+bool CatalogSnapshot::Read(const std::string& snapshot_path, u64 key, std::vector<CatalogSnapshotEntry>& entries) {
+    entries.clear();
+
+    std::string buffer;
+    if (!manifest_io::ReadFileVerified(snapshot_path, buffer)) {
+        return false; // 快照不存在或已损坏 (Snapshot missing or corrupt)
+    }
+
+    size_t offset = 0;
+    u32 magic = 0;
+    u32 version = 0;
+    u64 stored_key = 0;
+    u32 entry_count = 0;
+    if (!manifest_io::ReadInt<u32>(buffer, offset, magic) || magic != SNAPSHOT_MAGIC ||
+        !manifest_io::ReadInt<u32>(buffer, offset, version) || version != SNAPSHOT_VERSION ||
+        !manifest_io::ReadInt<u64>(buffer, offset, stored_key) || stored_key != key ||
+        !manifest_io::ReadInt<u32>(buffer, offset, entry_count)) {
+        return false;
+    }
+
+    entries.reserve(entry_count);
+    for (u32 i = 0; i < entry_count; ++i) {
+        CatalogSnapshotEntry entry;
+        u8 is_favorite = 0;
+        if (!manifest_io::ReadInt<u64>(buffer, offset, entry.id) ||
+            !manifest_io::ReadInt<u8>(buffer, offset, is_favorite) ||
+            !ReadString(buffer, offset, entry.dirname) ||
+            !ReadString(buffer, offset, entry.name) ||
+            !ReadString(buffer, offset, entry.display_version) ||
+            !ReadString(buffer, offset, entry.FILE_NAME) ||
+            !ReadString(buffer, offset, entry.FILE_NAME2) ||
+            !ReadString(buffer, offset, entry.FILE_PATH) ||
+            !ReadString(buffer, offset, entry.MOD_VERSION) ||
+            !ReadString(buffer, offset, entry.MOD_TOTAL)) {
+            entries.clear();
+            return false;
+        }
+        entry.is_favorite = is_favorite != 0;
+        entries.push_back(std::move(entry));
+    }
+
+    if (offset != buffer.size()) {
+        entries.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace tj
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <switch.h>
+#include "install_manifest.hpp"
+
+namespace tj {
+
+/**
+ * 主页游戏列表快照中的单个条目
+ * Single entry in the home game list snapshot
+ */
+struct CatalogSnapshotEntry {
+    std::string dirname;         // /mods2/下的游戏目录名 (Game directory name under /mods2/)
+    std::string name;            // 游戏名称 (Game name)
+    std::string display_version; // 游戏版本 (Game version)
+    std::string FILE_NAME;       // 目录名中的游戏名部分 (Game name part of the directory name)
+    std::string FILE_NAME2;      // 映射后的显示名称 (Mapped display name)
+    std::string FILE_PATH;       // modid目录完整路径 (Full modid directory path)
+    std::string MOD_VERSION;     // 目录名中的MOD版本 (MOD version in the directory name)
+    std::string MOD_TOTAL;       // MOD数量 (MOD count)
+    u64 id{0};                   // 应用ID (Application ID)
+    bool is_favorite{false};     // 是否收藏 (Whether marked as favorite)
+};
+
+/**
+ * 主页游戏列表快照 - 上次完整扫描的结果，启动时直接显示，再由后台扫描校正
+ * Home game list snapshot - the result of the last complete scan, shown immediately on startup and then corrected by
+ * the background scan
+ *
+ * 快照以扫描目录列表和game_name.json内容的哈希为键，任一变化即失效并回退到完整扫描
+ * The snapshot is keyed by a hash of the scanned directory list and game_name.json content, any change invalidates it
+ * and falls back to a full scan
+ *
+ * 文件格式 (File format):
+ *   header  : magic u32, version u32, key u64, entry_count u32
+ *   entries : [id u64, is_favorite u8, 8 x (length u16, string)]...
+ *   trailer : 以上所有字节的CRC32 u32 (CRC32 of all preceding bytes)
+ */
+class CatalogSnapshot {
+public:
+    /**
+     * 计算快照键
+     * Compute the snapshot key
+     * @param dirnames scanmodgamedir返回的有序目录列表 (Ordered directory list returned by scanmodgamedir)
+     * @param game_name_json_path game_name.json路径 (Path of game_name.json)
+     * @return 快照键 (Snapshot key)
+     */
+    static u64 ComputeKey(const std::vector<std::string>& dirnames, const std::string& game_name_json_path);
+
+    /**
+     * 写入快照
+     * Write the snapshot
+     * @param snapshot_path 快照文件路径 (Snapshot file path)
+     * @param key 扫描开始时计算的快照键 (Snapshot key computed when the scan started)
+     * @param entries 按显示顺序排列的条目 (Entries in display order)
+     * @return 成功返回true，失败返回false (Returns true on success, false on failure)
+     */
+    static bool Write(const std::string& snapshot_path, u64 key, const std::vector<CatalogSnapshotEntry>& entries);
+
+    /**
+     * 读取快照，键不匹配或文件损坏时返回false
+     * Read the snapshot, returns false when the key does not match or the file is corrupt
+     * @param snapshot_path 快照文件路径 (Snapshot file path)
+     * @param key 当前的快照键 (Current snapshot key)
+     * @param entries 输出的条目 (Output entries)
+     * @return 快照有效返回true (Returns true if the snapshot is valid)
+     */
+    static bool Read(const std::string& snapshot_path, u64 key, std::vector<CatalogSnapshotEntry>& entries);
+
+private:
+    static constexpr u32 SNAPSHOT_MAGIC = 0x31534347; // "GCS1"
+    static constexpr u32 SNAPSHOT_VERSION = 1;
+};
+
+} // namespace tj
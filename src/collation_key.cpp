@@ -0,0 +1,43 @@
+#include "collation_key.hpp"
+#include "utf8_util.hpp"
+#include "Pinyin-onefile.cpp"
+
+namespace tj {
+
+std::string MakeCollationKey(const std::string& text) {
+    constexpr char TERMINATOR = '\x01';
+
+    std::string key;
+    key.reserve(text.size() * 2);
+
+    const char* str = text.c_str();
+    size_t len = text.length();
+    size_t i = 0;
+
+    while (i < len) {
+        size_t start = i;
+        wchar_t ch = 0;
+        // 无效字节按原样参与比较 (Invalid bytes are compared as they are)
+        DecodeUtf8(text, i, ch);
+
+        // 拼音库中"传"的第一个读音是ZHUAN，游戏名里几乎都读CHUAN (The first reading of "传" in the pinyin table is ZHUAN,
+        // in game names it is almost always CHUAN)
+        if (ch == 0x4F20) {
+            key.append("CHUAN");
+        } else if (WzhePinYin::Pinyin::IsChinese(ch)) {
+            auto pinyins = WzhePinYin::Pinyin::GetPinyins(ch);
+            if (!pinyins.empty()) {
+                key.append(pinyins[0]);
+            } else {
+                key.append(str + start, i - start);
+            }
+        } else {
+            key.append(str + start, i - start);
+        }
+        key.push_back(TERMINATOR);
+    }
+
+    return key;
+}
+
+} // namespace tj
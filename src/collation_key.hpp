@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+
+namespace tj {
+
+/**
+ * 生成名称的排序键：中文字符取第一个拼音，其他字符保留原字节，每个字符后追加\x01作为结束符
+ * Build the sort key of a name: Chinese characters take their first pinyin, other characters keep their original bytes,
+ * and every character is followed by a \x01 terminator
+ *
+ * 结束符小于所有可见字符，因此逐字符比较的结果与按完整名称拼音比较一致，排序时只需比较一次字符串
+ * The terminator sorts below every printable character, so comparing keys gives the same result as comparing names
+ * character by character in pinyin, and sorting needs one string compare per pair
+ * @param text UTF-8名称 (UTF-8 name)
+ * @return 排序键 (Sort key)
+ */
+std::string MakeCollationKey(const std::string& text);
+
+} // namespace tj
@@ -0,0 +1,219 @@
+#include "conflict_index.hpp"
+#include "atomic_file.hpp"
+#include <cstdio>
+#include <algorithm>
+
+namespace tj {
+
+ConflictIndex::ConflictIndex(const std::string& index_path) : index_path(index_path) {
+    if (!Load()) {
+        mod_names.clear();
+        records.clear();
+    }
+}
+
+bool ConflictIndex::Load() {
+    std::string buffer;
+    if (!manifest_io::ReadFileVerified(index_path, buffer)) {
+        return false; // 索引不存在或已损坏 (Index missing or corrupt)
+    }
+
+    size_t offset = 0;
+    u32 magic = 0;
+    u32 version = 0;
+    u32 mod_count = 0;
+    if (!manifest_io::ReadInt<u32>(buffer, offset, magic) || magic != INDEX_MAGIC ||
+        !manifest_io::ReadInt<u32>(buffer, offset, version) || version != INDEX_VERSION ||
+        !manifest_io::ReadInt<u32>(buffer, offset, mod_count) || mod_count > UINT16_MAX) {
+        return false;
+    }
+
+    mod_names.reserve(mod_count);
+    for (u32 i = 0; i < mod_count; ++i) {
+        u16 name_length = 0;
+        if (!manifest_io::ReadInt<u16>(buffer, offset, name_length) || offset + name_length > buffer.size()) {
+            return false;
+        }
+        mod_names.emplace_back(buffer.data() + offset, name_length);
+        offset += name_length;
+    }
+
+    u32 entry_count = 0;
+    if (!manifest_io::ReadInt<u32>(buffer, offset, entry_count)) {
+        return false;
+    }
+
+    records.reserve(entry_count);
+    for (u32 i = 0; i < entry_count; ++i) {
+        Record record;
+        u16 path_length = 0;
+        u16 owner_count = 0;
+        if (!manifest_io::ReadInt<u32>(buffer, offset, record.crc32) ||
+            !manifest_io::ReadInt<u16>(buffer, offset, path_length) ||
+            offset + path_length > buffer.size()) {
+            return false;
+        }
+        std::string target_path(buffer.data() + offset, path_length);
+        offset += path_length;
+
+        if (!manifest_io::ReadInt<u16>(buffer, offset, owner_count)) {
+            return false;
+        }
+        record.owners.resize(owner_count);
+        for (u16 j = 0; j < owner_count; ++j) {
+            if (!manifest_io::ReadInt<u16>(buffer, offset, record.owners[j]) || record.owners[j] >= mod_count) {
+                return false;
+            }
+        }
+        records.emplace(std::move(target_path), std::move(record));
+    }
+
+    return offset == buffer.size();
+}
+
+int ConflictIndex::FindMod(const std::string& mod_name) const {
+    for (size_t i = 0; i < mod_names.size(); ++i) {
+        if (mod_names[i] == mod_name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void ConflictIndex::AddMod(const std::string& mod_name, const std::vector<InstallManifestEntry>& entries) {
+    if (mod_name.empty()) {
+        return;
+    }
+
+    RemoveMod(mod_name);
+
+    // 复用已移除MOD留下的空位 (Reuse a slot left by a removed MOD)
+    int slot = FindMod("");
+    if (slot < 0) {
+        if (mod_names.size() >= UINT16_MAX) {
+            return;
+        }
+        slot = static_cast<int>(mod_names.size());
+        mod_names.push_back(mod_name);
+    } else {
+        mod_names[slot] = mod_name;
+    }
+
+    for (const auto& entry : entries) {
+        Record& record = records[entry.target_path];
+        if (record.owners.empty()) {
+            record.crc32 = entry.crc32;
+        }
+        record.owners.push_back(static_cast<u16>(slot));
+    }
+
+    dirty = true;
+}
+
+void ConflictIndex::RemoveMod(const std::string& mod_name) {
+    int slot = mod_name.empty() ? -1 : FindMod(mod_name);
+    if (slot < 0) {
+        return;
+    }
+
+    for (auto it = records.begin(); it != records.end();) {
+        auto& owners = it->second.owners;
+        owners.erase(std::remove(owners.begin(), owners.end(), static_cast<u16>(slot)), owners.end());
+        if (owners.empty()) {
+            it = records.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    mod_names[slot].clear();
+    dirty = true;
+}
+
+void ConflictIndex::RenameMod(const std::string& old_mod_name, const std::string& new_mod_name) {
+    if (new_mod_name.empty() || old_mod_name == new_mod_name) {
+        return;
+    }
+
+    int slot = old_mod_name.empty() ? -1 : FindMod(old_mod_name);
+    if (slot < 0) {
+        return;
+    }
+
+    RemoveMod(new_mod_name);
+    mod_names[slot] = new_mod_name;
+    dirty = true;
+}
+
+bool ConflictIndex::Lookup(const std::string& target_path, std::vector<std::string>& owners, u32* crc32) const {
+    owners.clear();
+
+    auto it = records.find(target_path);
+    if (it == records.end()) {
+        return false;
+    }
+
+    for (u16 owner : it->second.owners) {
+        owners.push_back(mod_names[owner]);
+    }
+    if (crc32) {
+        *crc32 = it->second.crc32;
+    }
+    return true;
+}
+
+bool ConflictIndex::Commit() {
+    if (!dirty) {
+        return true;
+    }
+
+    // 索引为空时直接删除文件 (Remove the file when the index is empty)
+    if (records.empty()) {
+        atomic_file::Remove(index_path);
+        mod_names.clear();
+        dirty = false;
+        return true;
+    }
+
+    // 压缩掉已移除MOD的空位 (Compact away slots of removed MODs)
+    std::vector<u16> remap(mod_names.size(), 0);
+    std::vector<std::string> compacted;
+    for (size_t i = 0; i < mod_names.size(); ++i) {
+        if (!mod_names[i].empty()) {
+            remap[i] = static_cast<u16>(compacted.size());
+            compacted.push_back(mod_names[i]);
+        }
+    }
+
+    std::string buffer;
+    manifest_io::AppendInt<u32>(buffer, INDEX_MAGIC);
+    manifest_io::AppendInt<u32>(buffer, INDEX_VERSION);
+    manifest_io::AppendInt<u32>(buffer, static_cast<u32>(compacted.size()));
+    for (const auto& name : compacted) {
+        manifest_io::AppendInt<u16>(buffer, static_cast<u16>(name.size()));
+        buffer.append(name);
+    }
+
+    manifest_io::AppendInt<u32>(buffer, static_cast<u32>(records.size()));
+    for (auto& [target_path, record] : records) {
+        manifest_io::AppendInt<u32>(buffer, record.crc32);
+        manifest_io::AppendInt<u16>(buffer, static_cast<u16>(target_path.size()));
+        buffer.append(target_path);
+        manifest_io::AppendInt<u16>(buffer, static_cast<u16>(record.owners.size()));
+        for (u16& owner : record.owners) {
+            owner = remap[owner];
+            manifest_io::AppendInt<u16>(buffer, owner);
+        }
+    }
+
+    mod_names = std::move(compacted);
+
+    if (!manifest_io::WriteFileAtomic(index_path, buffer)) {
+        return false;
+    }
+
+    dirty = false;
+    return true;
+}
+
+} // namespace tj
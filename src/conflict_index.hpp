@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <switch.h>
+#include "install_manifest.hpp"
+
+namespace tj {
+
+/**
+ * 冲突索引 - 每个游戏ID目录一份，记录已安装MOD写入的每个目标文件属于哪些MOD及其CRC32
+ * Conflict index - one per game ID directory, records which installed MODs own each target file and its CRC32
+ *
+ * 安装成功时加入MOD的文件，卸载成功时移除，冲突归属查询只需一次查找，无需逐个打开其他MOD的ZIP
+ * Files are added when a MOD installs and removed when it uninstalls, so finding conflict owners is a single lookup
+ * instead of opening every other MOD's ZIP
+ *
+ * 文件格式 (File format):
+ *   header  : magic u32, version u32, mod_count u32, [name_length u16, name]...
+ *   entries : entry_count u32, [crc32 u32, path_length u16, path, owner_count u16, owner u16...]...
+ *   trailer : 以上所有字节的CRC32 u32 (CRC32 of all preceding bytes)
+ */
+class ConflictIndex {
+public:
+    /**
+     * 读取索引文件，文件不存在或损坏时视为空索引
+     * Load index file, a missing or corrupt file is treated as an empty index
+     * @param index_path 索引文件路径 (Index file path)
+     */
+    explicit ConflictIndex(const std::string& index_path);
+
+    /**
+     * 加入一个MOD安装的所有文件，MOD已存在时先移除旧记录
+     * Add every file installed by a MOD, replacing any previous record of the same MOD
+     * @param mod_name MOD目录名（不含$） (MOD directory name without $)
+     * @param entries 安装清单条目 (Install manifest entries)
+     */
+    void AddMod(const std::string& mod_name, const std::vector<InstallManifestEntry>& entries);
+
+    /**
+     * 移除一个MOD的所有文件记录
+     * Remove every file record of a MOD
+     * @param mod_name MOD目录名（不含$） (MOD directory name without $)
+     */
+    void RemoveMod(const std::string& mod_name);
+
+    /**
+     * MOD目录改名后更新其所有者名称，新名称已存在时先移除其旧记录
+     * Rename a MOD's owner name after its directory is renamed, any existing record of the new name is removed first
+     * @param old_mod_name 原MOD目录名（不含$） (Old MOD directory name without $)
+     * @param new_mod_name 新MOD目录名（不含$） (New MOD directory name without $)
+     */
+    void RenameMod(const std::string& old_mod_name, const std::string& new_mod_name);
+
+    /**
+     * 查询目标文件的所有者
+     * Look up the owners of a target file
+     * @param target_path 目标文件完整路径 (Full target file path)
+     * @param owners 输出的MOD目录名列表 (Output MOD directory names)
+     * @param crc32 可选输出，记录的CRC32 (Optional output, recorded CRC32)
+     * @return 找到记录返回true (Returns true if a record was found)
+     */
+    bool Lookup(const std::string& target_path, std::vector<std::string>& owners, u32* crc32 = nullptr) const;
+
+    /**
+     * 将内存中的修改一次性原子写回，索引为空时删除文件
+     * Write in-memory changes back atomically in one go, delete the file when the index is empty
+     * @return 成功返回true，失败返回false (Returns true on success, false on failure)
+     */
+    bool Commit();
+
+    size_t Size() const { return records.size(); }
+
+private:
+    static constexpr u32 INDEX_MAGIC = 0x3149434D; // "MCI1"
+    static constexpr u32 INDEX_VERSION = 1;
+
+    struct Record {
+        u32 crc32;
+        std::vector<u16> owners; // mod_names中的下标 (Indices into mod_names)
+    };
+
+    bool Load();
+    int FindMod(const std::string& mod_name) const;
+
+    std::string index_path;
+    std::vector<std::string> mod_names;                // 已移除的MOD留空，提交时压缩 (Removed MODs are left empty and compacted on commit)
+    std::unordered_map<std::string, Record> records;   // 目标路径 -> 记录 (Target path -> record)
+    bool dirty{false};
+};
+
+} // namespace tj
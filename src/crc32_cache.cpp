@@ -0,0 +1,113 @@
+#include "crc32_cache.hpp"
+#include <sys/stat.h>
+
+namespace tj {
+
+void Crc32Cache::Open(const std::string& cache_path) {
+    if (cache_path == this->cache_path) {
+        return;
+    }
+
+    // 切换游戏前先保存上一个游戏的修改 (Save the previous game's changes before switching)
+    Commit();
+
+    this->cache_path = cache_path;
+    records.clear();
+    dirty = false;
+    if (!Load()) {
+        records.clear(); // 缓存不存在或已损坏，视为空 (Missing or corrupt cache is treated as empty)
+    }
+}
+
+bool Crc32Cache::Load() {
+    std::string buffer;
+    if (cache_path.empty() || !manifest_io::ReadFileVerified(cache_path, buffer)) {
+        return false;
+    }
+
+    size_t offset = 0;
+    u32 magic = 0;
+    u32 version = 0;
+    u32 entry_count = 0;
+    if (!manifest_io::ReadInt<u32>(buffer, offset, magic) || magic != CACHE_MAGIC ||
+        !manifest_io::ReadInt<u32>(buffer, offset, version) || version != CACHE_VERSION ||
+        !manifest_io::ReadInt<u32>(buffer, offset, entry_count) || entry_count > MAX_ENTRIES) {
+        return false;
+    }
+
+    records.reserve(entry_count);
+    for (u32 i = 0; i < entry_count; ++i) {
+        Record record;
+        u16 path_length = 0;
+        if (!manifest_io::ReadInt<u64>(buffer, offset, record.size) ||
+            !manifest_io::ReadInt<u64>(buffer, offset, record.mtime) ||
+            !manifest_io::ReadInt<u32>(buffer, offset, record.crc32) ||
+            !manifest_io::ReadInt<u16>(buffer, offset, path_length) ||
+            offset + path_length > buffer.size()) {
+            return false;
+        }
+        records.emplace(std::string(buffer.data() + offset, path_length), record);
+        offset += path_length;
+    }
+
+    return offset == buffer.size();
+}
+
+bool Crc32Cache::Lookup(const std::string& file_path, u64 size, u64 mtime, u32& crc32) const {
+    auto it = records.find(file_path);
+    if (it == records.end() || it->second.size != size || it->second.mtime != mtime) {
+        return false;
+    }
+
+    crc32 = it->second.crc32;
+    return true;
+}
+
+void Crc32Cache::Store(const std::string& file_path, u64 size, u64 mtime, u32 crc32) {
+    if (cache_path.empty() || file_path.size() > UINT16_MAX) {
+        return;
+    }
+
+    if (records.size() >= MAX_ENTRIES && records.find(file_path) == records.end()) {
+        records.clear();
+    }
+
+    records[file_path] = Record{size, mtime, crc32};
+    dirty = true;
+}
+
+void Crc32Cache::StoreInstalledFiles(const std::vector<InstallManifestEntry>& entries) {
+    for (const auto& entry : entries) {
+        struct stat target_stat;
+        if (stat(entry.target_path.c_str(), &target_stat) == 0 && static_cast<u64>(target_stat.st_size) == entry.size) {
+            Store(entry.target_path, entry.size, static_cast<u64>(target_stat.st_mtime), entry.crc32);
+        }
+    }
+}
+
+bool Crc32Cache::Commit() {
+    if (!dirty || cache_path.empty()) {
+        return true;
+    }
+
+    std::string buffer;
+    manifest_io::AppendInt<u32>(buffer, CACHE_MAGIC);
+    manifest_io::AppendInt<u32>(buffer, CACHE_VERSION);
+    manifest_io::AppendInt<u32>(buffer, static_cast<u32>(records.size()));
+    for (const auto& [file_path, record] : records) {
+        manifest_io::AppendInt<u64>(buffer, record.size);
+        manifest_io::AppendInt<u64>(buffer, record.mtime);
+        manifest_io::AppendInt<u32>(buffer, record.crc32);
+        manifest_io::AppendInt<u16>(buffer, static_cast<u16>(file_path.size()));
+        buffer.append(file_path);
+    }
+
+    if (!manifest_io::WriteFileAtomic(cache_path, buffer)) {
+        return false;
+    }
+
+    dirty = false;
+    return true;
+}
+
+} // namespace tj
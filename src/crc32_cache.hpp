@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <switch.h>
+#include "install_manifest.hpp"
+
+namespace tj {
+
+/**
+ * CRC32缓存 - 每个游戏ID目录一份，按(路径, 大小, 修改时间)记录文件的CRC32，文件未变化时无需重新读取内容
+ * CRC32 cache - one per game ID directory, records file CRC32s keyed on (path, size, mtime) so unchanged files are
+ * never read again
+ *
+ * 安装时把已知的CRC32（ZIP中央目录、复制时顺带计算的值）连同目标文件的大小和修改时间写入，叠加或重装MOD时直接命中
+ * Installs store the CRC32s they already know (ZIP central directory, values computed while copying) together with the
+ * target's size and mtime, so stacking or reinstalling MODs hits the cache directly
+ *
+ * 文件格式 (File format):
+ *   header  : magic u32, version u32, entry_count u32
+ *   entries : [size u64, mtime u64, crc32 u32, path_length u16, path]...
+ *   trailer : 以上所有字节的CRC32 u32 (CRC32 of all preceding bytes)
+ */
+class Crc32Cache {
+public:
+    static constexpr size_t MAX_ENTRIES = 65536; // 超出时整体清空重建 (Cleared and rebuilt when exceeded)
+
+    /**
+     * 切换到指定缓存文件，与当前文件相同时保留内存中的内容
+     * Switch to a cache file, the in-memory content is kept when it is the current file
+     * @param cache_path 缓存文件路径 (Cache file path)
+     */
+    void Open(const std::string& cache_path);
+
+    /**
+     * 查询文件的CRC32
+     * Look up a file's CRC32
+     * @param file_path 文件完整路径 (Full file path)
+     * @param size 当前文件大小 (Current file size)
+     * @param mtime 当前修改时间 (Current modification time)
+     * @param crc32 输出的CRC32 (Output CRC32)
+     * @return 大小和修改时间都一致时返回true (Returns true when both size and mtime match)
+     */
+    bool Lookup(const std::string& file_path, u64 size, u64 mtime, u32& crc32) const;
+
+    /**
+     * 记录文件的CRC32
+     * Record a file's CRC32
+     */
+    void Store(const std::string& file_path, u64 size, u64 mtime, u32 crc32);
+
+    /**
+     * 记录刚安装的目标文件，大小与清单一致时取当前修改时间
+     * Record freshly installed targets, taking the current mtime when the size matches the manifest
+     * @param entries 安装清单条目 (Install manifest entries)
+     */
+    void StoreInstalledFiles(const std::vector<InstallManifestEntry>& entries);
+
+    /**
+     * 将内存中的修改一次性原子写回
+     * Write in-memory changes back atomically in one go
+     * @return 成功返回true，失败返回false (Returns true on success, false on failure)
+     */
+    bool Commit();
+
+    size_t Size() const { return records.size(); }
+
+private:
+    static constexpr u32 CACHE_MAGIC = 0x3143434D; // "MCC1"
+    static constexpr u32 CACHE_VERSION = 1;
+
+    struct Record {
+        u64 size;
+        u64 mtime;
+        u32 crc32;
+    };
+
+    bool Load();
+
+    std::string cache_path;
+    std::unordered_map<std::string, Record> records; // 文件路径 -> 记录 (File path -> record)
+    bool dirty{false};
+};
+
+} // namespace tj
@@ -0,0 +1,34 @@
+#include "frame_scheduler.hpp"
+#include <algorithm>
+
+namespace tj {
+
+void FrameScheduler::MarkActive(Clock::time_point now) {
+    MarkDirty();
+    last_input = std::max(last_input, now);
+    active_until = std::max(active_until, now + ACTIVE_WINDOW);
+}
+
+void FrameScheduler::RequestFrameWithin(Clock::duration interval, Clock::time_point now) {
+    next_deadline = std::min(next_deadline, now + interval);
+}
+
+bool FrameScheduler::ShouldDraw(Clock::time_point now) {
+    // 先取出重绘标记，绘制期间其他线程的新标记留到下一帧 (Take the dirty mark first, new marks from other threads
+    // during drawing are kept for the next frame)
+    bool draw = dirty.exchange(false, std::memory_order_relaxed);
+    draw = draw || now < active_until || now >= next_deadline || now - last_draw >= IDLE_REFRESH_INTERVAL;
+
+    if (!draw) {
+        stats.skipped_frames++;
+        return false;
+    }
+
+    // 动画在本帧绘制时重新申请下一帧 (Animations request their next frame again while this one is drawn)
+    next_deadline = Clock::time_point::max();
+    last_draw = now;
+    stats.drawn_frames++;
+    return true;
+}
+
+} // namespace tj
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <switch.h>
+
+namespace tj {
+
+/**
+ * 帧调度器 - 记录画面是否有变化，没有变化的帧跳过绘制，屏幕继续显示上一次呈现的画面
+ * Frame scheduler - tracks whether anything on screen changed; unchanged frames skip drawing and the screen keeps
+ * showing the last presented image
+ *
+ * 输入、后台进度、图标到达和动画会标记画面需要重绘；输入后的一段时间内逐帧绘制，覆盖由输入引起的延迟状态变化；
+ * 另外每隔一段时间强制绘制一帧，兜底没有显式标记的状态变化
+ * Input, background progress, icon arrivals and animations mark the frame dirty; every frame is drawn for a while after
+ * input to cover delayed state changes it causes, and a frame is forced every so often as a safety net for changes that
+ * are not marked explicitly
+ *
+ * MarkDirty()可在任意线程调用，其余方法只在界面线程使用
+ * MarkDirty() may be called from any thread, everything else is used from the UI thread only
+ */
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr auto ACTIVE_WINDOW = std::chrono::milliseconds(1000);          // 输入后逐帧绘制的时间 (How long every frame is drawn after input)
+    static constexpr auto IDLE_REFRESH_INTERVAL = std::chrono::milliseconds(250);   // 空闲时的兜底刷新间隔 (Safety refresh interval while idle)
+
+    struct Stats {
+        u64 drawn_frames{0};
+        u64 skipped_frames{0};
+    };
+
+    /**
+     * 标记画面需要重绘，可在任意线程调用
+     * Mark the frame dirty, callable from any thread
+     */
+    void MarkDirty() { dirty.store(true, std::memory_order_relaxed); }
+
+    /**
+     * 收到输入时调用：重绘并在ACTIVE_WINDOW内保持逐帧绘制
+     * Called on input: redraw and keep drawing every frame for ACTIVE_WINDOW
+     */
+    void MarkActive(Clock::time_point now);
+
+    /**
+     * 动画绘制时调用，保证最迟在interval之后再绘制一帧
+     * Called while drawing an animation, makes sure another frame is drawn within interval
+     * @param interval 0表示下一帧 (0 means the next frame)
+     * @param now 当前时间 (Current time)
+     */
+    void RequestFrameWithin(Clock::duration interval, Clock::time_point now = Clock::now());
+
+    /**
+     * 决定本帧是否绘制，返回true时清除重绘标记
+     * Decide whether this frame is drawn, clears the dirty mark when returning true
+     */
+    bool ShouldDraw(Clock::time_point now);
+
+    /**
+     * 最后一次输入的时间，动画据此决定何时停下
+     * Time of the last input, animations use it to decide when to settle
+     */
+    Clock::time_point GetLastInput() const { return last_input; }
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    std::atomic<bool> dirty{true};
+    Clock::time_point active_until{};
+    Clock::time_point last_input{Clock::now()}; // 启动视为一次输入 (Startup counts as input)
+    Clock::time_point last_draw{};
+    Clock::time_point next_deadline{Clock::time_point::max()}; // 动画要求的下一帧时间 (Next frame time requested by animations)
+    Stats stats{};
+};
+
+} // namespace tj
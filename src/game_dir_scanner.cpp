@@ -0,0 +1,140 @@
+#include "game_dir_scanner.hpp"
+#include <dirent.h>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+namespace tj {
+
+GameDirScanner::~GameDirScanner() {
+    Stop();
+}
+
+void GameDirScanner::Start(const std::vector<std::string>& dirnames) {
+    Stop();
+
+    this->dirnames = dirnames;
+    results.assign(dirnames.size(), {});
+    ready.assign(dirnames.size(), 0);
+    next_index = 0;
+
+    size_t worker_count = std::min(WORKER_COUNT, dirnames.size());
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers.emplace_back(util::async([this](std::stop_token stop_token) {
+            this->Worker(stop_token);
+        }));
+    }
+}
+
+void GameDirScanner::Worker(std::stop_token stop_token) {
+    while (!stop_token.stop_requested()) {
+        size_t index = next_index.fetch_add(1);
+        if (index >= dirnames.size()) {
+            return;
+        }
+
+        // 标记项不是目录，直接完成 (Marker items are not directories, complete immediately)
+        GameDirScanResult result;
+        if (dirnames[index] != "END::FAVORITES") {
+            result = ScanGameDir("/mods2/" + dirnames[index]);
+        }
+
+        {
+            std::scoped_lock lock{mutex};
+            results[index] = std::move(result);
+            ready[index] = 1;
+        }
+        ready_cv.notify_all();
+    }
+}
+
+bool GameDirScanner::Wait(size_t index, GameDirScanResult& result, std::stop_token stop_token) {
+    if (index >= dirnames.size()) {
+        return false;
+    }
+
+    std::unique_lock lock{mutex};
+    if (!ready_cv.wait(lock, stop_token, [this, index] { return ready[index] != 0; })) {
+        return false; // 调用方请求停止 (Caller requested stop)
+    }
+
+    result = std::move(results[index]);
+    return true;
+}
+
+void GameDirScanner::Stop() {
+    // AsyncFurture析构时请求停止并等待线程退出 (AsyncFurture requests stop and joins on destruction)
+    workers.clear();
+}
+
+// 根据filename_path获取其下面的modid和mod目录数量（使用标准C库）
+// Get modid and mod directory count under filename_path (using standard C library)
+GameDirScanResult GameDirScanner::ScanGameDir(const std::string& filename_path) {
+    GameDirScanResult result;
+
+    // 打开filename目录
+    // Open filename directory
+    DIR* filename_dir = opendir(filename_path.c_str());
+    if (!filename_dir) {
+        return result; // 返回空结果
+    }
+
+    // 读取第一个有效目录条目（应该是唯一的modid文件夹）
+    // Read the first valid directory entry (should be the only modid folder)
+    struct dirent* entry;
+    u64 application_id = 0;
+
+    while ((entry = readdir(filename_dir)) != nullptr) {
+        // 跳过当前目录和父目录
+        // Skip current and parent directory entries
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        // 将modid字符串转换为u64类型的应用ID
+        // Convert modid string to u64 application ID
+        char* endptr;
+        application_id = strtoull(entry->d_name, &endptr, 16);
+
+        // 检查转换是否成功（modid应该是16进制字符串）
+        // Check if conversion was successful (modid should be hex string)
+        if (*endptr == '\0' && application_id != 0) {
+            result.modid_name = entry->d_name; // 保存有效的modid目录名，避免在closedir后访问失效指针
+            break;
+        }
+    }
+
+    closedir(filename_dir);
+
+    if (application_id == 0 || result.modid_name.empty()) {
+        result.modid_name.clear();
+        return result; // 未找到有效的modid
+    }
+
+    // 读取modid目录下的子目录数量
+    // Read subdirectory count under modid directory
+    std::string modid_path = filename_path + "/" + result.modid_name;
+    DIR* modid_dir = opendir(modid_path.c_str());
+
+    int mod_count = 0; // MOD目录数量计数器
+    if (modid_dir) {
+        struct dirent* subentry;
+        while ((subentry = readdir(modid_dir)) != nullptr) {
+            // 跳过当前目录和父目录和带点的文件
+            // Skip current and parent directory entries and files with dots
+            if (strcmp(subentry->d_name, ".") == 0 || strcmp(subentry->d_name, "..") == 0 || strchr(subentry->d_name, '.') != nullptr) {
+                continue;
+            }
+
+            mod_count++; // 计数有效的MOD目录
+        }
+        closedir(modid_dir);
+    }
+
+    result.application_id = application_id;
+    result.mod_count = std::to_string(mod_count);
+    return result;
+}
+
+} // namespace tj
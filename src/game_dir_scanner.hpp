@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stop_token>
+#include <switch.h>
+#include "async.hpp"
+
+namespace tj {
+
+/**
+ * 游戏目录扫描结果
+ * Game directory scan result
+ */
+struct GameDirScanResult {
+    u64 application_id{0};    // modid目录解析出的应用ID，未找到为0 (Application ID parsed from the modid directory, 0 if not found)
+    std::string modid_name{}; // modid目录名 (modid directory name)
+    std::string mod_count{"0"}; // modid目录下的MOD数量 (Number of MODs under the modid directory)
+};
+
+/**
+ * 游戏目录扫描器 - 由少量工作线程并行读取/mods2/下每个游戏目录，调用方按原顺序逐个取结果
+ * Game directory scanner - a small worker pool reads every game directory under /mods2/ in parallel, the caller takes
+ * results one by one in the original order
+ *
+ * 工作线程按下标递增领取任务，首屏的几个目录总是最先完成
+ * Workers claim directories in increasing index order, so the first screen's directories always finish first
+ */
+class GameDirScanner {
+public:
+    static constexpr size_t WORKER_COUNT = 3;
+
+    ~GameDirScanner();
+
+    /**
+     * 启动工作线程扫描目录列表，列表中的"END::FAVORITES"等标记项直接视为完成
+     * Start workers scanning the directory list, marker items such as "END::FAVORITES" complete immediately
+     * @param dirnames /mods2/下的游戏目录名列表 (Game directory names under /mods2/)
+     */
+    void Start(const std::vector<std::string>& dirnames);
+
+    /**
+     * 等待第index个目录的扫描结果
+     * Wait for the scan result of the index-th directory
+     * @param index 目录下标 (Directory index)
+     * @param result 输出的扫描结果 (Output scan result)
+     * @param stop_token 调用方的停止令牌 (Caller's stop token)
+     * @return 取得结果返回true，被停止返回false (Returns true when the result is available, false if stopped)
+     */
+    bool Wait(size_t index, GameDirScanResult& result, std::stop_token stop_token);
+
+    /**
+     * 停止并等待所有工作线程退出
+     * Stop and join all workers
+     */
+    void Stop();
+
+    /**
+     * 读取单个游戏目录：第一个十六进制命名的子目录为modid，统计其下的MOD目录数量
+     * Read one game directory: the first hex-named subdirectory is the modid, count the MOD directories under it
+     * @param filename_path 游戏目录完整路径 (Full game directory path)
+     * @return 扫描结果 (Scan result)
+     */
+    static GameDirScanResult ScanGameDir(const std::string& filename_path);
+
+private:
+    void Worker(std::stop_token stop_token);
+
+    std::vector<std::string> dirnames;
+    std::vector<GameDirScanResult> results;
+    std::vector<u8> ready;
+    std::atomic<size_t> next_index{0};
+    std::mutex mutex;
+    std::condition_variable_any ready_cv;
+    std::vector<util::AsyncFurture<void>> workers;
+};
+
+} // namespace tj
@@ -0,0 +1,57 @@
+#include "icon_cache.hpp"
+
+namespace tj {
+
+void IconTextureCache::SetBudget(size_t budget_bytes, std::vector<size_t>& evicted) {
+    this->budget_bytes = budget_bytes;
+    EvictOverBudget(evicted);
+}
+
+bool IconTextureCache::Touch(size_t unique_id) {
+    auto it = nodes.find(unique_id);
+    if (it == nodes.end()) {
+        return false;
+    }
+
+    lru.splice(lru.begin(), lru, it->second);
+    stats.hits++;
+    return true;
+}
+
+void IconTextureCache::Insert(size_t unique_id, size_t bytes, std::vector<size_t>& evicted) {
+    // 同一条目重新解码时替换旧记录 (Replace the old record when the same entry is decoded again)
+    Erase(unique_id);
+
+    lru.push_front(Node{unique_id, bytes});
+    nodes[unique_id] = lru.begin();
+    stats.resident_bytes += bytes;
+    stats.resident_count++;
+
+    EvictOverBudget(evicted);
+}
+
+void IconTextureCache::Erase(size_t unique_id) {
+    auto it = nodes.find(unique_id);
+    if (it == nodes.end()) {
+        return;
+    }
+
+    stats.resident_bytes -= it->second->bytes;
+    stats.resident_count--;
+    lru.erase(it->second);
+    nodes.erase(it);
+}
+
+void IconTextureCache::EvictOverBudget(std::vector<size_t>& evicted) {
+    while (stats.resident_bytes > budget_bytes && lru.size() > MIN_RESIDENT) {
+        const Node& node = lru.back();
+        evicted.push_back(node.unique_id);
+        stats.resident_bytes -= node.bytes;
+        stats.resident_count--;
+        stats.evictions++;
+        nodes.erase(node.unique_id);
+        lru.pop_back();
+    }
+}
+
+} // namespace tj
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <switch.h>
+
+namespace tj {
+
+/**
+ * 图标纹理LRU缓存 - 按内存预算记录主页已解码的图标纹理，超出预算时淘汰最久未使用的纹理
+ * Icon texture LRU cache - tracks the home list's decoded icon textures against a memory budget and evicts the least
+ * recently used ones when over budget
+ *
+ * 缓存只记账不持有纹理：淘汰的unique_id交给调用方删除图像并恢复默认图标；只在界面线程使用
+ * The cache only does the bookkeeping and does not own textures: evicted unique_ids are handed back to the caller,
+ * which deletes the images and restores the default icon; used from the UI thread only
+ */
+class IconTextureCache {
+public:
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 16 * 1024 * 1024; // 约64个256x256图标 (About 64 icons of 256x256)
+    static constexpr size_t MIN_RESIDENT = 16; // 至少保留可见区域加预加载的纹理 (Always keep the visible window plus prefetch)
+
+    struct Stats {
+        u64 hits{0};           // 可见区域内纹理仍在缓存中 (Texture was still cached when its entry became visible)
+        u64 misses{0};         // 需要重新解码 (Had to decode)
+        u64 evictions{0};      // 因超出预算被淘汰 (Evicted for exceeding the budget)
+        size_t resident_bytes{0};
+        size_t resident_count{0};
+    };
+
+    explicit IconTextureCache(size_t budget_bytes = DEFAULT_BUDGET_BYTES) : budget_bytes(budget_bytes) {}
+
+    /**
+     * 修改内存预算，超出部分立即淘汰
+     * Change the memory budget, anything over it is evicted immediately
+     * @param budget_bytes 新预算（字节） (New budget in bytes)
+     * @param evicted 输出被淘汰的unique_id (Output evicted unique_ids)
+     */
+    void SetBudget(size_t budget_bytes, std::vector<size_t>& evicted);
+
+    /**
+     * 可见条目已有纹理时调用，计为命中并移到最近使用
+     * Called when a visible entry already has its texture, counts a hit and marks it most recently used
+     * @param unique_id 条目ID (Entry ID)
+     * @return 纹理由缓存记录返回true (Returns true if the texture is tracked by the cache)
+     */
+    bool Touch(size_t unique_id);
+
+    /**
+     * 可见条目需要解码时调用，计为未命中
+     * Called when a visible entry needs decoding, counts a miss
+     */
+    void RecordMiss() { stats.misses++; }
+
+    /**
+     * 记录新创建的纹理，超出预算时淘汰最久未使用的纹理
+     * Record a newly created texture, evicting least recently used textures when over budget
+     * @param unique_id 条目ID (Entry ID)
+     * @param bytes 纹理大小 (Texture size)
+     * @param evicted 输出被淘汰的unique_id (Output evicted unique_ids)
+     */
+    void Insert(size_t unique_id, size_t bytes, std::vector<size_t>& evicted);
+
+    /**
+     * 条目被移除或其图像被外部删除时调用
+     * Called when an entry is removed or its image is deleted elsewhere
+     * @param unique_id 条目ID (Entry ID)
+     */
+    void Erase(size_t unique_id);
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    struct Node {
+        size_t unique_id;
+        size_t bytes;
+    };
+
+    void EvictOverBudget(std::vector<size_t>& evicted);
+
+    size_t budget_bytes;
+    std::list<Node> lru; // 头部为最近使用 (Front is most recently used)
+    std::unordered_map<size_t, std::list<Node>::iterator> nodes;
+    Stats stats;
+};
+
+} // namespace tj
@@ -0,0 +1,73 @@
+#include "icon_data.hpp"
+#include <cstring>
+
+namespace tj {
+
+std::shared_ptr<const IconData> IconData::FromTitleCache(NxTitleCacheApplicationMetadataView& view) {
+    if (view.icon_size == 0) {
+        nxtcReleaseApplicationMetadataView(&view);
+        return nullptr;
+    }
+
+    auto icon = std::make_shared<IconData>();
+    icon->view = view;
+    icon->bytes = static_cast<const unsigned char*>(view.icon_data);
+    icon->length = view.icon_size;
+    std::memset(&view, 0, sizeof(view));
+    return icon;
+}
+
+std::shared_ptr<const IconData> IconData::FromBytes(const void* data, size_t size) {
+    if (!data || size == 0) {
+        return nullptr;
+    }
+
+    auto icon = std::make_shared<IconData>();
+    const auto* begin = static_cast<const unsigned char*>(data);
+    icon->owned.assign(begin, begin + size);
+    icon->bytes = icon->owned.data();
+    icon->length = icon->owned.size();
+    return icon;
+}
+
+std::unique_lock<std::mutex> IconData::Load() const {
+    std::unique_lock lock{load_mutex};
+    if (bytes) {
+        return lock;
+    }
+    if (!view.handle || !nxtcLoadApplicationMetadataViewIcon(&view)) {
+        lock.unlock();
+        return lock;
+    }
+    bytes = static_cast<const unsigned char*>(view.icon_data);
+    return lock;
+}
+
+void IconData::Unload() const {
+    // 解码线程正在读取时不等待，下次上传后再释放 (Don't wait while a decoder thread is reading, it's freed after the
+    // next upload instead)
+    std::unique_lock lock{load_mutex, std::try_to_lock};
+    if (!lock || !bytes || !view.handle) {
+        return;
+    }
+    if (nxtcUnloadApplicationMetadataViewIcon(&view)) {
+        bytes = nullptr;
+    }
+}
+
+bool IconData::IsValidJpeg() const {
+    const unsigned char* jpeg = data();
+    if (!jpeg || length < 4) return false;
+
+    // 检查JPEG文件头和文件尾
+    // Check JPEG file header and trailer
+    bool has_jpeg_header = (jpeg[0] == 0xFF && jpeg[1] == 0xD8);
+    bool has_jpeg_trailer = (jpeg[length-2] == 0xFF && jpeg[length-1] == 0xD9);
+    return has_jpeg_header && has_jpeg_trailer;
+}
+
+IconData::~IconData() {
+    nxtcReleaseApplicationMetadataView(&view);
+}
+
+} // namespace tj
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <switch.h>
+#include <nxtc_version.h>
+
+namespace tj {
+
+/**
+ * 图标JPEG数据 - 来自标题缓存时直接引用缓存内的数据，不做复制；来自NS时持有一份副本
+ * Icon JPEG data - when it comes from the title cache it references the cache's own bytes without copying; when it
+ * comes from NS it holds a copy
+ *
+ * 借用的缓存条目在最后一个引用释放时归还，期间即使缓存更新该条目，数据也保持有效
+ * A borrowed cache entry is returned when the last reference goes away, and its data stays valid even if the cache
+ * updates the entry in the meantime
+ *
+ * 标题缓存按需加载时，图标字节在Load()中才从缓存文件读取，读取前size()已有效而data()为空
+ * With the title cache loaded lazily, the icon bytes are only read from the cache file in Load(); until then size()
+ * is already valid while data() is null
+ *
+ * 纹理上传后用Unload()释放从缓存文件读入的字节，纹理被淘汰后再次Load()时重新读取
+ * Once the texture is uploaded, Unload() frees the bytes read from the cache file, and they are read again by the
+ * next Load() after the texture is evicted
+ */
+class IconData {
+public:
+    /**
+     * 接管从标题缓存借用的条目视图
+     * Take over a view borrowed from the title cache
+     * @param view 已借用的视图，调用后被清空 (Borrowed view, cleared by the call)
+     * @return 条目没有图标时释放视图并返回空 (Releases the view and returns null if the entry has no icon)
+     */
+    static std::shared_ptr<const IconData> FromTitleCache(NxTitleCacheApplicationMetadataView& view);
+
+    /**
+     * 复制一份图标数据
+     * Copy icon data
+     */
+    static std::shared_ptr<const IconData> FromBytes(const void* data, size_t size);
+
+    IconData() = default;
+    ~IconData();
+    IconData(const IconData&) = delete;
+    IconData& operator=(const IconData&) = delete;
+
+    /**
+     * 确保图标字节已读入内存并锁定，可在任意线程调用
+     * Make sure the icon bytes are in memory and pin them, callable from any thread
+     * @return 持有期间data()有效且Unload()不会释放字节；读取失败或缓存数据损坏时返回未持有的锁
+     *         (While held, data() stays valid and Unload() won't free the bytes; an unheld lock is returned if the read
+     *         fails or the cached data is corrupted)
+     */
+    std::unique_lock<std::mutex> Load() const;
+
+    /**
+     * 释放从标题缓存读入的图标字节，正在被读取、自有副本或无法从缓存文件重新读取时保留
+     * Free the icon bytes read from the title cache, they are kept while pinned by Load(), for owned copies, or when they
+     * can't be read again from the cache file
+     */
+    void Unload() const;
+
+    /**
+     * 检查JPEG文件头和文件尾，需持有Load()返回的锁
+     * Check the JPEG header and trailer, the lock returned by Load() must be held
+     */
+    bool IsValidJpeg() const;
+
+    // 只在持有Load()返回的锁时有效 (Only valid while the lock returned by Load() is held)
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+private:
+    mutable std::mutex load_mutex;
+    mutable NxTitleCacheApplicationMetadataView view{}; // 借用的缓存条目 (Borrowed cache entry)
+    std::vector<unsigned char> owned;                   // 复制的数据 (Copied data)
+    mutable const unsigned char* bytes{nullptr};        // Load()之前或Unload()之后为空 (Null before Load() or after Unload())
+    size_t length{0};
+};
+
+using IconDataPtr = std::shared_ptr<const IconData>;
+
+} // namespace tj
@@ -0,0 +1,96 @@
+#include "icon_decoder.hpp"
+#include "nanovg/stb_image.h"
+
+namespace tj {
+
+void DecodedIcon::PixelDeleter::operator()(unsigned char* pixels) const {
+    stbi_image_free(pixels);
+}
+
+IconDecoder::~IconDecoder() {
+    Stop();
+}
+
+void IconDecoder::Submit(size_t unique_id, bool is_addgame, IconDataPtr jpeg_data, int priority) {
+    if (!jpeg_data || jpeg_data->empty()) {
+        return;
+    }
+
+    {
+        std::scoped_lock lock{mutex};
+        if (!in_flight.insert(unique_id).second) {
+            return; // 已在解码或等待上传 (Already decoding or waiting for upload)
+        }
+        requests.push(Request{unique_id, is_addgame, std::move(jpeg_data), priority, next_sequence++});
+
+        // 工作线程在第一次提交时才启动 (Workers start on the first submission)
+        if (workers.empty()) {
+            workers.reserve(WORKER_COUNT);
+            for (size_t i = 0; i < WORKER_COUNT; ++i) {
+                workers.emplace_back(util::async([this](std::stop_token stop_token) {
+                    this->Worker(stop_token);
+                }));
+            }
+        }
+    }
+    request_cv.notify_one();
+}
+
+void IconDecoder::Worker(std::stop_token stop_token) {
+    while (!stop_token.stop_requested()) {
+        Request request;
+        {
+            std::unique_lock lock{mutex};
+            if (!request_cv.wait(lock, stop_token, [this] { return !requests.empty(); })) {
+                return; // 请求停止 (Stop requested)
+            }
+            request = requests.top();
+            requests.pop();
+        }
+
+        // stb_image的错误信息是线程局部的，可以并行解码 (stb_image's failure reason is thread-local, safe to decode in parallel)
+        DecodedIcon icon;
+        icon.unique_id = request.unique_id;
+        icon.is_addgame = request.is_addgame;
+        int channels = 0;
+        // 标题缓存按需加载时，图标在这里才从SD卡读取，解码期间锁定字节 (With the title cache loaded lazily, the icon is read
+        // from the SD card here, and the bytes are pinned while decoding)
+        if (auto pinned = request.jpeg_data->Load(); pinned && request.jpeg_data->IsValidJpeg()) {
+            icon.pixels.reset(stbi_load_from_memory(request.jpeg_data->data(), static_cast<int>(request.jpeg_data->size()),
+                                                    &icon.width, &icon.height, &channels, 4));
+        }
+
+        std::scoped_lock lock{mutex};
+        decoded.push_back(std::move(icon));
+    }
+}
+
+bool IconDecoder::PopDecoded(DecodedIcon& icon) {
+    std::scoped_lock lock{mutex};
+    if (decoded.empty()) {
+        return false;
+    }
+
+    icon = std::move(decoded.front());
+    decoded.pop_front();
+    in_flight.erase(icon.unique_id);
+    return true;
+}
+
+void IconDecoder::Stop() {
+    // 先在锁外等待线程退出，再清空队列 (Join the workers outside the lock first, then clear the queues)
+    std::vector<util::AsyncFurture<void>> stopping;
+    {
+        std::scoped_lock lock{mutex};
+        stopping = std::move(workers);
+        workers.clear();
+    }
+    stopping.clear();
+
+    std::scoped_lock lock{mutex};
+    requests = {};
+    decoded.clear();
+    in_flight.clear();
+}
+
+} // namespace tj
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_set>
+#include <stop_token>
+#include <switch.h>
+#include "async.hpp"
+#include "icon_data.hpp"
+
+namespace tj {
+
+/**
+ * 解码完成的图标，RGBA像素由stb_image分配
+ * A decoded icon, RGBA pixels allocated by stb_image
+ */
+struct DecodedIcon {
+    struct PixelDeleter {
+        void operator()(unsigned char* pixels) const;
+    };
+
+    size_t unique_id{0};
+    bool is_addgame{false}; // 属于添加游戏列表 (Belongs to the AddGame list)
+    int width{0};
+    int height{0};
+    std::unique_ptr<unsigned char, PixelDeleter> pixels; // 解码失败时为空 (Empty if decoding failed)
+};
+
+/**
+ * 图标解码器 - 少量后台线程把JPEG解码为RGBA，界面线程只负责上传纹理
+ * Icon decoder - a few background threads decode JPEGs to RGBA, the UI thread only uploads the textures
+ *
+ * 优先级数值小的先解码，同优先级下最新提交的先解码，快速滚动时当前可见的图标不会排在已滚过的图标之后
+ * Lower priority values decode first, and within a priority the newest request goes first, so during fast scrolling
+ * the icons on screen never wait behind ones already scrolled past
+ */
+class IconDecoder {
+public:
+    static constexpr size_t WORKER_COUNT = 2;
+
+    ~IconDecoder();
+
+    /**
+     * 提交解码请求，同一unique_id在结果被取走前只会解码一次
+     * Submit a decode request, the same unique_id is decoded only once until its result is taken
+     * @param unique_id 条目ID (Entry ID)
+     * @param is_addgame 是否属于添加游戏列表 (Whether it belongs to the AddGame list)
+     * @param jpeg_data 图标JPEG数据 (Icon JPEG data)
+     * @param priority 优先级，数值越小越先解码 (Priority, lower values decode first)
+     */
+    void Submit(size_t unique_id, bool is_addgame, IconDataPtr jpeg_data, int priority);
+
+    /**
+     * 取出一个解码结果，不阻塞
+     * Take one decoded result without blocking
+     * @param icon 输出的解码结果 (Output decoded icon)
+     * @return 有结果返回true (Returns true if a result was available)
+     */
+    bool PopDecoded(DecodedIcon& icon);
+
+    /**
+     * 停止并等待所有工作线程退出，丢弃未完成的请求
+     * Stop and join all workers, dropping unfinished requests
+     */
+    void Stop();
+
+private:
+    struct Request {
+        size_t unique_id;
+        bool is_addgame;
+        IconDataPtr jpeg_data;
+        int priority;
+        u64 sequence;
+    };
+
+    struct RequestComparator {
+        bool operator()(const Request& a, const Request& b) const {
+            if (a.priority != b.priority) {
+                return a.priority > b.priority;
+            }
+            return a.sequence < b.sequence; // 新请求优先 (Newer requests first)
+        }
+    };
+
+    void Worker(std::stop_token stop_token);
+
+    std::mutex mutex;
+    std::condition_variable_any request_cv;
+    std::priority_queue<Request, std::vector<Request>, RequestComparator> requests;
+    std::deque<DecodedIcon> decoded;
+    std::unordered_set<size_t> in_flight; // 已提交但结果未被取走 (Submitted but result not yet taken)
+    u64 next_sequence{0};
+    std::vector<util::AsyncFurture<void>> workers;
+};
+
+} // namespace tj
@@ -0,0 +1,156 @@
+#include "install_journal.hpp"
+#include "install_manifest.hpp"
+#include <unistd.h>
+
+namespace tj {
+
+InstallJournal::~InstallJournal() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+bool InstallJournal::Begin(const std::string& mod_path) {
+    if (file) {
+        fclose(file);
+    }
+
+    file = fopen(JOURNAL_PATH, "wb");
+    if (!file) {
+        return false;
+    }
+    setvbuf(file, nullptr, _IOFBF, JOURNAL_BUFFER_SIZE);
+
+    std::string header;
+    manifest_io::AppendInt<u32>(header, JOURNAL_MAGIC);
+    manifest_io::AppendInt<u32>(header, JOURNAL_VERSION);
+    manifest_io::AppendInt<u16>(header, static_cast<u16>(mod_path.size()));
+    header.append(mod_path);
+
+    if (mod_path.size() > UINT16_MAX || fwrite(header.data(), 1, header.size(), file) != header.size()) {
+        End();
+        return false;
+    }
+    return true;
+}
+
+void InstallJournal::AppendRecord(u8 type, const std::string& path, const std::string& suffix) {
+    if (!file || path.size() > UINT16_MAX) {
+        return;
+    }
+
+    // 每条记录只追加到stdio缓冲区，Sync时一次性写入 (Each record only appends to the stdio buffer, written out in one go by Sync)
+    unsigned char record_header[3] = {type, static_cast<unsigned char>(path.size() & 0xFF), static_cast<unsigned char>(path.size() >> 8)};
+    fwrite(record_header, 1, sizeof(record_header), file);
+    fwrite(path.data(), 1, path.size(), file);
+    fwrite(suffix.data(), 1, suffix.size(), file);
+}
+
+void InstallJournal::RecordDirectory(const std::string& dir_path) {
+    AppendRecord(RECORD_DIRECTORY, dir_path);
+}
+
+void InstallJournal::RecordFile(const std::string& file_path) {
+    AppendRecord(RECORD_FILE, file_path);
+}
+
+void InstallJournal::RecordSharedFile(const std::string& file_path, u32 previous_count) {
+    std::string count;
+    manifest_io::AppendInt<u32>(count, previous_count);
+    AppendRecord(RECORD_SHARED_FILE, file_path, count);
+}
+
+bool InstallJournal::Sync() {
+    if (!file) {
+        return false;
+    }
+
+    if (fflush(file) != 0 || ferror(file)) {
+        return false;
+    }
+    return fsync(fileno(file)) == 0;
+}
+
+void InstallJournal::Close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+void InstallJournal::End() {
+    Close();
+    Remove();
+}
+
+bool InstallJournal::ReadPending(std::string& mod_path, std::vector<std::string>& files, std::vector<std::string>& directories,
+                                 std::vector<std::pair<std::string, u32>>& shared_counts) {
+    mod_path.clear();
+    files.clear();
+    directories.clear();
+    shared_counts.clear();
+
+    FILE* journal_file = fopen(JOURNAL_PATH, "rb");
+    if (!journal_file) {
+        return false;
+    }
+
+    fseek(journal_file, 0, SEEK_END);
+    long file_size = ftell(journal_file);
+    fseek(journal_file, 0, SEEK_SET);
+
+    std::string buffer;
+    if (file_size > 0) {
+        buffer.resize(static_cast<size_t>(file_size));
+        buffer.resize(fread(buffer.data(), 1, buffer.size(), journal_file));
+    }
+    fclose(journal_file);
+
+    size_t offset = 0;
+    u32 magic = 0;
+    u32 version = 0;
+    u16 mod_path_length = 0;
+    if (!manifest_io::ReadInt<u32>(buffer, offset, magic) || magic != JOURNAL_MAGIC ||
+        !manifest_io::ReadInt<u32>(buffer, offset, version) || version != JOURNAL_VERSION ||
+        !manifest_io::ReadInt<u16>(buffer, offset, mod_path_length) ||
+        offset + mod_path_length > buffer.size()) {
+        return false;
+    }
+    mod_path.assign(buffer.data() + offset, mod_path_length);
+    offset += mod_path_length;
+
+    // 断电时尾部可能不完整，读到第一条不完整或未知的记录为止 (The tail may be incomplete after a power loss, stop at the first incomplete or unknown record)
+    while (offset < buffer.size()) {
+        u8 type = 0;
+        u16 path_length = 0;
+        if (!manifest_io::ReadInt<u8>(buffer, offset, type) ||
+            (type != RECORD_DIRECTORY && type != RECORD_FILE && type != RECORD_SHARED_FILE) ||
+            !manifest_io::ReadInt<u16>(buffer, offset, path_length) ||
+            offset + path_length > buffer.size()) {
+            break;
+        }
+
+        std::string path(buffer.data() + offset, path_length);
+        offset += path_length;
+        if (type == RECORD_FILE) {
+            files.push_back(std::move(path));
+        } else if (type == RECORD_DIRECTORY) {
+            directories.push_back(std::move(path));
+        } else {
+            u32 previous_count = 0;
+            if (!manifest_io::ReadInt<u32>(buffer, offset, previous_count)) {
+                break;
+            }
+            shared_counts.emplace_back(std::move(path), previous_count);
+        }
+    }
+
+    return true;
+}
+
+void InstallJournal::Remove() {
+    std::remove(JOURNAL_PATH);
+}
+
+} // namespace tj
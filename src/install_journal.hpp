@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+#include <switch.h>
+
+namespace tj {
+
+/**
+ * 安装日志 - 安装开始写入目标目录之前，先把将要创建的目录和文件追加写入SD卡
+ * Install journal - before an install writes into the target directory, the directories and files it will create are
+ * appended to the SD card
+ *
+ * 安装成功或回滚完成后删除日志；启动时日志仍存在说明上次安装中途断电或崩溃，按日志删除残留文件
+ * The journal is removed once the install succeeds or its rollback finishes; a journal still present at launch means
+ * the last install was cut off by a crash or power loss, and its leftovers are removed from the journal
+ *
+ * 安装会增加mod_file_common.json中的共用计数：提交账本之前先记录每个共用文件原来的计数，恢复时把计数设回原值，
+ * 不论账本是否已经提交都得到安装前的状态
+ * An install raises the shared counts in mod_file_common.json: the previous count of every shared file is journaled
+ * before the ledger is committed, and recovery sets the counts back, which gives the pre-install state whether or not
+ * the commit landed
+ *
+ * 文件格式 (File format):
+ *   header  : magic u32, version u32, mod_path_length u16, mod_path
+ *   records : [type u8, path_length u16, path]...
+ *             共用文件记录在path之后追加原计数u32 (Shared-file records append the previous count u32 after the path)
+ * 只追加写入，尾部不完整的记录在恢复时忽略 (Append-only, an incomplete trailing record is ignored on recovery)
+ */
+class InstallJournal {
+public:
+    static constexpr const char* JOURNAL_PATH = "/mods2/install_journal.bin";
+
+    ~InstallJournal();
+
+    /**
+     * 开始一次安装事务，覆盖旧日志
+     * Begin an install transaction, overwriting any old journal
+     * @param mod_path MOD目录路径或MOD内ZIP文件路径 (MOD directory path or ZIP path inside the MOD)
+     * @return 成功返回true，失败时不能继续安装 (Returns true on success; the install must not proceed on failure)
+     */
+    bool Begin(const std::string& mod_path);
+
+    /**
+     * 记录将要创建的目录
+     * Record a directory about to be created
+     */
+    void RecordDirectory(const std::string& dir_path);
+
+    /**
+     * 记录将要写入的文件
+     * Record a file about to be written
+     */
+    void RecordFile(const std::string& file_path);
+
+    /**
+     * 记录共用计数将要改变的文件及其原计数
+     * Record a file whose shared count is about to change, with its previous count
+     */
+    void RecordSharedFile(const std::string& file_path, u32 previous_count);
+
+    /**
+     * 将已记录的内容刷新到SD卡，必须在写入目标目录之前调用
+     * Flush recorded content to the SD card, must be called before writing into the target directory
+     * @return 成功返回true (Returns true on success)
+     */
+    bool Sync();
+
+    /**
+     * 停止写入但保留日志，之后由ReadPending读取并回滚（安装取消或出错时调用）
+     * Stop writing but keep the journal, so ReadPending can read it back for the rollback (call when the install is
+     * cancelled or fails)
+     */
+    void Close();
+
+    /**
+     * 结束事务并删除日志（安装成功或回滚完成后调用）
+     * End the transaction and remove the journal (call after the install succeeds or its rollback finishes)
+     */
+    void End();
+
+    /**
+     * 读取上次未结束的安装日志
+     * Read the journal of an install that never finished
+     * @param mod_path 输出MOD路径 (Output MOD path)
+     * @param files 输出文件路径，按记录顺序 (Output file paths, in record order)
+     * @param directories 输出目录路径，按记录顺序 (Output directory paths, in record order)
+     * @param shared_counts 输出共用文件及其安装前的计数 (Output shared files with their pre-install counts)
+     * @return 存在有效日志返回true (Returns true if a valid journal exists)
+     */
+    static bool ReadPending(std::string& mod_path, std::vector<std::string>& files, std::vector<std::string>& directories,
+                            std::vector<std::pair<std::string, u32>>& shared_counts);
+
+    /**
+     * 删除日志文件
+     * Remove the journal file
+     */
+    static void Remove();
+
+private:
+    static constexpr u32 JOURNAL_MAGIC = 0x314A494D; // "MIJ1"
+    static constexpr u32 JOURNAL_VERSION = 1;
+    static constexpr u8 RECORD_DIRECTORY = 'D';
+    static constexpr u8 RECORD_FILE = 'F';
+    static constexpr u8 RECORD_SHARED_FILE = 'S';
+    static constexpr size_t JOURNAL_BUFFER_SIZE = 64 * 1024;
+
+    void AppendRecord(u8 type, const std::string& path, const std::string& suffix = std::string());
+
+    FILE* file{nullptr};
+};
+
+} // namespace tj
@@ -0,0 +1,142 @@
+#include "install_manifest.hpp"
+#include "atomic_file.hpp"
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+namespace tj {
+
+namespace manifest_io {
+
+bool WriteFileAtomic(const std::string& path, std::string& buffer) {
+    AppendInt<u32>(buffer, crc32CalculateWithSeed(0, buffer.data(), buffer.size()));
+    return atomic_file::Write(path, buffer.data(), buffer.size());
+}
+
+bool ReadFileVerified(const std::string& path, std::string& buffer) {
+    buffer.clear();
+
+    // 上次替换在删除旧文件后中断时，从临时文件恢复 (Restore from the temp file if the last replace was interrupted after
+    // the old file was removed)
+    atomic_file::Recover(path);
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (file_size < 4) {
+        fclose(file);
+        return false;
+    }
+
+    buffer.resize(static_cast<size_t>(file_size));
+    size_t bytes_read = fread(buffer.data(), 1, buffer.size(), file);
+    fclose(file);
+    if (bytes_read != buffer.size()) {
+        return false;
+    }
+
+    size_t trailer_offset = buffer.size() - 4;
+    u32 stored_crc32 = 0;
+    if (!ReadInt<u32>(buffer, trailer_offset, stored_crc32) ||
+        stored_crc32 != crc32CalculateWithSeed(0, buffer.data(), buffer.size() - 4)) {
+        buffer.clear();
+        return false;
+    }
+
+    buffer.resize(buffer.size() - 4);
+    return true;
+}
+
+} // namespace manifest_io
+
+bool InstallManifest::Write(const std::string& manifest_path, u64 source_fingerprint, const std::vector<InstallManifestEntry>& entries) {
+    // 在内存中构建完整文件，一次写入 (Build the whole file in memory and write it in one go)
+    size_t total_size = 24 + 4;
+    for (const auto& entry : entries) {
+        total_size += 14 + entry.target_path.size();
+    }
+
+    std::string buffer;
+    buffer.reserve(total_size);
+    manifest_io::AppendInt<u32>(buffer, MANIFEST_MAGIC);
+    manifest_io::AppendInt<u32>(buffer, MANIFEST_VERSION);
+    manifest_io::AppendInt<u64>(buffer, source_fingerprint);
+    manifest_io::AppendInt<u32>(buffer, static_cast<u32>(entries.size()));
+
+    for (const auto& entry : entries) {
+        if (entry.target_path.size() > UINT16_MAX) {
+            return false;
+        }
+        manifest_io::AppendInt<u32>(buffer, entry.crc32);
+        manifest_io::AppendInt<u64>(buffer, entry.size);
+        manifest_io::AppendInt<u16>(buffer, static_cast<u16>(entry.target_path.size()));
+        buffer.append(entry.target_path);
+    }
+
+    return manifest_io::WriteFileAtomic(manifest_path, buffer);
+}
+
+bool InstallManifest::Read(const std::string& manifest_path, u64 source_fingerprint, std::vector<InstallManifestEntry>& entries) {
+    entries.clear();
+
+    // 截断或损坏的清单视为过期 (A truncated or corrupt manifest is stale)
+    std::string buffer;
+    if (!manifest_io::ReadFileVerified(manifest_path, buffer)) {
+        return false;
+    }
+
+    size_t offset = 0;
+    u32 magic = 0;
+    u32 version = 0;
+    u64 fingerprint = 0;
+    u32 entry_count = 0;
+    if (!manifest_io::ReadInt<u32>(buffer, offset, magic) || magic != MANIFEST_MAGIC ||
+        !manifest_io::ReadInt<u32>(buffer, offset, version) || version != MANIFEST_VERSION ||
+        !manifest_io::ReadInt<u64>(buffer, offset, fingerprint) || fingerprint != source_fingerprint ||
+        !manifest_io::ReadInt<u32>(buffer, offset, entry_count)) {
+        return false;
+    }
+
+    entries.reserve(entry_count);
+    for (u32 i = 0; i < entry_count; ++i) {
+        InstallManifestEntry entry;
+        u16 path_length = 0;
+        if (!manifest_io::ReadInt<u32>(buffer, offset, entry.crc32) ||
+            !manifest_io::ReadInt<u64>(buffer, offset, entry.size) ||
+            !manifest_io::ReadInt<u16>(buffer, offset, path_length) ||
+            offset + path_length > buffer.size()) {
+            entries.clear();
+            return false;
+        }
+        entry.target_path.assign(buffer.data() + offset, path_length);
+        offset += path_length;
+        entries.push_back(std::move(entry));
+    }
+
+    if (offset != buffer.size()) {
+        entries.clear();
+        return false;
+    }
+    return true;
+}
+
+void InstallManifest::Remove(const std::string& manifest_path) {
+    atomic_file::Remove(manifest_path);
+}
+
+u64 InstallManifest::GetFileFingerprint(const std::string& source_path) {
+    struct stat st;
+    if (stat(source_path.c_str(), &st) != 0) {
+        return 0;
+    }
+    // 高32位为修改时间，低32位为文件大小 (Upper 32 bits are the modification time, lower 32 bits the file size)
+    return (static_cast<u64>(static_cast<u32>(st.st_mtime)) << 32) | static_cast<u32>(st.st_size);
+}
+
+} // namespace tj
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <switch.h>
+
+namespace tj {
+
+// 清单类二进制文件的小端序读写辅助 (Little-endian read/write helpers for manifest-style binary files)
+namespace manifest_io {
+
+template <typename T>
+inline void AppendInt(std::string& buffer, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+}
+
+// 越界返回false (Returns false when out of bounds)
+template <typename T>
+inline bool ReadInt(const std::string& buffer, size_t& offset, T& value) {
+    if (offset + sizeof(T) > buffer.size()) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<T>(static_cast<unsigned char>(buffer[offset + i])) << (i * 8);
+    }
+    offset += sizeof(T);
+    return true;
+}
+
+/**
+ * 追加尾部CRC32后通过atomic_file原子写入文件
+ * Append the trailer CRC32 and write the file atomically through atomic_file
+ * @param path 文件路径 (File path)
+ * @param buffer 文件内容，会被追加尾部CRC32 (File content, the trailer CRC32 is appended to it)
+ * @return 成功返回true，失败返回false (Returns true on success, false on failure)
+ */
+bool WriteFileAtomic(const std::string& path, std::string& buffer);
+
+/**
+ * 读取整个文件并校验、去掉尾部CRC32，读取前先恢复遗留的临时文件
+ * Read a whole file, verify and strip the trailer CRC32, restoring a leftover temp file first
+ * @param path 文件路径 (File path)
+ * @param buffer 输出的文件内容（不含尾部） (Output file content without the trailer)
+ * @return 文件存在且校验通过返回true (Returns true if the file exists and verifies)
+ */
+bool ReadFileVerified(const std::string& path, std::string& buffer);
+
+} // namespace manifest_io
+
+/**
+ * 安装清单条目 - 一个已安装到atmosphere目录的文件
+ * Install manifest entry - one file installed into the atmosphere directory
+ */
+struct InstallManifestEntry {
+    std::string target_path; // 目标文件完整路径 (Full target file path)
+    u64 size;                // 文件大小 (File size)
+    u32 crc32;               // 文件CRC32 (File CRC32)
+};
+
+/**
+ * 安装清单 - 每个已安装MOD保存一份紧凑的二进制文件列表，卸载时直接回放，无需遍历MOD目录或重新打开ZIP
+ * Install manifest - a compact binary file list saved per installed MOD, replayed directly on uninstall without walking
+ * the MOD directory or reopening the ZIP
+ *
+ * 文件格式 (File format):
+ *   header  : magic u32, version u32, source_fingerprint u64, entry_count u32
+ *   entries : crc32 u32, size u64, path_length u16, path (目标文件完整路径) (full target path)
+ *   trailer : 以上所有字节的CRC32 u32 (CRC32 of all preceding bytes)
+ */
+class InstallManifest {
+public:
+    /**
+     * 原子写入安装清单（先写临时文件再重命名）
+     * Write install manifest atomically (write a temp file then rename)
+     * @param manifest_path 清单文件路径 (Manifest file path)
+     * @param source_fingerprint MOD来源指纹，用于检测清单是否过期 (MOD source fingerprint used to detect a stale manifest)
+     * @param entries 已安装文件列表 (Installed file list)
+     * @return 成功返回true，失败返回false (Returns true on success, false on failure)
+     */
+    static bool Write(const std::string& manifest_path, u64 source_fingerprint, const std::vector<InstallManifestEntry>& entries);
+
+    /**
+     * 读取安装清单，文件缺失、损坏、版本不符或指纹不匹配时视为过期
+     * Read install manifest, a missing, corrupt, wrong-version or fingerprint-mismatched file is treated as stale
+     * @param manifest_path 清单文件路径 (Manifest file path)
+     * @param source_fingerprint 当前MOD来源指纹 (Current MOD source fingerprint)
+     * @param entries 输出的文件列表 (Output file list)
+     * @return 清单有效返回true，过期返回false (Returns true if the manifest is valid, false if stale)
+     */
+    static bool Read(const std::string& manifest_path, u64 source_fingerprint, std::vector<InstallManifestEntry>& entries);
+
+    /**
+     * 删除安装清单及其临时文件
+     * Remove install manifest and its temp file
+     * @param manifest_path 清单文件路径 (Manifest file path)
+     */
+    static void Remove(const std::string& manifest_path);
+
+    /**
+     * 计算文件来源指纹（文件大小和修改时间），文件不存在返回0
+     * Compute a file source fingerprint (file size and modification time), returns 0 if the file does not exist
+     * @param source_path MOD来源文件路径 (MOD source file path)
+     * @return 来源指纹 (Source fingerprint)
+     */
+    static u64 GetFileFingerprint(const std::string& source_path);
+
+private:
+    static constexpr u32 MANIFEST_MAGIC = 0x31464D4D; // "MMF1"
+    static constexpr u32 MANIFEST_VERSION = 1;
+};
+
+} // namespace tj
@@ -1,6 +1,9 @@
 #include "json_manager.hpp"
+#include "atomic_file.hpp"
 #include <cstdio>
 #include <cstring>
+#include <cstdlib>
+#include <climits>
 #include <vector>
 #include <sys/stat.h>
 
@@ -505,6 +508,25 @@ bool JsonManager::WriteJsonFile(const std::string& json_path, yyjson_mut_doc* mu
     return written == json_len;
 }
 
+// 原子写入JSON文档：写入临时文件后重命名，中途断电不会留下半截文件
+// Atomically write JSON document: write a temp file then rename, power loss never leaves a truncated file
+bool JsonManager::WriteJsonFileAtomic(const std::string& json_path, yyjson_mut_doc* mut_doc, bool pretty_format) {
+    if (!mut_doc) return false;
+
+    // 生成JSON字符串 (Generate JSON string)
+    yyjson_write_flag flag = pretty_format ? YYJSON_WRITE_PRETTY : 0;
+    size_t json_len = 0;
+    char* json_str = yyjson_mut_write(mut_doc, flag, &json_len);
+    yyjson_mut_doc_free(mut_doc);
+    if (!json_str) {
+        return false;
+    }
+
+    bool success = atomic_file::Write(json_path, json_str, json_len);
+    free(json_str);
+    return success;
+}
+
 // 获取根级JSON键的值，如果键不存在则返回键名本身
 // Get root-level JSON key value, return key name if key doesn't exist
 std::string JsonManager::GetRootJsonValue(const std::string& json_path, const std::string& key) {
@@ -644,30 +666,52 @@ std::string JsonManager::GetNestedJsonValue(const std::string& json_path, const
 bool JsonManager::ProcessModFileCommonDeduplication(const std::string& json_path, 
                                                     std::vector<std::string>& target_files) {
     
-    // 读取JSON文件 (Read JSON file)
-    yyjson_doc* doc = nullptr;
-    if (!ReadJsonFile(json_path, &doc)) {
-        // JSON文件不存在或读取失败，所有文件都可以删除，保持原列表不变 (JSON file doesn't exist or read failed, all files can be deleted, keep original list unchanged)
+    // 一次性读取账本，所有计数修改都在内存中完成 (Load the ledger once, all count changes happen in memory)
+    ModFileCommonLedger ledger(json_path);
+    if (ledger.Size() == 0) {
+        // JSON文件不存在、无效或为空，所有文件都可以删除，保持原列表不变 (Missing, invalid or empty JSON, all files can be deleted, keep original list unchanged)
         return true;
     }
     
-    // 获取根对象 (Get root object)
-    yyjson_val* root = yyjson_doc_get_root(doc);
-    if (!root || !yyjson_is_obj(root)) {
-        yyjson_doc_free(doc);
-        // 根对象无效，所有文件都可以删除，保持原列表不变 (Invalid root object, all files can be deleted, keep original list unchanged)
-        return true;
+    // 处理去重和计数修改，直接修改target_files列表 (Process deduplication and count modification, modify target_files list directly)
+    std::vector<std::string> files_to_keep; // 实际需要删除的文件 (Files that actually need to be deleted)
+    files_to_keep.reserve(target_files.size());
+    
+    for (auto& file_path : target_files) {
+        // 文件仍被其他MOD共用则保留，否则直接删除 (Keep files still shared by other MODs, delete the rest)
+        if (!ledger.Release(file_path)) {
+            files_to_keep.push_back(std::move(file_path));
+        }
+    }
+    
+    // 直接修改输入的target_files列表 (Modify input target_files list directly)
+    target_files = std::move(files_to_keep);
+    
+    // 一次性写回，账本为空时删除JSON文件 (Write back once, delete JSON file when the ledger is empty)
+    return ledger.Commit();
+}
+
+ModFileCommonLedger::ModFileCommonLedger(const std::string& json_path)
+    : json_path(json_path) {
+    
+    // 上次提交在删除旧文件后中断时，从临时文件恢复 (Restore from the temp file if the last commit was interrupted
+    // after the old file was removed)
+    atomic_file::Recover(json_path);
+
+    // 读取JSON文件，不存在或读取失败时保持空账本 (Read JSON file, keep an empty ledger if missing or unreadable)
+    yyjson_doc* doc = nullptr;
+    if (!JsonManager::ReadJsonFile(json_path, &doc)) {
+        return;
     }
     
-    // 检查JSON对象是否为空 (Check if JSON object is empty)
-    if (yyjson_obj_size(root) == 0) {
+    yyjson_val* root = yyjson_doc_get_root(doc);
+    if (!root || !yyjson_is_obj(root)) {
         yyjson_doc_free(doc);
-        // JSON文件为空，所有文件都可以删除，保持原列表不变 (JSON file is empty, all files can be deleted, keep original list unchanged)
-        return true;
+        return;
     }
     
     // 将JSON内容加载到内存map中 (Load JSON content into memory map)
-    std::unordered_map<std::string, int> common_files_map;
+    common_files_map.reserve(yyjson_obj_size(root));
     yyjson_obj_iter iter = yyjson_obj_iter_with(root);
     yyjson_val *key, *val;
     while ((key = yyjson_obj_iter_next(&iter))) {
@@ -688,37 +732,54 @@ bool JsonManager::ProcessModFileCommonDeduplication(const std::string& json_path
     }
     
     yyjson_doc_free(doc);
-    
-    // 处理去重和计数修改，直接修改target_files列表 (Process deduplication and count modification, modify target_files list directly)
-    std::vector<std::string> files_to_keep; // 实际需要删除的文件 (Files that actually need to be deleted)
-    
-    for (const auto& file_path : target_files) {
-        auto it = common_files_map.find(file_path);
-        if (it != common_files_map.end()) {
-            // 文件在公用列表中，计数减1 (File is in common list, decrease count by 1)
-            it->second--;
-            if (it->second <= 0) {
-                // 计数为0或负数，可以删除JSON条目 (Count is 0 or negative, can delete file and JSON entry)
-                common_files_map.erase(it); // 从map中移除 (Remove from map)
-            }
-            // 如果计数>0，就什么都不管，重新写入进去
-        } else {
-            // 文件不在公用列表中，直接删除 (File is not in common list, delete directly)
-            files_to_keep.push_back(file_path);
-        }
+}
+
+void ModFileCommonLedger::Acquire(const std::string& target_file) {
+    // 不存在时插入0后加1，与原先"默认为1"的语义一致 (Absent entries start at 0 then increment, matching the old "default to 1")
+    common_files_map[target_file]++;
+    dirty = true;
+}
+
+bool ModFileCommonLedger::Release(const std::string& target_file) {
+    auto it = common_files_map.find(target_file);
+    if (it == common_files_map.end()) {
+        return false;
     }
     
-    // 直接修改输入的target_files列表 (Modify input target_files list directly)
-    target_files = std::move(files_to_keep);
+    // 文件在公用列表中，计数减1，归零时移除条目 (File is in common list, decrease count, remove entry at zero)
+    if (--it->second <= 0) {
+        common_files_map.erase(it);
+    }
+    dirty = true;
+    return true;
+}
+
+int ModFileCommonLedger::GetCount(const std::string& target_file) const {
+    auto it = common_files_map.find(target_file);
+    return it == common_files_map.end() ? 0 : it->second;
+}
+
+void ModFileCommonLedger::SetCount(const std::string& target_file, int count) {
+    if (count > 0) {
+        common_files_map[target_file] = count;
+    } else {
+        common_files_map.erase(target_file);
+    }
+    dirty = true;
+}
+
+bool ModFileCommonLedger::Commit() {
+    if (!dirty) {
+        return true;
+    }
     
-    // 检查map是否为空，如果为空则删除JSON文件 (Check if map is empty, delete JSON file if empty)
+    // 账本为空时删除JSON文件 (Delete JSON file when the ledger is empty)
     if (common_files_map.empty()) {
-        // 删除JSON文件 (Delete JSON file)
-        std::remove(json_path.c_str());
+        atomic_file::Remove(json_path);
+        dirty = false;
         return true;
     }
     
-    // 重新写入JSON文件 (Rewrite JSON file)
     // 创建新的JSON文档 (Create new JSON document)
     yyjson_mut_doc* mut_doc = yyjson_mut_doc_new(NULL);
     if (!mut_doc) return false;
@@ -730,20 +791,24 @@ bool JsonManager::ProcessModFileCommonDeduplication(const std::string& json_path
     }
     yyjson_mut_doc_set_root(mut_doc, mut_root);
     
-    // 将更新后的map内容写入JSON (Write updated map content to JSON)
+    // 将map内容写入JSON，键值均复制到文档内存中 (Write map content to JSON, copying keys and values into document memory)
+    char count_buf[16];
     for (const auto& pair : common_files_map) {
-        yyjson_mut_val* key_val = yyjson_mut_str(mut_doc, pair.first.c_str());
-        // 将整数转换为字符串并复制到文档内存中 (Convert integer to string and copy to document memory)
-        std::string count_str = std::to_string(pair.second);
-        yyjson_mut_val* val_val = yyjson_mut_strcpy(mut_doc, count_str.c_str());
-        if (!key_val || !val_val || !yyjson_mut_obj_put(mut_root, key_val, val_val)) {
+        snprintf(count_buf, sizeof(count_buf), "%d", pair.second);
+        yyjson_mut_val* key_val = yyjson_mut_strncpy(mut_doc, pair.first.c_str(), pair.first.size());
+        yyjson_mut_val* val_val = yyjson_mut_strcpy(mut_doc, count_buf);
+        if (!key_val || !val_val || !yyjson_mut_obj_add(mut_root, key_val, val_val)) {
             yyjson_mut_doc_free(mut_doc);
             return false;
         }
     }
     
-    // 写入文件 (Write to file)
-    return WriteJsonFile(json_path, mut_doc, true);
+    if (!JsonManager::WriteJsonFileAtomic(json_path, mut_doc, true)) {
+        return false;
+    }
+    
+    dirty = false;
+    return true;
 }
 
 } // namespace tj
\ No newline at end of file
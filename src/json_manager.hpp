@@ -131,6 +131,16 @@ public:
      */
     static bool WriteJsonFile(const std::string& json_path, yyjson_mut_doc* mut_doc, bool pretty_format = true);
 
+    /**
+     * 原子写入JSON文档：先写入临时文件，再重命名覆盖目标文件
+     * Atomically write JSON document: write to a temp file, then rename over the target
+     * @param json_path JSON文件路径 (JSON file path)
+     * @param mut_doc JSON文档指针，函数内部释放 (JSON document pointer, freed by this function)
+     * @param pretty_format 是否格式化输出 (Whether to format output)
+     * @return 成功返回true，失败返回false (Returns true on success, false on failure)
+     */
+    static bool WriteJsonFileAtomic(const std::string& json_path, yyjson_mut_doc* mut_doc, bool pretty_format = true);
+
 private:
     // 私有构造函数，防止实例化 (Private constructor to prevent instantiation)
     JsonManager() = delete;
@@ -139,4 +149,62 @@ private:
     JsonManager& operator=(const JsonManager&) = delete;
 };
 
+/**
+ * mod_file_common.json 共享文件计数账本 - 一次读取，内存中批量增减计数，一次原子提交
+ * mod_file_common.json shared-file ledger - load once, batch count updates in memory, commit once atomically
+ */
+class ModFileCommonLedger {
+public:
+    /**
+     * 读取账本文件，文件不存在或无效时视为空账本
+     * Load ledger file, a missing or invalid file is treated as an empty ledger
+     * @param json_path mod_file_common.json文件路径 (mod_file_common.json file path)
+     */
+    explicit ModFileCommonLedger(const std::string& json_path);
+
+    /**
+     * 安装时记录一个共享文件：不存在则计数为1，存在则计数加1
+     * Record a shared file on install: count becomes 1 if absent, otherwise increments
+     * @param target_file 目标文件路径 (Target file path)
+     */
+    void Acquire(const std::string& target_file);
+
+    /**
+     * 卸载时释放一个共享文件：存在则计数减1（归零时移除条目）
+     * Release a shared file on uninstall: decrement if present (entry removed when it reaches zero)
+     * @param target_file 目标文件路径 (Target file path)
+     * @return 文件仍被其他MOD使用返回true，可以删除返回false (Returns true if still used by another MOD, false if it can be deleted)
+     */
+    bool Release(const std::string& target_file);
+
+    /**
+     * 查询共享文件的当前计数，不在账本中返回0
+     * Get the current count of a shared file, 0 if it is not in the ledger
+     * @param target_file 目标文件路径 (Target file path)
+     */
+    int GetCount(const std::string& target_file) const;
+
+    /**
+     * 直接设置共享文件的计数，0表示移除条目（用于回滚安装）
+     * Set the count of a shared file directly, 0 removes the entry (used to roll back an install)
+     * @param target_file 目标文件路径 (Target file path)
+     * @param count 新计数 (New count)
+     */
+    void SetCount(const std::string& target_file, int count);
+
+    /**
+     * 将内存中的修改一次性原子写回，账本为空时删除文件
+     * Write in-memory changes back atomically in one go, delete the file when the ledger is empty
+     * @return 成功返回true，失败返回false (Returns true on success, false on failure)
+     */
+    bool Commit();
+
+    size_t Size() const { return common_files_map.size(); }
+
+private:
+    std::string json_path;
+    std::unordered_map<std::string, int> common_files_map; // 目标路径 -> 共享计数 (Target path -> share count)
+    bool dirty{false};
+};
+
 } // namespace tj
\ No newline at end of file
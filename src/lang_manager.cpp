@@ -66,6 +66,7 @@ std::string ZIP_READ_ERROR;
 std::string CANT_READ_ERROR;
 std::string CANT_CREATE_ERROR;
 std::string CANT_WRITE_ERROR;
+std::string NOT_ENOUGH_SPACE;
 std::string Aggregating_Files;
 std::string Add_Mod_BUTTON;
 std::string BUTTON_CANCEL;
@@ -390,6 +391,7 @@ bool LangManager::loadLanguage(const std::string& langCode) {
             {"CANT_READ_ERROR", std::ref(CANT_READ_ERROR)},
             {"CANT_CREATE_ERROR", std::ref(CANT_CREATE_ERROR)},
             {"CANT_WRITE_ERROR", std::ref(CANT_WRITE_ERROR)},
+            {"NOT_ENOUGH_SPACE", std::ref(NOT_ENOUGH_SPACE)},
             {"Aggregating_Files", std::ref(Aggregating_Files)},
             {"Add_Mod_BUTTON", std::ref(Add_Mod_BUTTON)},
             {"BUTTON_CANCEL", std::ref(BUTTON_CANCEL)},
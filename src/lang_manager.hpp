@@ -66,6 +66,7 @@ extern std::string ZIP_READ_ERROR;
 extern std::string CANT_READ_ERROR;
 extern std::string CANT_CREATE_ERROR;
 extern std::string CANT_WRITE_ERROR;
+extern std::string NOT_ENOUGH_SPACE;
 extern std::string Aggregating_Files;
 extern std::string Add_Mod_BUTTON;
 extern std::string BUTTON_CANCEL;
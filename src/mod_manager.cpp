@@ -1,12 +1,17 @@
 #include "mod_manager.hpp"
 #include "lang_manager.hpp"
 #include "json_manager.hpp"  // 添加JSON管理器头文件
-#include "audio_manager.hpp"  // 添加音效管理器头文件
+#include "install_manifest.hpp"  // 安装清单 (Install manifest)
+#include "conflict_index.hpp"  // 冲突索引 (Conflict index)
+#include "install_journal.hpp"  // 安装日志 (Install journal)
+#include "atomic_file.hpp"  // 原子文件写入 (Atomic file writes)
 #include "miniz/miniz.h"
+#include "async.hpp"  // 流水线解压线程 (Pipelined extraction thread)
 // #include "utils/logger.hpp"  // 添加日志头文件
 #include <switch.h>
 #include <dirent.h>
 #include <sys/stat.h>
+#include <sys/statvfs.h>  // 剩余空间检查 (Free space check)
 #include <unistd.h>
 #include <errno.h>
 #include <cstring>
@@ -16,6 +21,11 @@
 #include <set>
 #include <cstdlib>  // for free
 #include <malloc.h>  // for memalign
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <string_view>
+#include <unordered_set>
 
 // 定义静态成员变量 (Define static member variable)
 const std::string ModManager::target_directory_zip = "/atmosphere/";
@@ -24,6 +34,10 @@ const std::string ModManager::target_directory_zip = "/atmosphere/";
 const int ModManager::COLOR_BLUE[3] = {0, 150, 255};
 const int ModManager::COLOR_RED[3] = {255, 0, 0};
 
+// 安装计划估算空间用的簇大小 (Cluster sizes used by install plans to estimate space)
+constexpr u64 MIN_CLUSTER_SIZE = 512;               // 小于一个扇区的f_frsize视为无效 (An f_frsize below one sector is not credible)
+constexpr u64 DEFAULT_CLUSTER_SIZE = 32 * 1024;     // SD卡exFAT的常见簇大小 (Common exFAT cluster size of SD cards)
+
 
 ModManager::ModManager() {
     // 构造函数
@@ -66,8 +80,6 @@ bool ModManager::extractMod(const std::string& zip_path,
     char* aligned_buffer = nullptr;
     mz_zip_reader_extract_iter_state* iter_state = nullptr;
     FILE* dest_file = nullptr;
-    bool is_error = false;
-    bool is_stopped = false;
     
     // 分配块对齐缓冲区 (Allocate block-aligned buffers)
     aligned_buffer = (char*)memalign(SD_BLOCK_SIZE, ALIGNED_BUFFER_SIZE + SD_BLOCK_SIZE);
@@ -79,13 +91,10 @@ bool ModManager::extractMod(const std::string& zip_path,
         return false;
     }
     
-    // 用于存储已复制的文件路径，即使这个文件没有真的被复制。
-    std::vector<std::string> extracted_files;
     // 只解压过滤后的文件索引 (Extract only filtered file indices)
     for (int i = 0; i < num_files; i++) {
         // 检查是否需要停止 (Check if stop is requested)
         if (stop_token.stop_requested()) {
-            is_stopped = true;
             goto cleanup;
         }
         
@@ -94,7 +103,6 @@ bool ModManager::extractMod(const std::string& zip_path,
         
         mz_zip_archive_file_stat file_stat;
         if (!mz_zip_reader_file_stat(zip_archive, file_index, &file_stat)) {
-            is_error = true;
             if (error_callback) {
                 error_callback(ZIP_READ_ERROR + zip_path);
             }
@@ -105,20 +113,16 @@ bool ModManager::extractMod(const std::string& zip_path,
         
         // 构建完整的目标文件路径 (Build complete target file path)
         std::string target_file_path = target_directory_zip + file_stat.m_filename;
-        // 记录已提取的文件路径 (Record extracted file path)
-        extracted_files.insert(extracted_files.begin(), target_file_path);
         
         
         // 再次检查是否需要停止 (Check again if stop is requested)
         if (stop_token.stop_requested()) {
-            is_stopped = true;
             goto cleanup;
         }
         
         // 创建流式解压迭代器 (Create streaming extraction iterator)
         iter_state = mz_zip_reader_extract_iter_new(zip_archive, file_index, 0);
         if (!iter_state) {
-            is_error = true;
             if (error_callback) {
                 error_callback(CANT_READ_ERROR + std::string(file_stat.m_filename));
             }
@@ -131,7 +135,6 @@ bool ModManager::extractMod(const std::string& zip_path,
         // 打开目标文件 (Open destination file)
         dest_file = fopen(target_file_path.c_str(), "wb");
         if (!dest_file) {
-            is_error = true;
             if (error_callback) {
                 error_callback(CANT_CREATE_ERROR + target_file_path + ", errno: " + std::to_string(errno));
             }
@@ -155,7 +158,6 @@ bool ModManager::extractMod(const std::string& zip_path,
         while (total_written < (size_t)file_size && file_success) {
             // 在文件解压过程中检查是否需要停止 (Check if stop is requested during file extraction)
             if (stop_token.stop_requested()) {
-                is_stopped = true;
                 goto cleanup;
             }
             
@@ -165,14 +167,12 @@ bool ModManager::extractMod(const std::string& zip_path,
             
             size_t bytes_read = mz_zip_reader_extract_iter_read(iter_state, aligned_buffer, to_read);
             if (stop_token.stop_requested()) {
-                is_stopped = true;
                 goto cleanup;
             }
             if (bytes_read > 0) {
                 // 写入实际读取的字节数，保持文件原始大小 (Write actual bytes read, maintain original file size)
                 if (fwrite(aligned_buffer, 1, bytes_read, dest_file) != bytes_read) {
                     // 写入失败，立即清理资源并停止安装 (Write failed, immediately cleanup and stop installation)
-                    is_error = true;
                     if (error_callback) {
                         error_callback(CANT_WRITE_ERROR + target_file_path);
                     }
@@ -232,16 +232,307 @@ cleanup:
         aligned_buffer = nullptr;
     }
     
-    // 根据错误类型调用相应的清理函数 (Call appropriate cleanup function based on error type)
-    if (is_error) {
-        cleanupCopiedFilesAndDirectories_forError(extracted_files, progress_callback, files_total);
-    } else if (is_stopped) {
-        cleanupCopiedFilesAndDirectories(extracted_files, progress_callback, files_total);
-    }
-    
+    // 已写入的文件由调用方按安装日志回滚 (Files already written are rolled back by the caller from the install journal)
     return false;
 }
 
+// 流水线解压：解压线程和写入线程并行，安装速度取决于两者中较慢的一方
+// (Pipelined extraction: inflate and write run in parallel, install speed is bounded by the slower of the two)
+bool ModManager::extractModPipelined(const std::string& zip_path,
+                                     int& files_total,
+                                     std::vector<int>& files_to_extract,
+                                     ProgressCallback progress_callback,
+                                     ErrorCallback error_callback,
+                                     std::stop_token stop_token,
+                                     void* zip_archive_ptr) {
+
+    // 直接使用传入的已初始化ZIP读取器
+    mz_zip_archive* zip_archive = static_cast<mz_zip_archive*>(zip_archive_ptr);
+
+    int num_files = files_to_extract.size();
+
+    if (num_files == 0) {
+        if (error_callback) {
+            error_callback("请勿安装重复的MOD！");
+        }
+        return false;
+    }
+
+    // 环形缓冲区总大小与extractMod的32MB缓冲区一致 (Ring total size matches extractMod's 32MB buffer)
+    const size_t SD_BLOCK_SIZE = 64 * 1024; // 64KB SD卡块大小
+    const size_t RING_SLOT_SIZE = 8 * 1024 * 1024; // 8MB 每个槽位 (8MB per slot)
+    const size_t RING_SLOT_COUNT = 4;
+
+    char* ring_buffer = (char*)memalign(SD_BLOCK_SIZE, RING_SLOT_SIZE * RING_SLOT_COUNT);
+    if (!ring_buffer) {
+        // 内存不足时回退到顺序解压 (Fall back to serial extraction when memory is short)
+        return extractMod(zip_path, files_total, files_to_extract, progress_callback, error_callback, stop_token, zip_archive_ptr);
+    }
+
+    // 槽位中属于同一个文件的一段数据 (A run of data in a slot belonging to one file)
+    struct RingSegment {
+        size_t offset{0};    // 在槽位中的偏移 (Offset within the slot)
+        size_t size{0};
+        size_t file_size{0};
+        bool first{false};   // 文件的第一段，写入线程在此打开目标文件 (First segment of a file, writer opens target here)
+        bool last{false};    // 文件的最后一段，写入线程在此关闭目标文件 (Last segment of a file, writer closes target here)
+        std::string filename; // 仅第一段携带ZIP内路径 (Only the first segment carries the in-archive path)
+    };
+
+    // 环形缓冲区中的一个槽位，连续的小文件合并到同一个槽位，减少线程交接次数
+    // (One slot in the ring, consecutive small files are packed into the same slot to cut thread hand-offs)
+    struct RingChunk {
+        char* data{nullptr};
+        std::vector<RingSegment> segments;
+    };
+
+    RingChunk ring[RING_SLOT_COUNT];
+    for (size_t s = 0; s < RING_SLOT_COUNT; s++) {
+        ring[s].data = ring_buffer + s * RING_SLOT_SIZE;
+    }
+
+    std::mutex ring_mutex;
+    std::condition_variable ring_filled;
+    std::condition_variable ring_freed;
+    size_t ring_head = 0;  // 下一个待写入的槽位 (Next slot to write out)
+    size_t ring_count = 0; // 已填充的槽位数量 (Number of filled slots)
+    bool producer_done = false;
+    bool ring_abort = false;
+    std::string producer_error;
+
+    // 解压线程：按归档顺序把每个文件解压到空闲槽位 (Inflate thread: inflate each file into free slots in archive order)
+    auto producer = util::async([&](std::stop_token producer_token) {
+        size_t ring_tail = 0;
+        bool slot_acquired = false;
+        size_t slot_used = 0;
+
+        // 等待空闲槽位 (Wait for a free slot)
+        auto acquire_slot = [&]() -> bool {
+            {
+                std::unique_lock lock(ring_mutex);
+                ring_freed.wait(lock, [&] { return ring_count < RING_SLOT_COUNT || ring_abort; });
+                if (ring_abort) {
+                    return false;
+                }
+            }
+            // 槽位在发布前只属于解压线程，无需加锁 (The slot belongs to the inflate thread until published, no lock needed)
+            ring[ring_tail].segments.clear();
+            slot_used = 0;
+            slot_acquired = true;
+            return true;
+        };
+
+        // 把当前槽位交给写入线程 (Hand the current slot to the writer)
+        auto publish_slot = [&]() {
+            {
+                std::lock_guard lock(ring_mutex);
+                ring_tail = (ring_tail + 1) % RING_SLOT_COUNT;
+                ring_count++;
+            }
+            ring_filled.notify_one();
+            slot_acquired = false;
+        };
+
+        for (int i = 0; i < num_files && producer_error.empty(); i++) {
+            if (producer_token.stop_requested() || stop_token.stop_requested()) {
+                break;
+            }
+
+            int file_index = files_to_extract[i];
+
+            mz_zip_archive_file_stat file_stat;
+            if (!mz_zip_reader_file_stat(zip_archive, file_index, &file_stat)) {
+                producer_error = ZIP_READ_ERROR + zip_path;
+                break;
+            }
+
+            mz_zip_reader_extract_iter_state* iter_state = mz_zip_reader_extract_iter_new(zip_archive, file_index, 0);
+            if (!iter_state) {
+                producer_error = CANT_READ_ERROR + std::string(file_stat.m_filename);
+                break;
+            }
+
+            size_t file_size = file_stat.m_uncomp_size;
+            size_t total_read = 0;
+            bool first = true;
+            bool last = false;
+
+            while (!last) {
+                // 当前槽位放不下剩余数据时先交出去，小文件因此整块留在同一槽位
+                // (Hand over the current slot when the rest of the file does not fit, so small files stay whole within one slot)
+                size_t remaining = file_size - total_read;
+                if (slot_acquired && slot_used > 0 && remaining > RING_SLOT_SIZE - slot_used) {
+                    publish_slot();
+                }
+                if (!slot_acquired && !acquire_slot()) {
+                    break;
+                }
+
+                RingChunk& chunk = ring[ring_tail];
+                size_t to_read = std::min(RING_SLOT_SIZE - slot_used, remaining);
+                size_t bytes_read = to_read ? mz_zip_reader_extract_iter_read(iter_state, chunk.data + slot_used, to_read) : 0;
+                total_read += bytes_read;
+                last = bytes_read < to_read || total_read >= file_size;
+
+                RingSegment& segment = chunk.segments.emplace_back();
+                segment.offset = slot_used;
+                segment.size = bytes_read;
+                segment.file_size = file_size;
+                segment.first = first;
+                segment.last = last;
+                if (first) {
+                    segment.filename = file_stat.m_filename;
+                }
+                first = false;
+                slot_used += bytes_read;
+
+                // 槽位写满立即交出 (Hand over a full slot immediately)
+                if (slot_used >= RING_SLOT_SIZE) {
+                    publish_slot();
+                }
+
+                if (producer_token.stop_requested() || stop_token.stop_requested()) {
+                    break;
+                }
+            }
+
+            mz_zip_reader_extract_iter_free(iter_state);
+
+            if (!last) {
+                break;
+            }
+        }
+
+        // 交出最后一个未满的槽位 (Hand over the last partially filled slot)
+        if (slot_acquired) {
+            publish_slot();
+        }
+
+        {
+            std::lock_guard lock(ring_mutex);
+            producer_done = true;
+        }
+        ring_filled.notify_one();
+    });
+
+    // 写入线程（当前线程）：按顺序把槽位写入SD卡 (Writer, the calling thread: drain slots to SD in order)
+    int processed_files = 0;
+    bool is_error = false;
+    bool is_stopped = false;
+    FILE* dest_file = nullptr;
+    std::string target_file_path;
+    const char* filename_ptr = "";
+    size_t total_written = 0;
+
+    while (true) {
+        {
+            std::unique_lock lock(ring_mutex);
+            ring_filled.wait(lock, [&] { return ring_count > 0 || producer_done; });
+            if (ring_count == 0) {
+                break; // 解压线程已结束且没有剩余数据 (Inflate thread finished and ring is drained)
+            }
+        }
+
+        if (stop_token.stop_requested()) {
+            is_stopped = true;
+            break;
+        }
+
+        RingChunk& chunk = ring[ring_head];
+
+        for (const RingSegment& segment : chunk.segments) {
+            if (segment.first) {
+                // 构建完整的目标文件路径 (Build complete target file path)
+                target_file_path = target_directory_zip + segment.filename;
+
+                const char* last_slash = strrchr(target_file_path.c_str(), '/');
+                filename_ptr = last_slash ? last_slash + 1 : target_file_path.c_str();
+                total_written = 0;
+
+                dest_file = fopen(target_file_path.c_str(), "wb");
+                if (!dest_file) {
+                    is_error = true;
+                    if (error_callback) {
+                        error_callback(CANT_CREATE_ERROR + target_file_path + ", errno: " + std::to_string(errno));
+                    }
+                    break;
+                }
+                // 槽位数据已在内存中，关闭stdio缓冲直接写入 (Slot data is already in memory, write unbuffered)
+                setvbuf(dest_file, nullptr, _IONBF, 0);
+            }
+
+            if (segment.size > 0) {
+                if (fwrite(chunk.data + segment.offset, 1, segment.size, dest_file) != segment.size) {
+                    is_error = true;
+                    if (error_callback) {
+                        error_callback(CANT_WRITE_ERROR + target_file_path);
+                    }
+                    break;
+                }
+                total_written += segment.size;
+
+                // 更新文件级进度 (Update file-level progress)
+                if (progress_callback && segment.file_size > 8 * 1024 * 1024) {
+                    int progress_percent = (int)((total_written * 100) / segment.file_size);
+                    progress_callback(processed_files, files_total, filename_ptr, true, (float)progress_percent, "", COLOR_BLUE);
+                }
+            }
+
+            if (segment.last) {
+                fclose(dest_file);
+                dest_file = nullptr;
+                processed_files++;
+
+                // 更新总体进度 (Update overall progress)
+                if (progress_callback) {
+                    progress_callback(processed_files, files_total, filename_ptr, false, 0.0f, "", COLOR_BLUE);
+                }
+            }
+        }
+
+        if (is_error) {
+            break;
+        }
+
+        // 归还槽位给解压线程 (Return slot to the inflate thread)
+        {
+            std::lock_guard lock(ring_mutex);
+            ring_head = (ring_head + 1) % RING_SLOT_COUNT;
+            ring_count--;
+        }
+        ring_freed.notify_one();
+    }
+
+    // 停止并等待解压线程，之后才能释放环形缓冲区 (Stop and join the inflate thread before releasing the ring)
+    {
+        std::lock_guard lock(ring_mutex);
+        ring_abort = true;
+    }
+    ring_freed.notify_one();
+    producer.request_stop();
+    producer.get();
+
+    if (dest_file) {
+        fclose(dest_file);
+        dest_file = nullptr;
+    }
+    free(ring_buffer);
+
+    if (!is_error && !is_stopped) {
+        if (!producer_error.empty()) {
+            is_error = true;
+            if (error_callback) {
+                error_callback(producer_error);
+            }
+        } else if (stop_token.stop_requested() || processed_files < num_files) {
+            is_stopped = true;
+        }
+    }
+
+    // 已写入的文件由调用方按安装日志回滚 (Files already written are rolled back by the caller from the install journal)
+    return !is_error && !is_stopped;
+}
+
 // // 带聚合的速度不如顺序的，备用不删了
 // bool ModManager::extractMod2(const std::string& zip_path,
 //                            ProgressCallback progress_callback,
@@ -667,108 +958,152 @@ bool ModManager::RemoveModFilesFromCache(const std::string& mod_common_path,
     bool overall_success = true;
     
     // 对cached_target_files进行去重处理（依据mod_file_common.json内容去重）
-    tj::JsonManager::ProcessModFileCommonDeduplication(mod_common_path, cached_target_files);
-    
-    size_t processed_files = 0;
-    size_t total_files = cached_target_files.size();
-    
-    std::string last_dir_path = ""; // 记录上一个文件的目录路径 (Record last file's directory path)
-    
-    for (const std::string& target_file_path : cached_target_files) {
-        // 检查是否需要停止 (Check if stop is requested)
-        if (stop_token.stop_requested()) {
-            
-            return false;
+    // 账本写不回去时不删除任何文件，保持计数与磁盘一致 (Delete nothing if the ledger cannot be written back, keeping counts consistent with the disk)
+    if (!tj::JsonManager::ProcessModFileCommonDeduplication(mod_common_path, cached_target_files)) {
+        if (error_callback) {
+            error_callback(CANT_WRITE_ERROR + mod_common_path);
         }
-        
-        // 直接使用缓存的目标路径，无需重新计算 (Directly use cached target path, no need to recalculate)
-        
-        // 使用指针获取当前文件的目录路径，避免substr拷贝 (Use pointer to get current file's directory path, avoiding substr copy)
+        return false;
+    }
+
+    // 按目录聚集排序，每个目录作为一个删除任务，同一目录只由一个线程删除 (Cluster by directory, each directory is one task deleted by a single thread)
+    SortTargetFilesByDirectory();
+
+    // 删除线程数，调用线程也参与删除 (Deletion worker count, the calling thread deletes as well)
+    const size_t UNINSTALL_WORKER_COUNT = 2;
+
+    struct DirectoryGroup {
+        size_t begin;
+        size_t end;
+    };
+    std::vector<DirectoryGroup> groups;
+    std::vector<std::string> group_dirs; // 每个任务的目录路径 (Directory path of each task)
+
+    for (size_t i = 0; i < cached_target_files.size(); ++i) {
+        const std::string& target_file_path = cached_target_files[i];
         size_t last_slash_pos = target_file_path.find_last_of('/');
-        std::string current_dir;
-        if (last_slash_pos != std::string::npos) {
-            current_dir.assign(target_file_path.c_str(), last_slash_pos);
-        }
-        
-        // 检查父目录是否改变，如果改变了说明前一个目录的源MOD文件已清空 (Check if parent directory changed)
-        if (!last_dir_path.empty() && current_dir != last_dir_path) {
-            // 检查并删除上一个目录（如果为空） (Check and delete previous directory if empty)
-            std::string check_dir = last_dir_path;
-            while (!check_dir.empty() && check_dir.length() > target_directory_zip.length()) {
-                // 检查是否到达contents或exefs_patches目录，如果是则停止 (Check if reached contents or exefs_patches directory)
-                const char* relative_start = check_dir.c_str() + target_directory_zip.length();
-                if (strcmp(relative_start, "contents") == 0 || strcmp(relative_start, "exefs_patches") == 0) {
-                    break; // 到达contents或exefs_patches目录，停止删除 (Reached contents or exefs_patches directory, stop deletion)
+        std::string_view current_dir(target_file_path.data(), last_slash_pos == std::string::npos ? 0 : last_slash_pos);
+
+        if (groups.empty() || current_dir != group_dirs.back()) {
+            groups.push_back({i, i});
+            group_dirs.emplace_back(current_dir);
+        }
+        groups.back().end = i + 1;
+    }
+
+    size_t total_files = cached_target_files.size();
+    std::atomic<size_t> next_group{0};
+    std::atomic<size_t> processed_files{0};
+    std::atomic<bool> is_stopped{false};
+    std::mutex failed_mutex;
+    std::vector<std::pair<std::string, int>> failed_files; // 删除失败的文件和错误码 (Files that failed to delete and their errno)
+
+    // 按顺序领取目录任务并删除其中的文件，只有调用线程更新进度 (Claim directory tasks in order and delete their files, only the calling thread reports progress)
+    auto delete_groups = [&](std::stop_token worker_token, bool report_progress) {
+        size_t group_index;
+        while ((group_index = next_group.fetch_add(1)) < groups.size()) {
+            for (size_t i = groups[group_index].begin; i < groups[group_index].end; ++i) {
+                // 检查是否需要停止 (Check if stop is requested)
+                if (worker_token.stop_requested() || stop_token.stop_requested()) {
+                    is_stopped = true;
+                    return;
                 }
-                
-                // 尝试删除目录，只要错误码不是目录不存在就停止向上检查 (Try to delete directory, stop upward checking unless directory doesn't exist)
-                if (remove(check_dir.c_str()) != 0) {
-                    // 只有当目录不存在时才继续向上检查，其他错误都停止 (Only continue upward checking if directory doesn't exist, stop for all other errors)
-                    if (errno != ENOENT) {
-                        break; // 目录存在但删除失败，停止向上检查 (Directory exists but deletion failed, stop checking upward)
-                    }
+
+                const std::string& target_file_path = cached_target_files[i];
+
+                // 删除目标文件，ENOENT错误忽略 (Delete target file, ENOENT is ignored)
+                if (remove(target_file_path.c_str()) != 0 && errno != ENOENT) {
+                    std::lock_guard lock(failed_mutex);
+                    failed_files.emplace_back(target_file_path, errno);
                 }
-                
-                // 移动到父目录，使用指针避免substr拷贝 (Move to parent directory, use pointer to avoid substr copy)
-                size_t parent_slash = check_dir.find_last_of('/');
-                if (parent_slash == std::string::npos || parent_slash <= target_directory_zip.length()) {
-                    break;
+
+                size_t done = processed_files.fetch_add(1) + 1;
+
+                // 更新进度 (Update progress)
+                if (report_progress && progress_callback) {
+                    float progress_percentage = (float)done / total_files * 100.0f;
+                    // 只显示文件名，不显示路径 (Show only filename, not path)
+                    const char* filename_ptr = target_file_path.c_str();
+                    const char* last_slash = strrchr(filename_ptr, '/');
+                    const char* display_name = last_slash ? last_slash + 1 : filename_ptr;
+                    progress_callback(done, total_files, display_name, false, progress_percentage, "", COLOR_BLUE);
                 }
-                check_dir.assign(check_dir.c_str(), parent_slash);
             }
         }
-        
-        // 删除目标文件 (Delete target file)
-        if (remove(target_file_path.c_str()) != 0) {
-            if (errno != ENOENT) {
-                // 只有非"文件不存在"的错误才认为是真正的失败 (Only non-ENOENT errors are considered real failures)
-                overall_success = false;
-                if (error_callback) {
-                    error_callback(UNINSTALLED_ERROR + target_file_path + ", errno: " + std::to_string(errno));
-                }
-            }
-            // ENOENT错误忽略，继续处理下一个文件 (Ignore ENOENT error, continue with next file)
+    };
+
+    {
+        std::vector<util::AsyncFurture<void>> workers;
+        for (size_t w = 0; w < UNINSTALL_WORKER_COUNT && w + 1 < groups.size(); ++w) {
+            workers.emplace_back(util::async([&](std::stop_token worker_token) {
+                delete_groups(worker_token, false);
+            }));
         }
-        
-        // 更新当前目录路径 (Update current directory path)
-        last_dir_path = current_dir;
-        processed_files++;
-        
-        // 更新进度 (Update progress)
-        if (progress_callback) {
-            float progress_percentage = (float)processed_files / total_files * 100.0f;
-            // 只显示文件名，不显示路径 (Show only filename, not path)
-            const char* filename_ptr = target_file_path.c_str();
-            const char* last_slash = strrchr(filename_ptr, '/');
-            const char* display_name = last_slash ? last_slash + 1 : filename_ptr;
-            progress_callback(processed_files, total_files, display_name, false, progress_percentage, "", COLOR_BLUE);
+        delete_groups(std::stop_token{}, true);
+
+        // 等待其他线程删除完剩余目录 (Wait for the other threads to finish the remaining directories)
+        for (auto& worker : workers) {
+            worker.get();
         }
     }
-    
-    // 处理完所有文件后，清理最后一个目录 (Clean up the last directory after processing all files)
-    if (!last_dir_path.empty()) {
-        std::string check_dir = last_dir_path;
-        while (!check_dir.empty() && check_dir.length() > target_directory_zip.length()) {
+
+    if (is_stopped) {
+        return false;
+    }
+
+    // 只有非"文件不存在"的错误才认为是真正的失败 (Only non-ENOENT errors are considered real failures)
+    for (const auto& [failed_path, failed_errno] : failed_files) {
+        overall_success = false;
+        if (error_callback) {
+            error_callback(UNINSTALLED_ERROR + failed_path + ", errno: " + std::to_string(failed_errno));
+        }
+    }
+
+    if (progress_callback && total_files > 0) {
+        progress_callback(total_files, total_files, "", false, 100.0f, "", COLOR_BLUE);
+    }
+
+    // 收集删除过文件的目录及其上级目录，到contents或exefs_patches为止 (Collect directories that lost files plus their parents, up to contents or exefs_patches)
+    std::vector<std::string> prune_dirs;
+    for (const std::string& group_dir : group_dirs) {
+        std::string check_dir = group_dir;
+        while (check_dir.length() > target_directory_zip.length()) {
             // 检查是否到达contents或exefs_patches目录，如果是则停止 (Check if reached contents or exefs_patches directory)
             const char* relative_start = check_dir.c_str() + target_directory_zip.length();
             if (strcmp(relative_start, "contents") == 0 || strcmp(relative_start, "exefs_patches") == 0) {
-                break; // 到达contents或exefs_patches目录，停止删除 (Reached contents or exefs_patches directory, stop deletion)
-            }
-            
-            // 尝试删除目录，只有在目录不为空时才停止 (Try to delete directory, only stop if directory is not empty)
-            if (remove(check_dir.c_str()) != 0) {
-                // 只有当目录不存在时才继续向上检查，其他错误都停止 (Only continue upward checking if directory doesn't exist, stop for all other errors)
-                if (errno != ENOENT) {
-                    break; // 目录存在但删除失败，停止向上检查 (Directory exists but deletion failed, stop checking upward)
-                }
+                break;
             }
-            
-            // 移动到父目录，使用指针避免substr拷贝 (Move to parent directory, use pointer to avoid substr copy)
+            prune_dirs.push_back(check_dir);
+
+            // 移动到父目录 (Move to parent directory)
             size_t parent_slash = check_dir.find_last_of('/');
             if (parent_slash == std::string::npos || parent_slash <= target_directory_zip.length()) {
                 break;
             }
-            check_dir.assign(check_dir.c_str(), parent_slash);
+            check_dir.resize(parent_slash);
+        }
+    }
+
+    // 由深到浅排序去重，每个目录只尝试删除一次 (Sort deepest first and deduplicate, each directory is tried once)
+    std::sort(prune_dirs.begin(), prune_dirs.end(), [](const std::string& a, const std::string& b) {
+        auto depth_a = std::count(a.begin(), a.end(), '/');
+        auto depth_b = std::count(b.begin(), b.end(), '/');
+        if (depth_a != depth_b) {
+            return depth_a > depth_b;
+        }
+        return a < b;
+    });
+    prune_dirs.erase(std::unique(prune_dirs.begin(), prune_dirs.end()), prune_dirs.end());
+
+    // 子目录删除失败时其上级目录必然非空，直接跳过 (When a child cannot be removed its parent is not empty either, skip it)
+    std::unordered_set<std::string> kept_dirs;
+    for (const std::string& dir_path : prune_dirs) {
+        bool removed = !kept_dirs.count(dir_path) && (remove(dir_path.c_str()) == 0 || errno == ENOENT);
+        if (!removed) {
+            size_t parent_slash = dir_path.find_last_of('/');
+            if (parent_slash != std::string::npos) {
+                kept_dirs.emplace(dir_path, 0, parent_slash);
+            }
         }
     }
     
@@ -783,6 +1118,26 @@ bool ModManager::uninstallModFromFolder(const std::string& folder_path,
     // 清空缓存，确保每次卸载都有干净的缓存状态 (Clear cache for clean state)
     cached_target_files.clear();
     
+    std::string mod_common_path = GetModFileCommonPath(folder_path);
+    std::string manifest_path = GetModManifestPath(folder_path);
+    
+    // 优先回放安装清单，无需递归遍历MOD目录 (Replay the install manifest first, no need to walk the MOD directory)
+    if (LoadTargetFilesFromManifest(manifest_path, 0)) {
+        if (progress_callback) {
+            progress_callback(0, cached_target_files.size(), CALCULATE_FILES, false, 0.0f, "", COLOR_BLUE);
+        }
+        bool manifest_result = RemoveModFilesFromCache(mod_common_path, progress_callback, error_callback, stop_token);
+        if (!manifest_result && error_callback) {
+            error_callback(UNINSTALLED_ERROR);
+        }
+        if (manifest_result) {
+            ForgetInstalledFiles(folder_path);
+        }
+        cached_target_files.clear();
+        cached_target_files.shrink_to_fit();
+        return manifest_result;
+    }
+    
     // 打开MOD目录 (Open MOD directory)
     DIR* mod_dir = opendir(folder_path.c_str());
     if (!mod_dir) {
@@ -863,8 +1218,6 @@ bool ModManager::uninstallModFromFolder(const std::string& folder_path,
         return false;
     }
     
-    std::string mod_common_path = GetModFileCommonPath(folder_path);
-    
     // 阶段2：基于缓存的路径进行删除 (Phase 2: Delete based on cached paths)
     bool overall_result = RemoveModFilesFromCache(mod_common_path, progress_callback, error_callback, stop_token);
     
@@ -872,6 +1225,11 @@ bool ModManager::uninstallModFromFolder(const std::string& folder_path,
         error_callback(UNINSTALLED_ERROR);
     }
     
+    // 卸载成功后删除清单和冲突索引记录 (Remove the manifest and conflict index records after a successful uninstall)
+    if (overall_result) {
+        ForgetInstalledFiles(folder_path);
+    }
+    
     // 清理缓存 (Clean up cache)
     cached_target_files.clear();
     cached_target_files.shrink_to_fit();
@@ -885,6 +1243,21 @@ bool ModManager::uninstallModFromZipDirect(const std::string& zip_path,
                                           ErrorCallback error_callback,
                                           std::stop_token stop_token) {
     
+    std::string mod_common_path = GetModFileCommonPath(zip_path);
+    std::string manifest_path = GetModManifestPath(zip_path);
+    
+    // 优先回放安装清单，无需重新打开ZIP (Replay the install manifest first, no need to reopen the ZIP)
+    if (LoadTargetFilesFromManifest(manifest_path, tj::InstallManifest::GetFileFingerprint(zip_path))) {
+        if (progress_callback) {
+            progress_callback(0, cached_target_files.size(), CALCULATE_FILES, false, 0.0f, "", COLOR_BLUE);
+        }
+        bool manifest_result = RemoveModFilesFromCache(mod_common_path, progress_callback, error_callback, stop_token);
+        if (manifest_result) {
+            ForgetInstalledFiles(zip_path);
+        }
+        return manifest_result;
+    }
+    
     // 初始化ZIP读取器 (Initialize ZIP reader)
     mz_zip_archive zip_archive;
     memset(&zip_archive, 0, sizeof(zip_archive));
@@ -937,47 +1310,20 @@ bool ModManager::uninstallModFromZipDirect(const std::string& zip_path,
     
     mz_zip_reader_end(&zip_archive);
     
-    // 优化的目录聚集排序算法：按目录路径分组，确保完全聚集
-    // (Optimized directory clustering sort algorithm: group by directory path for complete clustering)
-    std::sort(cached_target_files.begin(), cached_target_files.end(), [](const std::string& a, const std::string& b) {
-        // 提取目录路径的辅助函数
-        auto get_directory = [](const std::string& path) {
-            size_t last_slash = path.find_last_of('/');
-            return (last_slash != std::string::npos) ? path.substr(0, last_slash) : "";
-        };
-        
-        // 计算路径深度的辅助函数
-        auto count_depth = [](const std::string& path) {
-            return std::count(path.begin(), path.end(), '/');
-        };
-        
-        std::string dir_a = get_directory(a);
-        std::string dir_b = get_directory(b);
-        
-        // 1. 首先按目录路径字典序排序（确保同目录文件聚集）
-        if (dir_a != dir_b) {
-            return dir_a < dir_b;
-        }
-        
-        // 2. 同目录内，优先按深度降序排序（深层文件先删除）
-        int depth_a = count_depth(a);
-        int depth_b = count_depth(b);
-        if (depth_a != depth_b) {
-            return depth_a > depth_b;
-        }
-        
-        // 3. 深度相同时，按文件名字典序排序
-        return a < b;
-    });
-    
 
     if (progress_callback) {
         progress_callback(0, valid_file_count, CALCULATE_FILES, false, 0.0f, "", COLOR_BLUE);
     }
     
-    std::string mod_common_path = GetModFileCommonPath(zip_path);
     // 调用RemoveModFilesFromCache函数完成实际的文件删除 (Call RemoveModFilesFromCache to perform actual file deletion)
-    return RemoveModFilesFromCache(mod_common_path, progress_callback, error_callback, stop_token);
+    bool overall_result = RemoveModFilesFromCache(mod_common_path, progress_callback, error_callback, stop_token);
+    
+    // 卸载成功后删除清单和冲突索引记录 (Remove the manifest and conflict index records after a successful uninstall)
+    if (overall_result) {
+        ForgetInstalledFiles(zip_path);
+    }
+    
+    return overall_result;
 
     
 }
@@ -989,16 +1335,60 @@ bool ModManager::getModInstallType(const std::string& mod_path,
                                    ErrorCallback error_callback,
                                    std::stop_token stop_token) {
 
-    
-    // 直接打开目录，打不开就报错 (Open directory directly, report error if failed)
-    DIR* dir = opendir(mod_path.c_str());
-    if (!dir) {
+    // 安装与预览走同一个计划扫描 (The install goes through the same plan scan as the preview)
+    if (operation_type == 1) {
+        InstallPlan plan;
+        if (!BuildInstallPlan(mod_path, plan, progress_callback, error_callback, stop_token)) {
+            return false;
+        }
+        return InstallFromPlan(plan, progress_callback, error_callback, stop_token);
+    }
+
+    std::string zip_path;
+    ModLayout layout = DetectModLayout(mod_path, zip_path);
+    if (layout == ModLayout::Unreadable) {
         if (error_callback) {
             error_callback(CANT_OPEN_FILE + mod_path);
         }
         return false;
     }
     
+    // 检查是否需要停止 (Check if stop is requested)
+    if (stop_token.stop_requested()) {
+        
+        return false;
+    }
+    
+    // 如果mod路径下面只有contents或者exefs_patches或者这两个都有，视为文件类型，启动文件类型安装
+    // (If mod path only has contents or exefs_patches or both, treat as file type, start file type installation)
+    if (layout == ModLayout::Folder) {
+        if (operation_type == 0) return uninstallModFromFolder(mod_path, progress_callback, error_callback, stop_token);
+    }
+    
+    // 否则如果mod路径下面只有文件且为ZIP文件，则视为ZIP类型启动ZIP安装方法
+    // (Otherwise if mod path only has file and it's ZIP file, treat as ZIP type and start ZIP installation)
+    if (layout == ModLayout::Zip) {
+        if (operation_type == 0) return uninstallModFromZipDirect(zip_path, progress_callback, error_callback, stop_token);
+    }
+    
+    // 否则提示MOD结构不合法，结束安装 (Otherwise prompt MOD structure is invalid, end installation)
+    if (error_callback) {
+        error_callback(FILE_NONE);
+    }
+    return false;
+}
+
+// 检测MOD目录结构 (Detect the MOD directory layout)
+ModManager::ModLayout ModManager::DetectModLayout(const std::string& mod_path, std::string& zip_path) {
+
+    zip_path.clear();
+
+    // 直接打开目录，打不开就报错 (Open directory directly, report error if failed)
+    DIR* dir = opendir(mod_path.c_str());
+    if (!dir) {
+        return ModLayout::Unreadable;
+    }
+    
     // 读取mod路径下面的文件或者目录 (Read files or directories under mod path)
     bool has_contents = false;
     bool has_exefs_patches = false;
@@ -1039,89 +1429,112 @@ bool ModManager::getModInstallType(const std::string& mod_path,
     }
     closedir(dir);
     
-    // 检查是否需要停止 (Check if stop is requested)
-    if (stop_token.stop_requested()) {
-        
-        return false;
-    }
-    
-    // 如果mod路径下面只有contents或者exefs_patches或者这两个都有，视为文件类型，启动文件类型安装
-    // (If mod path only has contents or exefs_patches or both, treat as file type, start file type installation)
+    // 如果mod路径下面只有contents或者exefs_patches或者这两个都有，视为文件类型
+    // (If mod path only has contents or exefs_patches or both, treat as file type)
     if ((has_contents || has_exefs_patches) && !has_other_items && !has_zip_file) {
-        if (operation_type == 1) return installModFromFolder(mod_path, progress_callback, error_callback, stop_token);
-        else if (operation_type == 0) return uninstallModFromFolder(mod_path, progress_callback, error_callback, stop_token);
+        return ModLayout::Folder;
     }
     
-    // 否则如果mod路径下面只有文件且为ZIP文件，则视为ZIP类型启动ZIP安装方法
-    // (Otherwise if mod path only has file and it's ZIP file, treat as ZIP type and start ZIP installation)
+    // 否则如果mod路径下面只有文件且为ZIP文件，则视为ZIP类型
+    // (Otherwise if mod path only has file and it's ZIP file, treat as ZIP type)
     if (has_zip_file && !has_contents && !has_exefs_patches && !has_other_items && total_items == 1) {
-        std::string zip_path = mod_path + "/" + zip_file_name;
-        if (operation_type == 1) return installModFromZipDirect(zip_path, progress_callback, error_callback, stop_token);
-        else if (operation_type == 0) return uninstallModFromZipDirect(zip_path, progress_callback, error_callback, stop_token);
+        zip_path = mod_path + "/" + zip_file_name;
+        return ModLayout::Zip;
     }
     
-    // 否则提示MOD结构不合法，结束安装 (Otherwise prompt MOD structure is invalid, end installation)
-    if (error_callback) {
-        error_callback(FILE_NONE);
-    }
-    return false;
+    return ModLayout::Invalid;
 }
 
+// 生成安装计划并查询冲突所有者，供预览使用 (Build an install plan and look up conflict owners for the preview)
+bool ModManager::PlanInstall(const std::string& mod_path,
+                             InstallPlan& plan,
+                             ProgressCallback progress_callback,
+                             ErrorCallback error_callback,
+                             std::stop_token stop_token) {
 
+    if (!BuildInstallPlan(mod_path, plan, progress_callback, error_callback, stop_token)) {
+        return false;
+    }
+    FindConflictOwners(plan);
+    return true;
+}
 
+// 按MOD目录结构只读扫描生成安装计划 (Build an install plan with a read-only scan by MOD layout)
+bool ModManager::BuildInstallPlan(const std::string& mod_path,
+                                  InstallPlan& plan,
+                                  ProgressCallback progress_callback,
+                                  ErrorCallback error_callback,
+                                  std::stop_token stop_token) {
+
+    plan = InstallPlan{};
+
+    std::string zip_path;
+    switch (DetectModLayout(mod_path, zip_path)) {
+        case ModLayout::Folder:
+            return PlanFolderInstall(mod_path, plan, progress_callback, error_callback, stop_token);
+        case ModLayout::Zip:
+            return PlanZipInstall(zip_path, plan, progress_callback, error_callback, stop_token);
+        case ModLayout::Unreadable:
+            if (error_callback) {
+                error_callback(CANT_OPEN_FILE + mod_path);
+            }
+            return false;
+        case ModLayout::Invalid:
+        default:
+            // 结构不合法也是一个有效的计划，预览时直接显示原因 (An invalid layout is still a valid plan, the preview shows the reason)
+            plan.source_path = mod_path;
+            plan.layout_error = FILE_NONE;
+            return true;
+    }
+}
 
+// 只读取ZIP中央目录生成安装计划 (Build an install plan from the ZIP central directory only)
+bool ModManager::PlanZipInstall(const std::string& zip_path,
+                                InstallPlan& plan,
+                                ProgressCallback progress_callback,
+                                ErrorCallback error_callback,
+                                std::stop_token stop_token) {
 
-
-bool ModManager::installModFromZipDirect(const std::string& zip_path,
-                                        ProgressCallback progress_callback,
-                                        ErrorCallback error_callback,
-                                        std::stop_token stop_token) {
-    
     if (progress_callback) {
         progress_callback(0, 0, CALCULATE_FILES, false, 0.0f, "", COLOR_BLUE);
     }
 
-    // 资源管理变量 (Resource management variables)
-    mz_zip_archive zip_archive;
-    bool zip_initialized = false;
-    bool is_error = false;
-    bool is_stopped = false;
-    bool extract_success = false;
-    std::vector<std::string> all_directories; // 移到资源管理区域
-    std::set<std::string> first_level_dirs;
-    std::vector<int> files_to_extract; // 储存过滤后的文件索引
-    int num_files = 0;
-    int files_total = 0;
+    plan = InstallPlan{};
+    plan.source_path = zip_path;
+    plan.is_zip = true;
 
-    // 初始化ZIP读取器检查内部结构 (Initialize ZIP reader to check internal structure)
-    memset(&zip_archive, 0, sizeof(zip_archive));
-    
-    if (!mz_zip_reader_init_file(&zip_archive, zip_path.c_str(), 0)) {
+    // ZIP读取器随计划保留，执行时直接解压，不再重新读取中央目录 (The ZIP reader stays with the plan, execution extracts directly without re-reading the central directory)
+    mz_zip_archive* zip_archive = new mz_zip_archive;
+    memset(zip_archive, 0, sizeof(*zip_archive));
+    if (!mz_zip_reader_init_file(zip_archive, zip_path.c_str(), 0)) {
+        delete zip_archive;
         if (error_callback) {
             error_callback(ZIP_OPEN_ERROR + zip_path);
         }
-        return false; // ZIP初始化失败，无需cleanup
+        return false;
     }
-    zip_initialized = true; // 标记ZIP已初始化
-    
-    // 获取ZIP文件数量 (Get ZIP file count)
-    num_files = static_cast<int>(mz_zip_reader_get_num_files(&zip_archive));
-    
-    // 第一阶段：遍历ZIP文件收集所有目录 (Phase 1: Traverse ZIP files to collect all directories)
+    plan.zip_archive.reset(zip_archive, [](void* archive) {
+        mz_zip_reader_end(static_cast<mz_zip_archive*>(archive));
+        delete static_cast<mz_zip_archive*>(archive);
+    });
+
+    std::set<std::string> first_level_dirs;
+    int num_files = static_cast<int>(mz_zip_reader_get_num_files(zip_archive));
+    int files_total = 0;
+
+    // 遍历中央目录收集文件和所有需要创建的目录 (Walk the central directory collecting files and every directory to create)
     for (int i = 0; i < num_files; i++) {
         // 检查停止请求 (Check stop request)
         if (stop_token.stop_requested()) {
-            is_stopped = true;
-            goto cleanup;
+            return false;
         }
         
         mz_zip_archive_file_stat file_stat;
-        if (!mz_zip_reader_file_stat(&zip_archive, i, &file_stat)) {
-            is_error = true;
+        if (!mz_zip_reader_file_stat(zip_archive, i, &file_stat)) {
             if (error_callback) {
                 error_callback(ZIP_READ_ERROR + zip_path);
             }
-            goto cleanup;
+            return false;
         }
         
         std::string filename = file_stat.m_filename;
@@ -1134,151 +1547,85 @@ bool ModManager::installModFromZipDirect(const std::string& zip_path,
             first_level_dirs.insert(first_dir);
         }
         
-        // 收集所有需要创建的目录路径（包括所有父目录层次）- 优化版本
-        if (!mz_zip_reader_is_file_a_directory(&zip_archive, i)) {
-            
-            // 检查目标文件是否已存在，如果存在
-            std::string target_file_path;
-            target_file_path.reserve(target_directory_zip.length() + filename.length());
-            target_file_path = target_directory_zip;
-            target_file_path += filename;
-            
-            // 使用access()检查文件是否存在（F_OK表示检查文件存在性）
-            if (access(target_file_path.c_str(), F_OK) == 0) {
-                if (progress_callback) progress_callback(0, files_total, "校验CRC32冲突...", false, 0.0f, "", COLOR_BLUE);
-                // 如果检查目标文件已存在，就获取这个zip文件的crc32的值
-                u32 zip_file_crc32 = file_stat.m_crc32;  // 获取ZIP中文件的CRC32值
-                // 计算目标文件的CRC32进行比较
-                u32 existing_file_crc32 = GetFileCrc32(target_file_path.c_str());
-                if (zip_file_crc32 != existing_file_crc32) {
-                    // 校验不同，代表是同名文件(本质不同的文件) (Verification failed, indicating same-name files with different content)
-                    is_error = true;
-                    // 从zip_path中提取/mods2/游戏名/id/mod名字路径 (Extract mod directory path from zip_path)
-                    std::string mod_dir_path = zip_path.substr(0, zip_path.rfind('/'));
-                    // 检查是哪个mod冲突 (Check which mod is conflicting)
-                    GetConflictingModNames(mod_dir_path, target_file_path, progress_callback, error_callback, stop_token);
-                    goto cleanup;
-                }
+        if (mz_zip_reader_is_file_a_directory(zip_archive, i)) {
+            continue;
+        }
 
-                // 缓存发生冲突且通过CRC32校验的目标文件路径
-                cached_conflicting_files.push_back(target_file_path);
-                
-            } else files_to_extract.push_back(i); // 缓存过滤后需要解压的文件索引
+        std::string target_file_path;
+        target_file_path.reserve(target_directory_zip.length() + filename.length());
+        target_file_path = target_directory_zip;
+        target_file_path += filename;
 
-            
-            size_t last_slash = filename.find_last_of('/');
-            if (last_slash != std::string::npos) {
-                // 使用string_view避免字符串拷贝，优化路径解析性能
-                // 直接使用指针和长度，避免substr的拷贝开销
-                const char* relative_dir_data = filename.c_str();
-                size_t relative_dir_length = last_slash;
-                
-                // 预分配基础路径，减少重复的字符串拼接开销
-                std::string base_path;
-                base_path.reserve(target_directory_zip.length() + last_slash + 1);
-                base_path = target_directory_zip;
-                
-                // 一次性遍历路径，收集所有父目录层次（避免重复find操作）
-                  for (size_t pos = 0; pos < relative_dir_length; ++pos) {
-                      if (relative_dir_data[pos] == '/') {
-                          // 构建父目录路径（从开始到当前斜杠位置）
-                          std::string parent_dir;
-                          parent_dir.reserve(base_path.length() + pos);
-                          parent_dir = base_path;
-                          parent_dir.append(relative_dir_data, pos);
-                          all_directories.push_back(std::move(parent_dir));
-                      }
-                  }
-                 
-                 // 添加完整的目录路径（直接使用指针数据，避免额外拷贝）
-                  std::string full_dir_path;
-                  full_dir_path.reserve(base_path.length() + relative_dir_length);
-                  full_dir_path = base_path;
-                  full_dir_path.append(relative_dir_data, relative_dir_length);
-                  all_directories.push_back(std::move(full_dir_path));
-            }
-            
-            files_total++;
+        // 中央目录已给出大小和CRC32 (The central directory already has size and CRC32)
+        PlannedFile planned_file{"", i, target_file_path, file_stat.m_uncomp_size, file_stat.m_crc32};
 
-            // 每500个文件更新一次进度
-            if (progress_callback && files_total % 500 == 0 ) {
-                progress_callback(0, files_total, CALCULATE_FILES, false, 0.0f, "", COLOR_BLUE);
+        // 使用access()检查目标文件是否存在，存在的文件安装时再校验CRC32 (Check existence with access(), existing targets are CRC32-checked on install)
+        if (access(target_file_path.c_str(), F_OK) == 0) {
+            plan.existing_files.push_back(std::move(planned_file));
+        } else {
+            plan.files.push_back(std::move(planned_file));
+        }
+
+        size_t last_slash = filename.find_last_of('/');
+        if (last_slash != std::string::npos) {
+            // 一次性遍历路径，收集所有父目录层次（避免重复find操作）
+            for (size_t pos = 0; pos < last_slash; ++pos) {
+                if (filename[pos] == '/') {
+                    std::string parent_dir;
+                    parent_dir.reserve(target_directory_zip.length() + pos);
+                    parent_dir = target_directory_zip;
+                    parent_dir.append(filename, 0, pos);
+                    plan.directories.push_back(std::move(parent_dir));
+                }
             }
 
+            // 添加完整的目录路径 (Add the full directory path)
+            std::string full_dir_path;
+            full_dir_path.reserve(target_directory_zip.length() + last_slash);
+            full_dir_path = target_directory_zip;
+            full_dir_path.append(filename, 0, last_slash);
+            plan.directories.push_back(std::move(full_dir_path));
         }
+        
+        files_total++;
 
-    }
-
-
-    // 第二阶段：检查收集到的目录的合法性 (Phase 2: Check validity of collected directories)
-    if (first_level_dirs.size() > 2 || first_level_dirs.empty()) {
-        is_error = true;
-        if (error_callback) {
-            error_callback(FILE_NONE);
+        // 每500个文件更新一次进度
+        if (progress_callback && files_total % 500 == 0) {
+            progress_callback(0, files_total, CALCULATE_FILES, false, 0.0f, "", COLOR_BLUE);
         }
-        goto cleanup;
     }
 
-    for (const std::string& dir_name : first_level_dirs) {
-        if (dir_name != "contents" && dir_name != "exefs_patches") {
-            is_error = true;
-            if (error_callback) {
-                error_callback(FILE_NONE + dir_name);
+    // 检查第一层目录的合法性 (Check validity of first-level directories)
+    if (first_level_dirs.size() > 2 || first_level_dirs.empty()) {
+        plan.layout_error = FILE_NONE;
+    } else {
+        for (const std::string& dir_name : first_level_dirs) {
+            if (dir_name != "contents" && dir_name != "exefs_patches") {
+                plan.layout_error = FILE_NONE + dir_name;
+                break;
             }
-            goto cleanup;
         }
     }
-    
-    // 使用批量创建目录函数优化性能 (Use batch directory creation function to optimize performance)
-    if (!createDirectoriesBatch(all_directories, progress_callback, num_files, error_callback, stop_token)) {
-        is_error = true;
-        goto cleanup;
-    }
-    
-    // 目录创建成功后及时清除目录列表，释放内存 (Clear directory list promptly after successful creation to free memory)
-    all_directories.clear();
-    all_directories.shrink_to_fit();
-    
-    // 直接解压到atmosphere目录（目录已预创建） (Extract directly to atmosphere directory - directories pre-created)
-    extract_success = extractMod(zip_path, files_total, files_to_extract, progress_callback, error_callback, stop_token, &zip_archive);
-    
-    if (!extract_success) {
-        is_error = true;
-        goto cleanup;
-    }
-    
-    // 解压安装成功则将冲突文件写入本地 (Cache conflicting files locally if extraction succeeds)
-    CachedConflictingFiles(zip_path, progress_callback);
 
-cleanup:
-    // 统一资源清理 (Unified resource cleanup)
-    if (zip_initialized) {
-        mz_zip_reader_end(&zip_archive);
-    }
-    
-    // 清理目录列表内存 (Clean up directory list memory)
-    all_directories.clear();
-    all_directories.shrink_to_fit();
-    
-    // 根据状态返回结果 (Return result based on status)
-    if (is_stopped) {
-        return false; // 用户停止请求 (User stop request)
-    }
-    
-    return !is_error; // 成功返回true，错误返回false (Return true on success, false on error)
+    FinishInstallPlan(plan);
+    return true;
 }
 
-bool ModManager::installModFromFolder(const std::string& folder_path,
-                                      ProgressCallback progress_callback,
-                                      ErrorCallback error_callback,
-                                      std::stop_token stop_token) {
-
-    
+// 只读取文件夹目录项生成安装计划 (Build an install plan from the folder's directory entries only)
+bool ModManager::PlanFolderInstall(const std::string& folder_path,
+                                   InstallPlan& plan,
+                                   ProgressCallback progress_callback,
+                                   ErrorCallback error_callback,
+                                   std::stop_token stop_token) {
 
     if (progress_callback) {
         progress_callback(0, 0, CALCULATE_FILES, false, 0.0f, "", COLOR_BLUE);
     }
 
+    plan = InstallPlan{};
+    plan.source_path = folder_path;
+    plan.is_zip = false;
+
     // 检查MOD结构是否有效 (Check if MOD structure is valid)
     DIR* dir = opendir(folder_path.c_str());
     if (!dir) {
@@ -1294,8 +1641,6 @@ bool ModManager::installModFromFolder(const std::string& folder_path,
     
     struct dirent* entry;
     while ((entry = readdir(dir)) != nullptr) {
-
-        
         if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
             continue;
         }
@@ -1319,252 +1664,373 @@ bool ModManager::installModFromFolder(const std::string& folder_path,
     
     // 检查MOD结构合法性 (Check MOD structure validity)
     if ((!has_contents && !has_exefs_patches) || has_other_items) {
-        if (error_callback) {
-            error_callback(FILE_NONE);
-        }
-        return false;
+        plan.layout_error = FILE_NONE;
+        return true;
     }
-    
-    // FileInfo结构体现在定义在头文件中 (FileInfo structure is now defined in header file)
-    
-    // 统计文件数量并缓存路径 (Count files and cache paths)
-    std::vector<FileInfo> cached_files; // 存储文件信息 (Store file information)
-    cached_files.reserve(3000); // 预分配3000个FileInfo容量，避免频繁重分配 (Pre-allocate capacity for 3000 FileInfo to avoid frequent reallocation)
-    
-    std::vector<std::string> directories_to_create; // 存储需要创建的目录路径 (Store directory paths to be created)
-    directories_to_create.reserve(500); // 预分配500个目录容量，通常足够使用 (Pre-allocate capacity for 500 directories, usually sufficient)
-    size_t total_files = 0;
+
+    // 目录条目结构体 (Directory entry structure)
+    struct DirEntry {
+        std::string source_path;
+        std::string target_path;
+    };
+
+    // 使用栈来模拟递归 (Use stack to simulate recursion)
+    std::vector<DirEntry> dir_stack;
+    dir_stack.reserve(128);
+    if (has_contents) {
+        dir_stack.push_back({folder_path + "/contents", target_directory_zip + "contents"});
+    }
+    if (has_exefs_patches) {
+        dir_stack.push_back({folder_path + "/exefs_patches", target_directory_zip + "exefs_patches"});
+    }
+
     size_t global_file_count = 0; // 全局累计计数器 (Global cumulative counter)
-    bool countFuncErr = false;
-    
-    // 内联迭代式统计文件的实现，避免std::function开销 (Inline iterative file counting implementation to avoid std::function overhead)
-    auto count_files_impl = [&](const std::string& initial_source_path, const std::string& initial_target_path, std::stop_token stop_token) -> size_t {
-        
-        // 目录条目结构体，使用移动语义减少拷贝 (Directory entry structure with move semantics to reduce copying)
-        struct DirEntry {
-            std::string source_path;
-            std::string target_path;
-            
-            // 支持移动构造，减少字符串拷贝 (Support move construction to reduce string copying)
-            DirEntry(std::string src, std::string tgt) 
-                : source_path(std::move(src)), target_path(std::move(tgt)) {}
-        };
+
+    // 迭代处理栈中的目录 (Iteratively process directories in stack)
+    while (!dir_stack.empty()) {
+        // 检查是否被请求停止 (Check if stop requested)
+        if (stop_token.stop_requested()) {
+            return false;
+        }
         
-        // 使用栈来模拟递归 (Use stack to simulate recursion)
-        std::vector<DirEntry> dir_stack;
-        dir_stack.reserve(128); // 预分配栈空间，避免频繁重分配 (Pre-allocate stack space to avoid frequent reallocation)
-        dir_stack.emplace_back(std::string(initial_source_path), std::string(initial_target_path));
+        DirEntry current_dir = std::move(dir_stack.back());
+        dir_stack.pop_back();
         
-        size_t total_count = 0; // 总文件数 (Total file count)
+        DIR* dir = opendir(current_dir.source_path.c_str());
+        if (!dir) {
+            // 无法打开源目录，输出错误信息用于诊断 (Cannot open source directory, output error for diagnosis)
+            if (error_callback) {
+                error_callback(CANT_OPEN_FILE + current_dir.source_path + ", errno: " + std::to_string(errno));
+            }
+            return false;
+        }
         
-        // 迭代处理栈中的目录 (Iteratively process directories in stack)
-        while (!dir_stack.empty() && !countFuncErr) {
-            // 检查是否被请求停止 (Check if stop requested)
-            if (stop_token.stop_requested()) {
-                return total_count;
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+                continue;
             }
             
-            // 从栈顶取出目录 (Pop directory from stack top)
-            DirEntry current_dir = std::move(dir_stack.back());
-            dir_stack.pop_back();
+            std::string source_file_path = current_dir.source_path + "/" + entry->d_name;
+            std::string target_file_path = current_dir.target_path + "/" + entry->d_name;
             
-            // 打开当前目录 (Open current directory)
-            DIR* dir = opendir(current_dir.source_path.c_str());
-            if (!dir) {
-                // 标记有错误 (Mark error)
-                countFuncErr = true;
-                // 无法打开源目录，输出错误信息用于诊断 (Cannot open source directory, output error for diagnosis)
-                if (error_callback) {
-                    error_callback(CANT_OPEN_FILE + current_dir.source_path + ", errno: " + std::to_string(errno));
-                }
-                return total_count;
-            }
-            
-            struct dirent* entry;
-            while ((entry = readdir(dir)) != nullptr && !countFuncErr) {
-                // 检查是否被请求停止 (Check if stop requested)
-                if (stop_token.stop_requested()) {
+            // 直接使用d_type判断文件类型，避免stat()系统调用 (Use d_type directly to determine file type, avoiding stat() system call)
+            if (entry->d_type == DT_DIR) {
+                // 收集目录路径，延迟创建 (Collect directory path for delayed creation)
+                plan.directories.push_back(target_file_path);
+                dir_stack.push_back({std::move(source_file_path), std::move(target_file_path)});
+            } else if (entry->d_type == DT_REG) {
+                // 获取文件大小 (Get file size)
+                struct stat file_stat;
+                if (stat(source_file_path.c_str(), &file_stat) != 0) {
+                    if (error_callback) {
+                        error_callback("Cannot get file info: " + source_file_path + ", errno: " + std::to_string(errno));
+                    }
                     closedir(dir);
-                    return total_count;
+                    return false;
                 }
-                
-                if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-                    continue;
+
+                // 文件夹MOD的CRC32在复制时才计算 (Folder MOD CRC32s are only computed while copying)
+                PlannedFile planned_file{std::move(source_file_path), -1, target_file_path, static_cast<u64>(file_stat.st_size), 0};
+
+                // 使用access()检查目标文件是否存在，存在的文件安装时再校验CRC32 (Check existence with access(), existing targets are CRC32-checked on install)
+                if (access(target_file_path.c_str(), F_OK) == 0) {
+                    plan.existing_files.push_back(std::move(planned_file));
+                } else {
+                    plan.files.push_back(std::move(planned_file));
                 }
-                
-                // 直接构造路径字符串，避免clear+append的开销 (Directly construct path strings to avoid clear+append overhead)
-                const std::string source_file_path = current_dir.source_path + "/" + entry->d_name;
-                const std::string target_file_path = current_dir.target_path + "/" + entry->d_name;
-                
-                // 直接使用d_type判断文件类型，避免stat()系统调用 (Use d_type directly to determine file type, avoiding stat() system call)
-                if (entry->d_type == DT_DIR) {
-                    // 检查是否需要扩容：当使用率达到80%时增加500个容量 (Check if expansion needed: add 500 capacity when 80% full)
-                    if (directories_to_create.size() >= directories_to_create.capacity() * 0.8) {
-                        directories_to_create.reserve(directories_to_create.capacity() + 100);
-                    }
-                    // 收集目录路径，延迟创建 (Collect directory path for delayed creation)
-                    directories_to_create.push_back(target_file_path);
-                    // 将子目录推入栈中处理 (Push subdirectory into stack for processing)
-                    dir_stack.emplace_back(source_file_path, target_file_path);
-                } else if (entry->d_type == DT_REG) {
-                    // 使用access()检查文件是否存在（F_OK表示检查文件存在性）
-                    if (access(target_file_path.c_str(), F_OK) == 0) {
-                        if (progress_callback) progress_callback(0, global_file_count, "校验CRC32冲突...", false, 0.0f, "", COLOR_BLUE);
-                        // 计算源文件的CRC32进行比较
-                        u32 source_file_crc32 = GetFileCrc32(source_file_path.c_str());
-                        // 计算目标文件的CRC32进行比较
-                        u32 target_file_crc32 = GetFileCrc32(target_file_path.c_str());
-                        // 比较CRC32值 (Compare CRC32 values)
-                        if (source_file_crc32 != target_file_crc32) {
-                            // 检查是哪个mod冲突 (Check which mod conflicts)
-                            GetConflictingModNames(folder_path, target_file_path, progress_callback, error_callback, stop_token);
-                            // 标记有错误 (Mark error)
-                            countFuncErr = true;
-                            // 存在冲突，停止循环 (Conflict exists, stop loop)
-                            closedir(dir);
-                            return total_count;
-                        }
+                global_file_count++;
 
-                        // 缓存发生冲突且通过CRC32校验的目标文件路径
-                        cached_conflicting_files.push_back(target_file_path);
-                        total_count++;
-                        global_file_count++;
-                        // 跳过这个文件路径
-                        continue;
-                        
-                    }
-                    
-                    // 获取文件大小并缓存文件信息 (Get file size and cache file info)
-                    struct stat file_stat;
-                    if (stat(source_file_path.c_str(), &file_stat) == 0) {
-                        // 检查是否需要扩容：当使用率达到80%时增加3000个容量 (Check if expansion needed: add 3000 capacity when 80% full)
-                        if (cached_files.size() >= cached_files.capacity() * 0.8) {
-                            cached_files.reserve(cached_files.capacity() + 3000);
-                        }
-                        
-                        // 存储文件信息到结构体，直接在容器内构造避免临时对象 (Store file info to structure, construct in-place to avoid temporary objects)
-                        cached_files.emplace_back(source_file_path, target_file_path, static_cast<size_t>(file_stat.st_size));
-                        total_count++;
-                        global_file_count++; // 增加全局计数器 (Increment global counter)
-                    } else {
-                        // 处理获取文件信息失败的情况 (Handle file info retrieval failure)
-                        // 标记有错误 (Mark error)
-                        countFuncErr = true;
-                        if (error_callback) {
-                            error_callback("Cannot get file info: " + source_file_path + ", errno: " + std::to_string(errno));
-                        }
-                        closedir(dir);
-                        return total_count;
-                    }
-                    
-                    // 每10个文件更新一次进度，使用全局计数器 (Update progress every 10 files using global counter)
-                    if (global_file_count % 10 == 0 && progress_callback) {
-                        progress_callback(0, global_file_count, CALCULATE_FILES, false, 0.0f, "", COLOR_BLUE);
-                    }
+                // 每10个文件更新一次进度，使用全局计数器 (Update progress every 10 files using global counter)
+                if (global_file_count % 10 == 0 && progress_callback) {
+                    progress_callback(0, global_file_count, CALCULATE_FILES, false, 0.0f, "", COLOR_BLUE);
                 }
             }
-            
-            closedir(dir);
         }
         
-        return total_count;
-    };
+        closedir(dir);
+    }
 
-    
-    // 统计contents目录 (Count contents directory) - 优化路径拼接
-    if (has_contents) {
-        std::string contents_path;
-        contents_path.reserve(folder_path.length() + 11); // "/contents" = 10 chars + 1
-        contents_path = folder_path;
-        contents_path += "/contents";
-        
-        std::string target_contents;
-        target_contents.reserve(target_directory_zip.length() + 9); // "contents" = 8 chars + 1
-        target_contents = target_directory_zip;
-        target_contents += "contents";
-        
-        total_files += count_files_impl(contents_path, target_contents, stop_token);
+    FinishInstallPlan(plan);
+    return true;
+}
+
+// 汇总安装计划：目录去重、空间估算 (Finish an install plan: deduplicate directories, estimate space)
+void ModManager::FinishInstallPlan(InstallPlan& plan) {
+
+    std::sort(plan.directories.begin(), plan.directories.end());
+    plan.directories.erase(std::unique(plan.directories.begin(), plan.directories.end()), plan.directories.end());
+
+    // 按簇向上取整估算占用空间，每个尚不存在的目录至少占用一个簇 (Estimate usage rounded up to clusters, each directory
+    // that doesn't exist yet takes at least one cluster)
+    // libnx的statvfs把f_frsize报告为1，此时按32 KiB簇估算，结果只作为警告 (libnx's statvfs reports f_frsize as 1, estimate
+    // with 32 KiB clusters then and treat the result as a warning only)
+    struct statvfs fs_stat;
+    bool has_fs_stat = statvfs(target_directory_zip.c_str(), &fs_stat) == 0 && fs_stat.f_frsize > 0;
+    bool cluster_size_known = has_fs_stat && fs_stat.f_frsize >= MIN_CLUSTER_SIZE;
+    u64 cluster_size = cluster_size_known ? static_cast<u64>(fs_stat.f_frsize) : DEFAULT_CLUSTER_SIZE;
+
+    plan.total_bytes = 0;
+    plan.required_bytes = 0;
+    for (const auto& planned_file : plan.files) {
+        plan.total_bytes += planned_file.size;
+        plan.required_bytes += (planned_file.size + cluster_size - 1) / cluster_size * cluster_size;
     }
+    for (const auto& dir_path : plan.directories) {
+        if (access(dir_path.c_str(), F_OK) != 0) {
+            plan.required_bytes += cluster_size;
+        }
+    }
+
+    // 无法获取剩余空间时不阻止安装；文件字节数本身都放不下时无论簇大小如何都装不下
+    // (Do not block the install when free space is unknown; if even the raw file bytes don't fit, no cluster size helps)
+    if (has_fs_stat) {
+        plan.free_bytes = static_cast<u64>(fs_stat.f_bavail) * static_cast<u64>(fs_stat.f_frsize);
+        plan.has_enough_space = plan.required_bytes <= plan.free_bytes;
+        plan.space_check_exact = cluster_size_known || plan.total_bytes > plan.free_bytes;
+    }
+}
+
+// 已存在的目标文件通过冲突索引查询所有者，无需读取文件内容 (Owners of existing targets come from the conflict index, no file content is read)
+void ModManager::FindConflictOwners(InstallPlan& plan) {
 
-    if (countFuncErr) {
-        // 统计函数报错，早于数量检测，避免错误信息被覆盖
+    plan.conflict_owners.clear();
+    if (plan.existing_files.empty()) {
+        return;
+    }
+
+    tj::ConflictIndex conflict_index(GetConflictIndexPath(plan.source_path));
+    std::string current_mod_key = GetModKeyName(plan.source_path);
+    std::set<std::string> owners_found;
+    std::vector<std::string> owners;
+    for (const auto& existing_file : plan.existing_files) {
+        if (conflict_index.Lookup(existing_file.target_path, owners)) {
+            for (auto& owner : owners) {
+                if (owner != current_mod_key) {
+                    owners_found.insert(std::move(owner));
+                }
+            }
+        }
+    }
+    plan.conflict_owners.assign(owners_found.begin(), owners_found.end());
+}
+
+// 按安装计划执行安装 (Install according to a plan)
+bool ModManager::InstallFromPlan(const InstallPlan& plan,
+                                 ProgressCallback progress_callback,
+                                 ErrorCallback error_callback,
+                                 std::stop_token stop_token) {
+
+    if (!plan.layout_error.empty()) {
+        if (error_callback) {
+            error_callback(plan.layout_error);
+        }
+        return false;
+    }
+
+    if (plan.files.empty() && plan.existing_files.empty()) {
+        if (error_callback) {
+            error_callback(FILE_NONE);
+        }
         return false;
     }
 
-    // 统计exefs_patches目录 (Count exefs_patches directory) - 优化路径拼接
-    if (has_exefs_patches) {
-        std::string exefs_path;
-        exefs_path.reserve(folder_path.length() + 16); // "/exefs_patches" = 15 chars + 1
-        exefs_path = folder_path;
-        exefs_path += "/exefs_patches";
-        
-        std::string target_exefs;
-        target_exefs.reserve(target_directory_zip.length() + 15); // "exefs_patches" = 14 chars + 1
-        target_exefs = target_directory_zip;
-        target_exefs += "exefs_patches";
-        
-        total_files += count_files_impl(exefs_path, target_exefs, stop_token);
+    // 簇大小未知时估算可能偏大，空间不足只在确定时拒绝，否则交给实际写入判断
+    // (The estimate may be too high when the cluster size is unknown, so a shortage only refuses when it is certain and
+    // otherwise the actual writes decide)
+    if (!plan.has_enough_space && plan.space_check_exact) {
+        if (error_callback) {
+            error_callback(NOT_ENOUGH_SPACE + std::to_string(plan.required_bytes / (1024 * 1024)) + " MB / " +
+                           std::to_string(plan.free_bytes / (1024 * 1024)) + " MB");
+        }
+        return false;
+    }
+
+    cached_manifest_entries.clear();
+    cached_conflicting_files.clear();
+    crc32_cache.Open(GetCrc32CachePath(plan.source_path));
+
+    // 目标已存在的文件：CRC32一致视为共用文件，不一致则报告冲突MOD (Existing targets: a matching CRC32 means a shared file, otherwise report the conflicting MOD)
+    for (const auto& existing_file : plan.existing_files) {
+        if (stop_token.stop_requested()) {
+            return false;
+        }
+
+        if (progress_callback) progress_callback(0, plan.existing_files.size(), "校验CRC32冲突...", false, 0.0f, "", COLOR_BLUE);
+
+        u32 source_file_crc32 = plan.is_zip ? existing_file.file_crc32 : GetFileCrc32(existing_file.source_path.c_str());
+        u32 target_file_crc32 = GetFileCrc32(existing_file.target_path.c_str());
+        if (source_file_crc32 != target_file_crc32) {
+            // 校验不同，代表是同名文件(本质不同的文件)，检查是哪个mod冲突 (Different content under the same name, find the conflicting MOD)
+            std::string mod_dir_path = plan.is_zip ? plan.source_path.substr(0, plan.source_path.rfind('/')) : plan.source_path;
+            GetConflictingModNames(mod_dir_path, existing_file.target_path, progress_callback, error_callback, stop_token);
+            cached_manifest_entries.clear();
+            cached_conflicting_files.clear();
+            return false;
+        }
+
+        // 缓存发生冲突且通过CRC32校验的目标文件路径，共享文件同样记录到安装清单
+        // (Cache target paths that conflict but pass the CRC32 check, shared files go into the install manifest as well)
+        cached_conflicting_files.push_back(existing_file.target_path);
+        cached_manifest_entries.push_back({existing_file.target_path, existing_file.size, source_file_crc32});
     }
-    
-    if (countFuncErr) {
-        // 统计函数报错，早于数量检测，避免错误信息被覆盖
+
+    if (plan.files.empty()) {
+        if (error_callback) {
+            error_callback("请勿安装重复的MOD！");
+        }
+        cached_manifest_entries.clear();
+        cached_conflicting_files.clear();
         return false;
     }
 
-
-    // 统计完成后显示最终的文件总数 (Show final total file count after counting)
-    if (progress_callback && global_file_count > 0) {
-        progress_callback(0, global_file_count, CALCULATE_FILES, false, 0.0f, "", COLOR_BLUE);
+    // 开始安装日志，写入目标目录前先刷新到SD卡；日志写不了就没有崩溃保护，不能继续安装
+    // (Begin the install journal and flush it to the SD card before the target directory is touched; without a journal
+    // there is no crash protection, so the install must not proceed)
+    bool journal_ready = install_journal.Begin(plan.source_path);
+    if (journal_ready) {
+        for (const auto& planned_file : plan.files) {
+            install_journal.RecordFile(planned_file.target_path);
+        }
+        for (const auto& dir_path : plan.directories) {
+            install_journal.RecordDirectory(dir_path);
+        }
+        journal_ready = install_journal.Sync();
     }
-    
-    
-
-    if (total_files == 0) {
+    if (!journal_ready) {
+        install_journal.End();
+        cached_manifest_entries.clear();
+        cached_conflicting_files.clear();
         if (error_callback) {
-            error_callback(FILE_NONE);
+            error_callback(CANT_WRITE_ERROR + std::string(tj::InstallJournal::JOURNAL_PATH));
         }
         return false;
     }
 
-
     // 批量创建所有目录 (Batch create all directories)
-    if (!createDirectoriesBatch(directories_to_create, progress_callback, total_files, error_callback, stop_token)) {
-        // 创建失败时及时清除目录列表，释放内存 (Clear directory list promptly on failure to free memory)
-        directories_to_create.clear();
-        directories_to_create.shrink_to_fit();
+    std::vector<std::string> directories_to_create = plan.directories;
+    if (!createDirectoriesBatch(directories_to_create, progress_callback, plan.files.size(), error_callback, stop_token)) {
+        install_journal.End();
+        cached_manifest_entries.clear();
+        cached_conflicting_files.clear();
         return false;
     }
-    
-    // 目录创建成功后及时清除目录列表，释放内存 (Clear directory list promptly after successful creation to free memory)
     directories_to_create.clear();
     directories_to_create.shrink_to_fit();
-    
-    // 检查是否需要停止 (Check if stop is requested)
-    if (stop_token.stop_requested()) {
-        
-        return false;
+
+    bool install_success = false;
+    if (plan.is_zip) {
+        // 流水线解压到atmosphere目录（目录已预创建） (Pipelined extraction to atmosphere directory - directories pre-created)
+        std::vector<int> files_to_extract;
+        files_to_extract.reserve(plan.files.size());
+        for (const auto& planned_file : plan.files) {
+            files_to_extract.push_back(planned_file.zip_index);
+        }
+        int files_total = static_cast<int>(files_to_extract.size());
+        install_success = extractModPipelined(plan.source_path, files_total, files_to_extract, progress_callback, error_callback, stop_token, plan.zip_archive.get());
+
+        // 中央目录已给出大小和CRC32，直接记录到安装清单 (Central directory already has size and CRC32, record them for the install manifest)
+        if (install_success) {
+            cached_manifest_entries.reserve(cached_manifest_entries.size() + plan.files.size());
+            for (const auto& planned_file : plan.files) {
+                cached_manifest_entries.push_back({planned_file.target_path, planned_file.size, planned_file.file_crc32});
+            }
+        }
+    } else if (stop_token.stop_requested()) {
+        // 目录已创建但还没复制文件，下面按日志回滚 (Directories are created but nothing is copied yet, rolled back from
+        // the journal below)
+    } else {
+        std::vector<FileInfo> file_info_list;
+        file_info_list.reserve(plan.files.size());
+        for (const auto& planned_file : plan.files) {
+            file_info_list.push_back({planned_file.source_path, planned_file.target_path, static_cast<size_t>(planned_file.size)});
+        }
+
+        // 使用批量复制优化性能，复制时顺带计算CRC32供安装清单使用 (Use batch copy to optimize performance, computing CRC32 along the way for the install manifest)
+        std::vector<u32> copied_crc32s;
+        install_success = copyFilesBatch(file_info_list, progress_callback, error_callback, stop_token, &copied_crc32s);
+        if (install_success) {
+            cached_manifest_entries.reserve(cached_manifest_entries.size() + file_info_list.size());
+            for (size_t i = 0; i < file_info_list.size(); ++i) {
+                cached_manifest_entries.push_back({file_info_list[i].target_path, file_info_list[i].file_size, copied_crc32s[i]});
+            }
+        }
     }
-    
-    // 使用批量复制优化性能 (Use batch copy to optimize performance)
-    if (!copyFilesBatch(cached_files, progress_callback, error_callback, stop_token)) {
+
+    // 取消或出错时按安装日志回滚，与启动时的恢复走同一条路径 (Roll back from the install journal on cancel or error,
+    // the same path recovery takes at launch)
+    if (!install_success) {
+        RollbackInstall(progress_callback, plan.files.size(), !stop_token.stop_requested());
+        cached_manifest_entries.clear();
+        cached_conflicting_files.clear();
         return false;
     }
 
-    // 及时清理缓存的文件路径，释放内存 (Clean up cached file paths promptly to free memory)
-    cached_files.clear();
-    cached_files.shrink_to_fit();
+    // 安装成功则将冲突文件写入本地。原计数在提交前已记入日志，日志结束之前中断时启动恢复会把计数设回原值；
+    // 日志或账本写入失败时回滚本次安装，否则共用计数偏低会让之后的卸载删掉仍被使用的文件
+    // (Cache conflicting files locally if the install succeeds. The previous counts are journaled before the commit, so
+    // recovery sets them back if the install is cut off before the journal ends; roll the install back if the journal or
+    // ledger cannot be written, otherwise the low shared counts would let a later uninstall remove files that are still
+    // in use)
+    std::string failed_path;
+    std::vector<std::pair<std::string, u32>> previous_counts;
+    if (!CachedConflictingFiles(plan.source_path, progress_callback, previous_counts)) {
+        if (previous_counts.empty()) {
+            failed_path = tj::InstallJournal::JOURNAL_PATH;
+        } else {
+            failed_path = GetModFileCommonPath(plan.source_path);
+        }
+    }
+
+    // 回放日志同时把已记录的共用计数设回原值 (Replaying the journal also sets the journaled shared counts back)
+    if (!failed_path.empty()) {
+        RollbackInstall(progress_callback, plan.files.size(), true);
+        cached_manifest_entries.clear();
+        cached_conflicting_files.clear();
+        if (error_callback) {
+            error_callback(CANT_WRITE_ERROR + failed_path);
+        }
+        return false;
+    }
 
-    CachedConflictingFiles(folder_path, progress_callback);
+    // 写入安装清单和冲突索引，失败不影响安装结果 (Write the install manifest and conflict index, failure is not fatal)
+    RecordInstalledFiles(plan.source_path, plan.is_zip ? tj::InstallManifest::GetFileFingerprint(plan.source_path) : 0);
+    cached_manifest_entries.clear();
+    cached_manifest_entries.shrink_to_fit();
 
+    install_journal.End();
     return true;
 }
 
+bool ModManager::installModFromZipDirect(const std::string& zip_path,
+                                        ProgressCallback progress_callback,
+                                        ErrorCallback error_callback,
+                                        std::stop_token stop_token) {
+    InstallPlan plan;
+    if (!PlanZipInstall(zip_path, plan, progress_callback, error_callback, stop_token)) {
+        return false;
+    }
+    return InstallFromPlan(plan, progress_callback, error_callback, stop_token);
+}
+
+bool ModManager::installModFromFolder(const std::string& folder_path,
+                                      ProgressCallback progress_callback,
+                                      ErrorCallback error_callback,
+                                      std::stop_token stop_token) {
+    InstallPlan plan;
+    if (!PlanFolderInstall(folder_path, plan, progress_callback, error_callback, stop_token)) {
+        return false;
+    }
+    return InstallFromPlan(plan, progress_callback, error_callback, stop_token);
+}
+
 // 非顺序写入，比copyFilesBatch2快20-30s
 // 批量文件复制函数 - 优化版本，减少文件句柄开关和缓冲区分配
 bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
                                ProgressCallback progress_callback,
                                ErrorCallback error_callback,
-                               std::stop_token stop_token) {
+                               std::stop_token stop_token,
+                               std::vector<u32>* file_crc32s) {
 
     int copied_files = 0; // 已复制文件数量 (Number of copied files)
     int total_files = file_info_list.size();
@@ -1576,22 +2042,22 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
         return false;
     }
 
-    // 已经复制的文件路径
-    std::vector<std::string> copied_files_list;
+    
+    // 每个文件的CRC32，读取源数据时顺带计算 (Per-file CRC32, computed while reading the source data)
+    if (file_crc32s) {
+        file_crc32s->assign(file_info_list.size(), 0);
+    }
     
     // SD卡块对齐优化策略 (SD Card Block Alignment Optimization Strategy)
     const size_t SD_BLOCK_SIZE = 64 * 1024; // 64KB SD卡块大小
     const size_t ALIGNED_BUFFER_SIZE = 32 * 1024 * 1024; // 16MB 对齐缓冲区 (256个块)
     const size_t SMALL_FILE_THRESHOLD = 8 * 1024 * 1024;   // 8MB 小文件阈值
-    const size_t BATCH_MEMORY_LIMIT = 32 * 1024 * 1024; // 32MB 批量内存限制
     
     
     // 资源管理变量 (Resource management variables)
     char* aligned_buffer = nullptr;
     FILE* source_file = nullptr;
     FILE* dest_file = nullptr;
-    bool is_error = false;
-    bool is_stopped = false;
     
     // 分配块对齐缓冲区 (Allocate block-aligned buffers)
     // Switch平台使用memalign进行内存对齐到SD卡块边界
@@ -1619,8 +2085,17 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
     
     
     
-    // 优化：单次遍历处理，小文件累积到内存池，大文件立即处理 (Optimization: single-pass processing, accumulate small files in memory pool, process large files immediately)
-    std::vector<std::pair<std::string, std::vector<char>>> cached_files;
+    // 优化：单次遍历处理，小文件累积到对齐缓冲区（作为内存池），大文件立即处理
+    // (Optimization: single-pass processing, small files accumulate in the aligned buffer used as an arena, large files are processed immediately)
+    // 小文件只记录在缓冲区中的偏移和长度，不再逐个分配内存；大文件处理前总会先写出小文件，两者不会同时占用缓冲区
+    // (Small files are only offset/length descriptors into the buffer, no per-file allocation; cached small files are always
+    // flushed before a large file is processed, so the two never use the buffer at the same time)
+    struct CachedSmallFile {
+        const FileInfo* file_info;
+        size_t offset;
+        size_t size;
+    };
+    std::vector<CachedSmallFile> cached_files;
     size_t total_cached_size = 0;
     
     // 批量写入缓存小文件的辅助函数 (Helper function to batch write cached small files)
@@ -1628,42 +2103,41 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
         for (const auto& cached : cached_files) {
             // 检查是否需要停止 (Check if stop is requested)
             if (stop_token.stop_requested()) {
-                is_stopped = true;
                 return false;
             }
             
-            dest_file = fopen(cached.first.c_str(), "wb");
+            const std::string& target_path = cached.file_info->target_path;
+            dest_file = fopen(target_path.c_str(), "wb");
             if (dest_file) {
-                // SD卡块对齐写入优化 (SD Card block-aligned write optimization)
-                setvbuf(dest_file, nullptr, _IOFBF, ALIGNED_BUFFER_SIZE);
+                // 数据已在内存中，关闭stdio缓冲直接写入，避免每个文件分配一次缓冲区 (Data is already in memory, write unbuffered to avoid allocating a stdio buffer per file)
+                setvbuf(dest_file, nullptr, _IONBF, 0);
                 
-                size_t written = fwrite(cached.second.data(), 1, cached.second.size(), dest_file);
+                size_t written = fwrite(aligned_buffer + cached.offset, 1, cached.size, dest_file);
                 fclose(dest_file);
                 dest_file = nullptr; // 立即重置文件句柄，确保所有分支都安全
                 
-                if (written == cached.second.size()) {
+                if (written == cached.size) {
                     copied_files++;
                     if (progress_callback) {
-                        size_t last_slash = cached.first.find_last_of('/');
+                        size_t last_slash = target_path.find_last_of('/');
                         const char* filename_ptr = (last_slash != std::string::npos) ? 
-                            cached.first.c_str() + last_slash + 1 : cached.first.c_str();
+                            target_path.c_str() + last_slash + 1 : target_path.c_str();
                         progress_callback(copied_files, total_files, filename_ptr, false, 0.0f, "", COLOR_BLUE);
                     }
                 } else {
                     if (error_callback) {
-                        error_callback(CANT_WRITE_ERROR + cached.first);
+                        error_callback(CANT_WRITE_ERROR + target_path);
                     }
-                    is_error = true;
                     return false;
                 }
             } else {
                 if (error_callback) {
-                    error_callback(CANT_CREATE_DIR + cached.first);
+                    error_callback(CANT_CREATE_DIR + target_path);
                 }
-                is_error = true;
                 return false;
             }
         }
+        // 重置内存池，缓冲区本身保留复用 (Reset the arena, the buffer itself is kept for reuse)
         cached_files.clear();
         total_cached_size = 0;
         return true;
@@ -1671,21 +2145,17 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
     
     // 单次遍历处理所有文件 (Single-pass processing of all files)
     for (const auto& file_info : file_info_list) {
-        // 直接收集已经复制的文件路径，遍历一个收集一个，添加到开头确保后复制的文件先被删除
-        copied_files_list.insert(copied_files_list.begin(), file_info.target_path);
         // 检查是否需要停止 (Check if stop is requested)
         if (stop_token.stop_requested()) {
-            is_stopped = true;
             goto cleanup;
         }
         
         if (file_info.file_size <= SMALL_FILE_THRESHOLD) {
              // 处理小文件：累积到内存池 (Process small files: accumulate in memory pool)
              
-             // 检查内存限制，如果超出则先写入已缓存的文件 (Check memory limit, flush cached files if exceeded)
-             if (total_cached_size + file_info.file_size > BATCH_MEMORY_LIMIT) {
+             // 内存池放不下时先写入已缓存的文件 (Flush cached files first when the arena is full)
+             if (total_cached_size + file_info.file_size > ALIGNED_BUFFER_SIZE) {
                  if (!flush_cached_files()) {
-                     is_error = true;
                      goto cleanup;
                  }
              }
@@ -1695,23 +2165,24 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
                  if (error_callback) {
                      error_callback(CANT_OPEN_FILE + file_info.source_path);
                  }
-                 is_error = true;
                  goto cleanup;
              }
             
-            // 小文件直接读取，不进行块对齐填充 (Small files read directly without block alignment padding)
+            // 小文件直接读入内存池末尾，不进行块对齐填充 (Small files are read straight to the end of the arena without block alignment padding)
              size_t file_size = file_info.file_size;
-             std::vector<char> file_data;
-             file_data.resize(file_size);  // 只分配实际文件大小
+             char* file_data = aligned_buffer + total_cached_size;
              
-             setvbuf(source_file, nullptr, _IOFBF, ALIGNED_BUFFER_SIZE);
+             setvbuf(source_file, nullptr, _IONBF, 0);
              
-             size_t bytes_read = fread(file_data.data(), 1, file_size, source_file);
+             size_t bytes_read = file_size ? fread(file_data, 1, file_size, source_file) : 0;
              fclose(source_file);
              source_file = nullptr; // 重置文件句柄
              
              if (bytes_read == file_size) {
-                 cached_files.push_back({file_info.target_path, std::move(file_data)});
+                 if (file_crc32s) {
+                     (*file_crc32s)[&file_info - file_info_list.data()] = crc32CalculateWithSeed(0, file_data, file_size);
+                 }
+                 cached_files.push_back({&file_info, total_cached_size, file_size});
                  total_cached_size += file_size;  // 使用实际文件大小
                  
                  if (progress_callback) {
@@ -1721,14 +2192,12 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
                  if (error_callback) {
                      error_callback(CANT_READ_ERROR + file_info.source_path);
                  }
-                 is_error = true;
                  goto cleanup;
              }
          } else {
              // 处理大文件：先写入所有缓存的小文件，然后立即处理大文件 (Process large files: flush all cached small files first, then process large file immediately)
              if (!cached_files.empty()) {
                  if (!flush_cached_files()) {
-                     is_error = true;
                      goto cleanup;
                  }
              }
@@ -1739,7 +2208,6 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
                  if (error_callback) {
                      error_callback(CANT_OPEN_FILE + file_info.source_path);
                  }
-                 is_error = true;
                  goto cleanup;
              }
              
@@ -1754,7 +2222,6 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
                  if (error_callback) {
                      error_callback(CANT_CREATE_DIR + file_info.target_path + ", errno: " + std::to_string(errno));
                  }
-                 is_error = true;
                  goto cleanup;
              }
              
@@ -1775,7 +2242,6 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
              while (total_read < (size_t)file_size && file_success) {
                  // 在文件复制过程中检查是否需要停止 (Check if stop is requested during file copy)
                  if (stop_token.stop_requested()) {
-                     is_stopped = true;
                      goto cleanup;
                  }
                  
@@ -1793,12 +2259,15 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
                  
                  size_t bytes_read = fread(aligned_buffer, 1, to_read, source_file);
                  if (bytes_read > 0) {
+                     if (file_crc32s) {
+                         u32& file_crc32 = (*file_crc32s)[&file_info - file_info_list.data()];
+                         file_crc32 = crc32CalculateWithSeed(file_crc32, aligned_buffer, bytes_read);
+                     }
                      // 写入实际读取的字节数，不进行块对齐填充 (Write actual bytes read, no block alignment padding)
                      if (fwrite(aligned_buffer, 1, bytes_read, dest_file) != bytes_read) {
                         if (error_callback) {
                             error_callback(CANT_WRITE_ERROR + file_info.target_path);
                         }
-                        is_error = true;
                         goto cleanup;
                      }
                      total_read += bytes_read;
@@ -1838,7 +2307,6 @@ bool ModManager::copyFilesBatch(const std::vector<FileInfo>& file_info_list,
      
      // 处理剩余的小文件缓存 (Process remaining cached small files)
      if (!flush_cached_files()) {
-         is_error = true;
          goto cleanup;
      }
      
@@ -1865,13 +2333,7 @@ cleanup:
          aligned_buffer = nullptr;
      }
      
-     // 根据错误类型调用相应的清理函数 (Call appropriate cleanup function based on error type)
-     if (is_stopped) {
-         cleanupCopiedFilesAndDirectories(copied_files_list, progress_callback, total_files);
-     } else if (is_error) {
-         cleanupCopiedFilesAndDirectories_forError(copied_files_list, progress_callback, total_files);
-     }
-     
+     // 已复制的文件由调用方按安装日志回滚 (Copied files are rolled back by the caller from the install journal)
      return false;
 }
 
@@ -1906,7 +2368,7 @@ bool ModManager::createDirectoriesBatch(std::vector<std::string>& directories,
     
     // 缓存已创建的目录路径 (Cache created directory paths)
     cached_created_directories = directories;
-    
+
     // 批量创建目录 (Batch create directories)
     size_t created_count = 0; // 记录已创建的目录数量 (Track number of created directories)
     
@@ -2093,6 +2555,9 @@ bool ModManager::Removemodeformodlist(const std::string& mod_dir_path,ErrorCallb
         
     }
 
+    // 删除残留的安装清单,失败不管他。
+    tj::InstallManifest::Remove(GetModManifestPath(mod_dir_path));
+
 
     std::string mod_json_path = GetModJsonPath(mod_dir_path);
     std::string mod_dir_name = GetModDirName(mod_dir_path);
@@ -2181,6 +2646,9 @@ bool ModManager::Removegameandallmods(const std::string& game_file_path,ErrorCal
             continue;
         }
 
+        // 删除残留的安装清单，失败不管
+        tj::InstallManifest::Remove(GetModManifestPath(dir_path));
+
         // 根据固定格式 /mods2/游戏名字/ID/模组的名字 解析路径
         // 提取 /mods2/游戏名字/ID/ 作为 mod_json_path 的基础路径
         size_t last_slash = dir_path.find_last_of('/');
@@ -2195,6 +2663,26 @@ bool ModManager::Removegameandallmods(const std::string& game_file_path,ErrorCal
     if (count == 0) {
         // 删除modjson文件，游戏路径，失败不管。
         remove(mod_json_path.c_str());
+        tj::atomic_file::Remove(GetCrc32CachePath(game_file_path));
+        tj::atomic_file::Remove(GetConflictIndexPath(game_file_path));
+
+        // 删除孤立的安装清单和原子写入遗留的临时文件，否则ID目录非空无法删除
+        // (Remove orphaned install manifests and temp files left by atomic writes, otherwise the ID directory is not empty and cannot be removed)
+        if (DIR* game_dir = opendir(game_file_path.c_str())) {
+            std::vector<std::string> sidecar_files;
+            struct dirent* entry;
+            while ((entry = readdir(game_dir)) != nullptr) {
+                std::string_view name(entry->d_name);
+                if (name.ends_with(".manifest") || name.ends_with(".tmp")) {
+                    sidecar_files.push_back(game_file_path + "/" + entry->d_name);
+                }
+            }
+            closedir(game_dir);
+            for (const auto& sidecar_file : sidecar_files) {
+                remove(sidecar_file.c_str());
+            }
+        }
+
         remove(game_file_path.c_str());
         remove(game_name_path.c_str());
         std::string game_dir_name = GetGameDirName(game_file_path);
@@ -2280,6 +2768,42 @@ void ModManager::GetConflictingModNames(const std::string& mod_dir_path,const st
     // 从/mods2/游戏名/ID/模组名固定格式提取/mods2/游戏名/ID
     std::string game_file_path = mod_dir_path.substr(0, mod_dir_path.rfind('/'));
 
+    // 分离出/contents/XXXXXX
+    std::string contents_path = conflicting_file_Path;
+    // 去掉"/atmosphere/"(12个字符)
+    contents_path = contents_path.substr(12);
+
+    // 格式化冲突MOD信息到COLLISION_MOD_FOUND字符串中
+    auto report_collision = [&](std::string mod_conflicting_name) {
+        mod_conflicting_name = mod_conflicting_name.substr(0, mod_conflicting_name.size() - 3);
+        char formatted_message[1024];
+        snprintf(formatted_message, sizeof(formatted_message), COLLISION_MOD_FOUND.c_str(), mod_conflicting_name.c_str(), contents_path.c_str());
+        std::string collision_message = formatted_message;
+        if (error_callback) {
+            error_callback(collision_message);
+        }
+    };
+
+    // 先查冲突索引，一次查找即可得到已安装的所有者，查不到再回退到逐个检查MOD
+    // (Check the conflict index first, one lookup gives the installed owners, fall back to checking every MOD on a miss)
+    {
+        std::vector<std::string> owners;
+        tj::ConflictIndex conflict_index(GetConflictIndexPath(mod_dir_path));
+        if (conflict_index.Lookup(conflicting_file_Path, owners)) {
+            std::string current_mod_key = GetModKeyName(mod_dir_path);
+            std::string mod_conflicting_name;
+            for (const auto& owner : owners) {
+                if (owner != current_mod_key) {
+                    mod_conflicting_name = mod_conflicting_name + GetModJsonName(game_file_path + "/" + owner) + "，";
+                }
+            }
+            if (!mod_conflicting_name.empty()) {
+                report_collision(mod_conflicting_name);
+                return;
+            }
+        }
+    }
+
     // 获取所有已安装的mod目录路径
     std::vector<std::string> installed_mod_paths = GetAllModDirPaths(game_file_path);
     
@@ -2304,12 +2828,6 @@ void ModManager::GetConflictingModNames(const std::string& mod_dir_path,const st
     }
     
 
-    // 分离出/contents/XXXXXX
-    std::string contents_path = conflicting_file_Path;
-    // 去掉"/atmosphere/"(12个字符)
-    contents_path = contents_path.substr(12);
-    
-
     // 初始化ZIP读取器，避免循环内频繁初始化
     mz_zip_archive zip_archive;
     mz_zip_zero_struct(&zip_archive);
@@ -2371,14 +2889,7 @@ void ModManager::GetConflictingModNames(const std::string& mod_dir_path,const st
 
     // 代表检测到了冲突的MOD
     if (!mod_conflicting_name.empty()) {
-        mod_conflicting_name = mod_conflicting_name.substr(0, mod_conflicting_name.size() - 3);
-        // 格式化冲突MOD信息到COLLISION_MOD_FOUND字符串中
-        char formatted_message[1024];
-        snprintf(formatted_message, sizeof(formatted_message), COLLISION_MOD_FOUND.c_str(), mod_conflicting_name.c_str(), contents_path.c_str());
-        std::string collision_message = formatted_message;
-        if (error_callback) {
-            error_callback(collision_message);
-        }
+        report_collision(mod_conflicting_name);
         return;
     } 
 
@@ -2389,16 +2900,16 @@ void ModManager::GetConflictingModNames(const std::string& mod_dir_path,const st
 
 }
 
-// 清理已复制的文件和已创建的目录（用于copyFilesBatch中断时的清理）
+// 清理已复制的文件和已创建的目录（用于安装取消时按日志回滚和启动恢复）
 void ModManager::cleanupCopiedFilesAndDirectories(std::vector<std::string>& copied_files,
                                                  ProgressCallback progress_callback,
                                                  int total_items) {            
 
     size_t delete_items = copied_files.size();
 
-    // 先删除所有复制的文件，失败也不管 (Delete all copied files first, ignore failures)
-    for (const std::string& file_path : copied_files) {
-        remove(file_path.c_str()); // 删除文件，忽略错误 (Delete file, ignore errors)
+    // 先逆序删除所有复制的文件，后复制的先删除，失败也不管 (Delete all copied files first in reverse order, newest first, ignore failures)
+    for (auto it = copied_files.rbegin(); it != copied_files.rend(); ++it) {
+        remove(it->c_str()); // 删除文件，忽略错误 (Delete file, ignore errors)
         delete_items--;
         
         // 更新进度 (Update progress)
@@ -2442,8 +2953,9 @@ void ModManager::cleanupCopiedFilesAndDirectories(std::vector<std::string>& copi
 // 从路径中提取/mods2/游戏名/ID部分 (Extract /mods2/game_name/ID from path)
 std::string ModManager::GetFilePath(const std::string& path) {
     // 查找第三个'/'的位置，即/mods2/游戏名/ID后面的'/' (Find the position of the third '/', after /mods2/game_name/ID)
+    // 路径本身就是/mods2/游戏名/ID时原样返回 (Return the path unchanged when it already is /mods2/game_name/ID)
     size_t slash_count = 0;
-    size_t pos = 0;
+    size_t pos = path.length();
     
     for (size_t i = 0; i < path.length(); ++i) {
         if (path[i] == '/') {
@@ -2467,56 +2979,284 @@ std::string ModManager::GetModFileCommonPath(const std::string& path) {
     
 }
 
+// 从路径中提取MOD目录名（不含表示已安装的$） (Extract the MOD directory name without the installed marker $)
+std::string ModManager::GetModKeyName(const std::string& path) {
+
+    std::string file_path = GetFilePath(path);
+    size_t name_start = file_path.length() + 1;
+    if (file_path.empty() || name_start >= path.length()) {
+        return "";
+    }
+
+    // 取ID之后的MOD目录名 (Take the MOD directory name after the ID)
+    size_t name_end = path.find('/', name_start);
+    std::string mod_name = path.substr(name_start, name_end == std::string::npos ? std::string::npos : name_end - name_start);
+    if (!mod_name.empty() && mod_name.back() == '$') {
+        mod_name.pop_back();
+    }
+    return mod_name;
+}
+
+// 获取MOD安装清单路径：/mods2/游戏名/ID/MOD名.manifest (Get MOD install manifest path)
+std::string ModManager::GetModManifestPath(const std::string& path) {
+
+    std::string mod_name = GetModKeyName(path);
+    if (mod_name.empty()) {
+        return "";
+    }
+
+    return GetFilePath(path) + "/" + mod_name + ".manifest";
+}
+
+// 获取冲突索引路径：/mods2/游戏名/ID/conflict_index.bin (Get conflict index path)
+std::string ModManager::GetConflictIndexPath(const std::string& path) {
+
+    std::string file_path = GetFilePath(path);
+
+    return file_path + "/conflict_index.bin";
+}
+
+// 回滚上次被中断的安装 (Roll back an install that was interrupted last time)
+void ModManager::RecoverInterruptedInstall() {
+
+    // 崩溃可能发生在写入清单之后，一并移除 (The crash may have happened after the manifest was written, drop it as well)
+    std::string mod_path;
+    if (ReplayInstallJournal(nullptr, 0, false, mod_path) && !mod_path.empty()) {
+        ForgetInstalledFiles(mod_path);
+    }
+
+    tj::InstallJournal::Remove();
+}
+
+// 回滚取消或出错的安装：先关闭日志让其可以读回，回放后删除 (Roll back a cancelled or failed install: close the journal
+// first so it can be read back, remove it after the replay)
+void ModManager::RollbackInstall(ProgressCallback progress_callback, int total_items, bool is_error) {
+
+    install_journal.Close();
+    std::string mod_path;
+    ReplayInstallJournal(progress_callback, total_items, is_error, mod_path);
+    tj::InstallJournal::Remove();
+}
+
+bool ModManager::ReplayInstallJournal(ProgressCallback progress_callback, int total_items, bool is_error, std::string& mod_path) {
+
+    std::vector<std::string> files;
+    std::vector<std::string> directories;
+    std::vector<std::pair<std::string, u32>> shared_counts;
+    if (!tj::InstallJournal::ReadPending(mod_path, files, directories, shared_counts)) {
+        return false;
+    }
+
+    // 只删除atmosphere目录下的路径，防止损坏的日志误删其他文件 (Only remove paths under the atmosphere directory, so a damaged journal cannot remove anything else)
+    auto outside_target = [](const std::string& path) {
+        return path.compare(0, target_directory_zip.length(), target_directory_zip) != 0 || path.find("/../") != std::string::npos;
+    };
+    files.erase(std::remove_if(files.begin(), files.end(), outside_target), files.end());
+    directories.erase(std::remove_if(directories.begin(), directories.end(), outside_target), directories.end());
+
+    // 复用中断清理流程：逆序删除文件，再由深到浅删除目录；计划中的文件安装前都不存在，未写到的删除失败即可
+    // (Reuse the interrupted-install cleanup: files in reverse, then directories deepest first; no planned file existed
+    // before the install, so removing one that was never written just fails)
+    cached_created_directories = std::move(directories);
+    if (is_error) {
+        cleanupCopiedFilesAndDirectories_forError(files, progress_callback, total_items);
+    } else {
+        cleanupCopiedFilesAndDirectories(files, progress_callback, total_items);
+    }
+
+    // 把共用计数设回安装前的值，账本是否已提交都适用 (Set the shared counts back to their pre-install values,
+    // whether or not the ledger was committed)
+    if (!mod_path.empty() && !shared_counts.empty()) {
+        RestoreSharedCounts(mod_path, shared_counts);
+    }
+    return true;
+}
+
+// 获取CRC32缓存路径：/mods2/游戏名/ID/crc32_cache.bin (Get CRC32 cache path)
+std::string ModManager::GetCrc32CachePath(const std::string& path) {
+
+    std::string file_path = GetFilePath(path);
+
+    return file_path + "/crc32_cache.bin";
+}
+
+// 安装成功后写入安装清单并加入冲突索引 (Write the install manifest and add to the conflict index after a successful install)
+void ModManager::RecordInstalledFiles(const std::string& path, u64 source_fingerprint) {
+
+    std::string mod_name = GetModKeyName(path);
+    if (mod_name.empty()) {
+        return;
+    }
+
+    // 先删除旧清单，写入失败时不留下任何清单，卸载回退到遍历，不会回放过期的文件列表
+    // (Remove the old manifest first; if the write fails no manifest is left, so uninstall falls back to the walk instead
+    // of replaying a stale file list)
+    std::string manifest_path = GetModManifestPath(path);
+    tj::InstallManifest::Remove(manifest_path);
+    if (!tj::InstallManifest::Write(manifest_path, source_fingerprint, cached_manifest_entries)) {
+        tj::InstallManifest::Remove(manifest_path);
+    }
+
+    tj::ConflictIndex conflict_index(GetConflictIndexPath(path));
+    conflict_index.AddMod(mod_name, cached_manifest_entries);
+    conflict_index.Commit();
+
+    // 已知CRC32的目标文件写入CRC32缓存，之后的冲突校验无需重新读取 (Targets with a known CRC32 go into the CRC32 cache so later conflict checks skip reading them)
+    crc32_cache.StoreInstalledFiles(cached_manifest_entries);
+    crc32_cache.Commit();
+}
+
+// 卸载成功后删除安装清单并移出冲突索引 (Remove the install manifest and drop from the conflict index after a successful uninstall)
+void ModManager::ForgetInstalledFiles(const std::string& path) {
+
+    std::string mod_name = GetModKeyName(path);
+    if (mod_name.empty()) {
+        return;
+    }
+
+    tj::InstallManifest::Remove(GetModManifestPath(path));
+
+    tj::ConflictIndex conflict_index(GetConflictIndexPath(path));
+    conflict_index.RemoveMod(mod_name);
+    conflict_index.Commit();
+}
+
+// MOD目录改名后将安装清单一并改名，并更新冲突索引中的所有者名称 (Rename the install manifest along with the MOD directory and rekey the conflict index owner)
+void ModManager::RenameInstalledFiles(const std::string& old_mod_path, const std::string& new_mod_path) {
+
+    std::string old_mod_name = GetModKeyName(old_mod_path);
+    std::string new_mod_name = GetModKeyName(new_mod_path);
+    if (old_mod_name.empty() || new_mod_name.empty() || old_mod_name == new_mod_name) {
+        return;
+    }
+
+    std::string old_manifest_path = GetModManifestPath(old_mod_path);
+    std::string new_manifest_path = GetModManifestPath(new_mod_path);
+
+    // 改名失败时删除旧清单，卸载回退到遍历 (If the rename fails drop the old manifest, uninstall falls back to the walk)
+    tj::InstallManifest::Remove(new_manifest_path);
+    if (rename(old_manifest_path.c_str(), new_manifest_path.c_str()) != 0) {
+        tj::InstallManifest::Remove(old_manifest_path);
+    }
+
+    tj::ConflictIndex conflict_index(GetConflictIndexPath(old_mod_path));
+    conflict_index.RenameMod(old_mod_name, new_mod_name);
+    conflict_index.Commit();
+}
+
+// 从安装清单加载待删除的目标文件 (Load target files to remove from the install manifest)
+bool ModManager::LoadTargetFilesFromManifest(const std::string& manifest_path, u64 source_fingerprint) {
+
+    cached_target_files.clear();
+    if (manifest_path.empty()) {
+        return false;
+    }
+
+    std::vector<tj::InstallManifestEntry> entries;
+    if (!tj::InstallManifest::Read(manifest_path, source_fingerprint, entries) || entries.empty()) {
+        return false;
+    }
+
+    const std::string contents_prefix = target_directory_zip + "contents/";
+    const std::string exefs_prefix = target_directory_zip + "exefs_patches/";
+
+    cached_target_files.reserve(entries.size());
+    for (auto& entry : entries) {
+        // 只允许删除contents和exefs_patches下的文件，否则视为过期清单 (Only files under contents and exefs_patches may be removed, otherwise the manifest is stale)
+        if (entry.target_path.compare(0, contents_prefix.length(), contents_prefix) != 0 &&
+            entry.target_path.compare(0, exefs_prefix.length(), exefs_prefix) != 0) {
+            cached_target_files.clear();
+            return false;
+        }
+        cached_target_files.push_back(std::move(entry.target_path));
+    }
+
+    return true;
+}
+
+// 按目录聚集排序待删除文件 (Sort target files clustered by directory)
+void ModManager::SortTargetFilesByDirectory() {
+    // 先按目录路径字典序排序确保同目录文件聚集，同目录内按文件名排序；使用string_view比较，不产生临时字符串
+    // (Sort by directory path first so files of a directory cluster, then by file name; compared through string_view without temporaries)
+    std::sort(cached_target_files.begin(), cached_target_files.end(), [](const std::string& a, const std::string& b) {
+        auto get_directory = [](const std::string& path) {
+            size_t last_slash = path.find_last_of('/');
+            return std::string_view(path.data(), last_slash != std::string::npos ? last_slash : 0);
+        };
+
+        std::string_view dir_a = get_directory(a);
+        std::string_view dir_b = get_directory(b);
+        if (dir_a != dir_b) {
+            return dir_a < dir_b;
+        }
+        return a < b;
+    });
+}
+
 /**
- * 使用libnx硬件加速计算文件的CRC32值
+ * 使用libnx硬件加速计算文件的CRC32值，大小和修改时间未变的文件直接取缓存
  * @param file_path 文件路径
  * @return 文件的CRC32值，失败时返回0
  */
 u32 ModManager::GetFileCrc32(const char* file_path) {
+    // 获取文件大小和修改时间，作为缓存的键 (Get file size and mtime, used as the cache key)
+    struct stat file_stat;
+    if (stat(file_path, &file_stat) != 0 || file_stat.st_size <= 0) {
+        return 0; // 文件不存在或大小无效
+    }
+
+    const u64 file_size = static_cast<u64>(file_stat.st_size);
+    const u64 file_mtime = static_cast<u64>(file_stat.st_mtime);
+
+    // 初始化CRC32值
+    u32 crc32 = 0;
+    if (crc32_cache.Lookup(file_path, file_size, file_mtime, crc32)) {
+        return crc32;
+    }
+
     // 打开文件
     FILE* file = fopen(file_path, "rb");
     if (!file) {
         return 0; // 文件打开失败
     }
-    
-    // 获取文件大小
-    fseek(file, 0, SEEK_END);
-    long file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-    
-    if (file_size <= 0) {
-        fclose(file);
-        return 0; // 文件大小无效
-    }
-    
-    // 初始化CRC32值
-    u32 crc32 = 0;
-    
-    // 读取缓冲区大小（64KB）
-    const size_t buffer_size = 65536;
-    unsigned char* buffer = (unsigned char*)malloc(buffer_size);
+
+    // 关闭stdio缓冲，直接读入对齐的大缓冲区，减少SD卡请求次数 (Disable stdio buffering and read straight into a large aligned buffer, fewer SD card requests)
+    setvbuf(file, nullptr, _IONBF, 0);
+
+    // 读取缓冲区大小（1MB，按4KB对齐）
+    const size_t buffer_size = 1024 * 1024;
+    unsigned char* buffer = (unsigned char*)memalign(0x1000, buffer_size);
     if (!buffer) {
         fclose(file);
         return 0; // 内存分配失败
     }
-    
+
     // 分块读取文件并使用libnx硬件加速计算CRC32
     size_t bytes_read;
     while ((bytes_read = fread(buffer, 1, buffer_size, file)) > 0) {
         // 使用libnx的硬件加速CRC32函数
         crc32 = crc32CalculateWithSeed(crc32, buffer, bytes_read);
     }
-    
+
+    // 读取出错时不缓存结果 (Do not cache the result on a read error)
+    bool read_failed = ferror(file) != 0;
+
     // 清理资源
     free(buffer);
     fclose(file);
-    
+
+    if (!read_failed) {
+        crc32_cache.Store(file_path, file_size, file_mtime, crc32);
+    }
+
     return crc32;
 }
 
-void ModManager::CachedConflictingFiles(const std::string& path,ProgressCallback progress_callback) {
+bool ModManager::CachedConflictingFiles(const std::string& path,ProgressCallback progress_callback,
+                                        std::vector<std::pair<std::string, u32>>& previous_counts) {
 
-    if (cached_conflicting_files.empty()) return;
+    previous_counts.clear();
+    if (cached_conflicting_files.empty()) return true;
     
     size_t files_total = cached_conflicting_files.size();
     size_t current_file_index = 0;
@@ -2527,37 +3267,60 @@ void ModManager::CachedConflictingFiles(const std::string& path,ProgressCallback
     
     
     
-    // 获取当前mod的通用文件json路径
-    std::string mod_file_common_path = GetModFileCommonPath(path);
+    // 获取当前mod的通用文件json路径，一次读取，全部计数在内存中更新 (Load the common-file ledger once, update every count in memory)
+    tj::ModFileCommonLedger ledger(GetModFileCommonPath(path));
+
+    // 修改账本之前先把原计数落盘到安装日志 (Get the previous counts onto disk in the install journal before touching the ledger)
+    previous_counts.reserve(cached_conflicting_files.size());
+    for (const std::string& target_file_path : cached_conflicting_files) {
+        u32 previous_count = static_cast<u32>(ledger.GetCount(target_file_path));
+        install_journal.RecordSharedFile(target_file_path, previous_count);
+        previous_counts.emplace_back(target_file_path, previous_count);
+    }
+    if (!install_journal.Sync()) {
+        previous_counts.clear();
+        cached_conflicting_files.clear();
+        return false;
+    }
     
-    for (std::string& target_file_path : cached_conflicting_files) {
+    for (const std::string& target_file_path : cached_conflicting_files) {
 
         // 统计文件安装次数 (Count file installation times)
-        std::string current_count_str = tj::JsonManager::GetRootJsonValue(mod_file_common_path, target_file_path);
-        int install_count = 1; // 默认为1 (Default to 1)
-        
-        // 如果返回值不等于键名，说明键存在，解析计数值 (If return value is not equal to key name, key exists, parse count value)
-        if (current_count_str != target_file_path) {
-            install_count = std::stoi(current_count_str) + 1; // 递增计数 (Increment count)
-        }
-        
-        // 更新JSON文件中的计数值 (Update count value in JSON file)
-        tj::JsonManager::UpdateRootJsonKeyValue(mod_file_common_path, target_file_path, std::to_string(install_count));
+        ledger.Acquire(target_file_path);
 
-        if (progress_callback) {
+        current_file_index++;
+        if (progress_callback && current_file_index % 500 == 0) {
             progress_callback(current_file_index, files_total, "保留冲突记录中...", false, 0.0f, "", COLOR_BLUE);
         }
-        current_file_index++;
 
     }
 
+    // 一次性原子写回JSON文件 (Atomically write the JSON file back once)
+    bool committed = ledger.Commit();
+
+    if (progress_callback) {
+        progress_callback(files_total, files_total, "保留冲突记录中...", false, 0.0f, "", COLOR_BLUE);
+    }
+
     // 清空缓存的目标文件列表 (Clear cached target file list)
     cached_conflicting_files.clear();
-    
+
+    return committed;
 }
 
 
 
+// 把共用文件计数恢复为安装前的值 (Restore shared-file counts to their pre-install values)
+bool ModManager::RestoreSharedCounts(const std::string& path, const std::vector<std::pair<std::string, u32>>& previous_counts) {
+
+    tj::ModFileCommonLedger ledger(GetModFileCommonPath(path));
+    // 逆序设置，同一文件出现多次时以最早记录的原值为准 (Set in reverse so the earliest record wins when a file appears more than once)
+    for (auto it = previous_counts.rbegin(); it != previous_counts.rend(); ++it) {
+        ledger.SetCount(it->first, static_cast<int>(it->second));
+    }
+    return ledger.Commit();
+}
+
 // 当安装出错的时候调用这个函数，基本和cleanupCopiedFilesAndDirectories一致
 void ModManager::cleanupCopiedFilesAndDirectories_forError(std::vector<std::string>& copied_files,
                                                  ProgressCallback progress_callback,
@@ -2567,9 +3330,9 @@ void ModManager::cleanupCopiedFilesAndDirectories_forError(std::vector<std::stri
 
     size_t delete_items = copied_files.size();
     
-    // 先删除所有复制的文件，失败也不管 (Delete all copied files first, ignore failures)
-    for (const std::string& file_path : copied_files) {
-        remove(file_path.c_str()); // 删除文件，忽略错误 (Delete file, ignore errors)
+    // 先逆序删除所有复制的文件，后复制的先删除，失败也不管 (Delete all copied files first in reverse order, newest first, ignore failures)
+    for (auto it = copied_files.rbegin(); it != copied_files.rend(); ++it) {
+        remove(it->c_str()); // 删除文件，忽略错误 (Delete file, ignore errors)
         delete_items--;
         
         // 更新进度 (Update progress)
@@ -3,8 +3,12 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <memory>
 #include <stop_token>
 #include <switch.h>  // 包含Switch平台的类型定义，如u32
+#include "install_manifest.hpp"
+#include "crc32_cache.hpp"
+#include "install_journal.hpp"
 
 /**
  * MOD管理器类
@@ -41,6 +45,8 @@ public:
     /**
      * 解压ZIP文件到目标目录（简化版本，不使用小文件聚合，直接按顺序写入SD卡）
      * 注意：此函数必须接收已初始化的ZIP读取器，不会自行创建ZIP读取器
+     * 失败或取消时不删除已写入的文件，由调用方按安装日志回滚
+     * (Files already written are left in place on failure or cancel, the caller rolls back from the install journal)
      * @param zip_path ZIP文件路径（用于错误信息显示）
      * @param progress_callback 进度回调函数
      * @param error_callback 错误回调函数
@@ -55,7 +61,27 @@ public:
                      ErrorCallback error_callback = nullptr,
                      std::stop_token stop_token = {},
                      void* zip_archive_ptr = nullptr);
-    
+
+    /**
+     * 流水线解压ZIP文件到目标目录：后台线程解压到对齐环形缓冲区，当前线程按归档顺序写入SD卡
+     * (Pipelined extraction: a background thread inflates into an aligned ring buffer while the calling thread writes to SD in archive order)
+     * 参数和失败语义与extractMod一致，环形缓冲区分配失败时回退到extractMod
+     * (Same parameters and failure semantics as extractMod, falls back to extractMod if the ring buffer cannot be allocated)
+     * @param zip_path ZIP文件路径（用于错误信息显示）
+     * @param progress_callback 进度回调函数
+     * @param error_callback 错误回调函数
+     * @param stop_token 停止令牌，用于中断操作
+     * @param zip_archive_ptr 已初始化的mz_zip_archive指针（必须非空）
+     * @return 成功返回true，失败返回false
+     */
+    bool extractModPipelined(const std::string& zip_path,
+                             int& files_total,
+                             std::vector<int>& files_to_extract,
+                             ProgressCallback progress_callback = nullptr,
+                             ErrorCallback error_callback = nullptr,
+                             std::stop_token stop_token = {},
+                             void* zip_archive_ptr = nullptr);
+
 
     /**
      * 解压ZIP文件到目标目录（简化版本，不使用小文件聚合，直接按顺序写入SD卡）
@@ -71,6 +97,66 @@ public:
                      std::stop_token stop_token = {});    
 
     
+    // 安装计划中的单个文件 (A single file in an install plan)
+    struct PlannedFile {
+        std::string source_path;  // 源路径，ZIP类型为空 (Source path, empty for ZIP)
+        int zip_index;            // ZIP内的条目索引，文件夹类型为-1 (Entry index inside the ZIP, -1 for folders)
+        std::string target_path;  // 目标路径 (Target path)
+        u64 size;                 // 文件大小 (File size)
+        u32 file_crc32;           // ZIP中央目录的CRC32，文件夹类型为0 (CRC32 from the ZIP central directory, 0 for folders)
+    };
+
+    // 安装计划：只读扫描的结果，预览和实际安装共用 (Install plan: result of a read-only scan, shared by the preview and the actual install)
+    struct InstallPlan {
+        std::string source_path;                   // MOD文件夹或ZIP文件路径 (MOD folder or ZIP file path)
+        bool is_zip{false};
+        std::vector<PlannedFile> files;            // 需要写入的文件 (Files to write)
+        std::vector<PlannedFile> existing_files;   // 目标已存在的文件，安装时校验CRC32 (Targets that already exist, CRC32-checked on install)
+        std::vector<std::string> directories;      // 需要创建的目录，已排序去重 (Directories to create, sorted and unique)
+        std::vector<std::string> conflict_owners;  // 冲突索引中已占用这些目标的MOD，只由PlanInstall填写 (MODs that own those targets in the conflict index, filled by PlanInstall only)
+        u64 total_bytes{0};                        // 需要写入的字节数 (Bytes to write)
+        u64 required_bytes{0};                     // 按簇估算的占用空间，只计尚不存在的目录 (Space needed rounded up to clusters, counting only directories that don't exist yet)
+        u64 free_bytes{0};                         // SD卡剩余空间，未知时为0 (Free space on the SD card, 0 when unknown)
+        bool has_enough_space{true};               // 估算的空间是否足够 (Whether the estimated space is enough)
+        bool space_check_exact{false};             // 簇大小来自文件系统或连文件字节数都放不下，此时空间不足会拒绝安装，否则只是警告
+                                                   // (The cluster size came from the filesystem or even the raw bytes don't fit; a shortage
+                                                   // then refuses the install, otherwise it is only a warning)
+        std::string layout_error;                  // MOD结构不合法时的错误信息 (Error message when the MOD layout is invalid)
+        std::shared_ptr<void> zip_archive;         // 已打开的ZIP读取器，安装时复用 (Open ZIP reader, reused by the install)
+    };
+
+    /**
+     * 生成安装计划，只读取ZIP中央目录或文件夹目录项，不写入任何文件；另外从冲突索引查询冲突所有者，供预览显示
+     * Build an install plan reading only the ZIP central directory or folder entries, nothing is written; also looks up
+     * conflict owners in the conflict index for the preview
+     * @param mod_path MOD路径 (MOD path)
+     * @param plan 输出的安装计划 (Output install plan)
+     * @param progress_callback 进度回调函数
+     * @param error_callback 错误回调函数
+     * @param stop_token 停止令牌，用于中断操作
+     * @return 读取失败或被中断返回false，MOD结构不合法时返回true并设置layout_error
+     *         (Returns false on a read error or stop; an invalid layout returns true with layout_error set)
+     */
+    bool PlanInstall(const std::string& mod_path,
+                     InstallPlan& plan,
+                     ProgressCallback progress_callback = nullptr,
+                     ErrorCallback error_callback = nullptr,
+                     std::stop_token stop_token = {});
+
+    /**
+     * 按安装计划执行安装，不重新扫描源文件
+     * Install according to a plan without scanning the source again
+     * @param plan PlanInstall生成的安装计划 (Install plan from PlanInstall)
+     * @param progress_callback 进度回调函数
+     * @param error_callback 错误回调函数
+     * @param stop_token 停止令牌，用于中断操作
+     * @return 成功返回true，失败返回false
+     */
+    bool InstallFromPlan(const InstallPlan& plan,
+                         ProgressCallback progress_callback = nullptr,
+                         ErrorCallback error_callback = nullptr,
+                         std::stop_token stop_token = {});
+
     /**
      * 直接解压ZIP文件到atmosphere目录（不复制，直接解压）
      * @param zip_path ZIP文件路径
@@ -115,7 +201,9 @@ public:
      * @param progress_callback 进度回调函数
      * @param error_callback 错误回调函数
      * @param stop_token 停止令牌，用于中断操作
-     * @return 成功返回true，失败返回false
+     * @param file_crc32s 可选输出，复制时顺带计算的每个文件CRC32，与file_info_list下标对应
+     * @return 成功返回true，失败返回false；失败或取消时不删除已复制的文件，由调用方按安装日志回滚
+     *         (Copied files are left in place on failure or cancel, the caller rolls back from the install journal)
      */
     // 文件信息结构体 (File info structure)
     struct FileInfo {
@@ -127,7 +215,8 @@ public:
     bool copyFilesBatch(const std::vector<FileInfo>& file_info_list,
                          ProgressCallback progress_callback = nullptr,
                          ErrorCallback error_callback = nullptr,
-                         std::stop_token stop_token = {});
+                         std::stop_token stop_token = {},
+                         std::vector<u32>* file_crc32s = nullptr);
     
     /**
      * 批量复制文件（简化版本，不聚集小文件，直接按顺序写入）
@@ -198,7 +287,7 @@ public:
                                             std::stop_token stop_token);
     
     /**
-     * 基于缓存路径删除文件
+     * 基于缓存路径删除文件，按目录分组由少量线程并行删除，最后由深到浅一次性清理空目录
      * @param progress_callback 进度回调函数
      * @param error_callback 错误回调函数
      * @return 成功返回true，失败返回false
@@ -233,7 +322,7 @@ public:
                                   ErrorCallback error_callback);
     
     /**
-     * 清理已复制的文件和已创建的目录（用于copyFilesBatch中断时的清理）
+     * 清理已复制的文件和已创建的目录（用于安装取消时按日志回滚和启动恢复）
      * @param copied_files 已复制的文件路径列表
      * @param progress_callback 进度回调函数
      * @param total_items 总项目数（文件数+目录数）
@@ -244,7 +333,7 @@ public:
 
 
     /**
-     * 清理已复制的文件和已创建的目录（用于安装出错时的清理）
+     * 清理已复制的文件和已创建的目录（用于安装出错时按日志回滚）
      * @param copied_files 已复制的文件路径列表
      * @param progress_callback 进度回调函数
      * @param total_items 总项目数（文件数+目录数）
@@ -281,10 +370,97 @@ public:
     void GetConflictingModNames(const std::string& mod_dir_path,const std::string& conflicting_file_Path,
                                 ProgressCallback progress_callback,ErrorCallback error_callback,std::stop_token stop_token);
 
-    void CachedConflictingFiles(const std::string& path,ProgressCallback progress_callback);
+    // 将共用文件计数写入mod_file_common.json，提交前把原计数记入安装日志并输出；日志写入失败时输出为空，任一写入失败返回false
+    // (Write shared-file counts to mod_file_common.json; the previous counts are journaled before the commit and returned,
+    // the output is empty if the journal cannot be written, returns false if any write fails)
+    bool CachedConflictingFiles(const std::string& path,ProgressCallback progress_callback,
+                                std::vector<std::pair<std::string, u32>>& previous_counts);
+    // 把共用文件计数恢复为安装前的值（安装回滚时使用） (Restore shared-file counts to their pre-install values, used when an install is rolled back)
+    bool RestoreSharedCounts(const std::string& path, const std::vector<std::pair<std::string, u32>>& previous_counts);
+
+    /**
+     * 从路径中提取MOD目录名（不含末尾表示已安装的$）
+     * @param path MOD目录路径或MOD内ZIP文件路径
+     * @return MOD目录名，路径格式不合法时返回空字符串
+     */
+    std::string GetModKeyName(const std::string& path);
+
+    /**
+     * 获取MOD安装清单路径：/mods2/游戏名/ID/MOD名.manifest（MOD名不含末尾的$）
+     * @param path MOD目录路径或MOD内ZIP文件路径
+     * @return 清单路径，路径格式不合法时返回空字符串
+     */
+    std::string GetModManifestPath(const std::string& path);
+
+    /**
+     * 获取冲突索引路径：/mods2/游戏名/ID/conflict_index.bin
+     * @param path MOD目录路径或MOD内ZIP文件路径
+     * @return 索引路径
+     */
+    std::string GetConflictIndexPath(const std::string& path);
 
     /**
-     * 使用libnx硬件加速计算文件的CRC32值
+     * 按安装日志回滚上次被中断（崩溃或断电）的安装，启动时调用
+     * Roll back an install interrupted by a crash or power loss using the install journal, called at launch
+     */
+    void RecoverInterruptedInstall();
+
+    /**
+     * 安装取消或出错时按安装日志回滚，与启动时的恢复回放同一份日志，完成后删除日志
+     * Roll back a cancelled or failed install from the install journal, replaying the same journal as recovery at
+     * launch, then remove the journal
+     * @param is_error 安装出错时为true，进度对话框显示安装错误标题 (True if the install failed, the progress dialog shows
+     *                 the install error title)
+     */
+    void RollbackInstall(ProgressCallback progress_callback, int total_items, bool is_error);
+
+    // 回放安装日志：删除记录的文件和目录，把共用计数设回安装前的值；存在有效日志时返回true并输出MOD路径
+    // (Replay the install journal: remove the recorded files and directories and set the shared counts back to their
+    // pre-install values; returns true with the MOD path if a valid journal exists)
+    bool ReplayInstallJournal(ProgressCallback progress_callback, int total_items, bool is_error, std::string& mod_path);
+
+    /**
+     * 获取CRC32缓存路径：/mods2/游戏名/ID/crc32_cache.bin
+     * @param path MOD目录路径或MOD内ZIP文件路径
+     * @return 缓存路径
+     */
+    std::string GetCrc32CachePath(const std::string& path);
+
+    /**
+     * 安装成功后将cached_manifest_entries写入安装清单并加入冲突索引
+     * @param path MOD目录路径或MOD内ZIP文件路径
+     * @param source_fingerprint MOD来源指纹（文件夹MOD为0）
+     */
+    void RecordInstalledFiles(const std::string& path, u64 source_fingerprint);
+
+    /**
+     * 卸载成功后删除安装清单并将MOD移出冲突索引
+     * @param path MOD目录路径或MOD内ZIP文件路径
+     */
+    void ForgetInstalledFiles(const std::string& path);
+
+    /**
+     * MOD目录改名（如修改MOD类型）后，将安装清单一并改名，并更新冲突索引中的所有者名称
+     * @param old_mod_path 改名前的MOD目录路径
+     * @param new_mod_path 改名后的MOD目录路径
+     */
+    void RenameInstalledFiles(const std::string& old_mod_path, const std::string& new_mod_path);
+
+    /**
+     * 从安装清单加载待删除的目标文件到cached_target_files，清单缺失或过期时返回false
+     * @param manifest_path 清单路径
+     * @param source_fingerprint 当前MOD来源指纹（文件夹MOD为0）
+     * @return 加载成功返回true，需要回退到遍历时返回false
+     */
+    bool LoadTargetFilesFromManifest(const std::string& manifest_path, u64 source_fingerprint);
+
+    /**
+     * 按目录聚集排序cached_target_files，同目录文件相邻，便于删除后清理空目录
+     */
+    void SortTargetFilesByDirectory();
+
+    /**
+     * 使用libnx硬件加速计算文件的CRC32值，大小和修改时间未变的文件直接取缓存
      * @param file_path 文件路径
      * @return 文件的CRC32值，失败时返回0
      */
@@ -299,7 +475,43 @@ private:
 
     // 缓存发生冲突且通过CRC32校验的目标文件路径 (Cached target file paths that conflict and pass CRC32 check)
     std::vector<std::string> cached_conflicting_files;
+
+    // 本次安装的文件清单，安装成功后写入安装清单文件 (Files of the current install, written to the install manifest on success)
+    std::vector<tj::InstallManifestEntry> cached_manifest_entries;
+
+    // 当前安装事务的日志 (Journal of the current install transaction)
+    tj::InstallJournal install_journal;
+
+    // 当前游戏的CRC32缓存，安装开始时切换 (CRC32 cache of the current game, switched at install start)
+    tj::Crc32Cache crc32_cache;
     
+    // MOD目录结构 (MOD directory layout)
+    enum class ModLayout {
+        Invalid,     // 结构不合法 (Invalid layout)
+        Folder,      // 只有contents/exefs_patches (Only contents/exefs_patches)
+        Zip,         // 只有一个ZIP文件 (A single ZIP file)
+        Unreadable,  // 无法打开目录 (Directory cannot be opened)
+    };
+
+    // 检测MOD目录结构，ZIP类型时输出ZIP路径 (Detect the MOD directory layout, outputs the ZIP path for ZIP MODs)
+    ModLayout DetectModLayout(const std::string& mod_path, std::string& zip_path);
+
+    // 分别扫描ZIP和文件夹生成安装计划 (Scan a ZIP or a folder into an install plan)
+    bool PlanZipInstall(const std::string& zip_path, InstallPlan& plan, ProgressCallback progress_callback,
+                        ErrorCallback error_callback, std::stop_token stop_token);
+    bool PlanFolderInstall(const std::string& folder_path, InstallPlan& plan, ProgressCallback progress_callback,
+                           ErrorCallback error_callback, std::stop_token stop_token);
+
+    // 按MOD目录结构扫描生成安装计划，PlanInstall和安装共用 (Scan into an install plan by MOD layout, shared by PlanInstall and the install)
+    bool BuildInstallPlan(const std::string& mod_path, InstallPlan& plan, ProgressCallback progress_callback,
+                          ErrorCallback error_callback, std::stop_token stop_token);
+
+    // 目录去重并估算空间 (Deduplicate directories and estimate space)
+    void FinishInstallPlan(InstallPlan& plan);
+
+    // 从冲突索引查询已存在目标的所有者，只用于预览 (Look up owners of existing targets in the conflict index, preview only)
+    void FindConflictOwners(InstallPlan& plan);
+
     // 临时增加两个变量，用于进度条颜色，后面重构一下回调函数，改成结构体
     static const int COLOR_BLUE[3];
     static const int COLOR_RED[3];
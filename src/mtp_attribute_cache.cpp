@@ -0,0 +1,220 @@
+#include "mtp_attribute_cache.hpp"
+#include <cstring>
+
+namespace mtp {
+
+std::string EntryAttributeCache::NormalizePath(const char* path) {
+    // 代理拼接路径时可能出现重复或结尾的'/'，统一后才能与目录读取的条目对应
+    // (Proxies may produce repeated or trailing '/' when joining paths, normalize so lookups match directory reads)
+    std::string normalized;
+    normalized.reserve(std::strlen(path));
+    for (const char* p = path; *p; ++p) {
+        if (*p == '/' && !normalized.empty() && normalized.back() == '/') {
+            continue;
+        }
+        normalized.push_back(*p);
+    }
+    while (!normalized.empty() && normalized.back() == '/') {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+void EntryAttributeCache::SplitPath(const std::string& path, std::string& dir, std::string& name) {
+    const size_t pos = path.find_last_of('/');
+    if (pos == std::string::npos) {
+        dir.clear();
+        name = path;
+        return;
+    }
+    dir.assign(path, 0, pos);
+    name.assign(path, pos + 1, std::string::npos);
+}
+
+void EntryAttributeCache::Clear() {
+    std::scoped_lock lock{mutex};
+    directories.clear();
+    entry_count = 0;
+    ++generation;
+}
+
+u64 EntryAttributeCache::BeginDirectory(const char* dir_path) {
+    std::scoped_lock lock{mutex};
+    auto it = directories.find(NormalizePath(dir_path));
+    if (it != directories.end()) {
+        entry_count -= it->second.size();
+        directories.erase(it);
+    }
+    return generation;
+}
+
+void EntryAttributeCache::StoreDirectoryEntries(const char* dir_path, const FsDirectoryEntry* entries, s64 count, u64 read_generation) {
+    if (count <= 0) {
+        return;
+    }
+
+    std::scoped_lock lock{mutex};
+    // 读取期间有失效操作时这些条目可能已过期 (These entries may be stale if an invalidation ran during the read)
+    if (generation != read_generation) {
+        return;
+    }
+    if (entry_count + static_cast<size_t>(count) > MAX_ENTRIES) {
+        directories.clear();
+        entry_count = 0;
+    }
+
+    auto& directory = directories[NormalizePath(dir_path)];
+    for (s64 i = 0; i < count; ++i) {
+        const FsDirectoryEntry& entry = entries[i];
+
+        Attributes attributes{};
+        attributes.type = (entry.type == FsDirEntryType_Dir) ? haze::FileAttrType_DIR : haze::FileAttrType_FILE;
+        attributes.size = entry.type == FsDirEntryType_Dir ? 0 : entry.file_size;
+        // 目录的属性不含时间戳，无需补查 (Directory attributes carry no timestamp, nothing to fill in)
+        attributes.has_timestamp = entry.type == FsDirEntryType_Dir;
+        if (directory.insert_or_assign(entry.name, attributes).second) {
+            ++entry_count;
+        }
+    }
+}
+
+Result EntryAttributeCache::GetEntryType(FsFileSystem* fs, const char* path, haze::FileAttrType* out_entry_type) {
+    {
+        std::scoped_lock lock{mutex};
+        std::string dir, name;
+        SplitPath(NormalizePath(path), dir, name);
+        auto dir_it = directories.find(dir);
+        if (dir_it != directories.end()) {
+            auto it = dir_it->second.find(name);
+            if (it != dir_it->second.end()) {
+                *out_entry_type = it->second.type;
+                return 0;
+            }
+        }
+    }
+
+    FsDirEntryType type;
+    Result rc = fsFsGetEntryType(fs, path, &type);
+    if (R_SUCCEEDED(rc)) {
+        *out_entry_type = (type == FsDirEntryType_Dir) ? haze::FileAttrType_DIR : haze::FileAttrType_FILE;
+    }
+    return rc;
+}
+
+Result EntryAttributeCache::GetEntryAttributes(FsFileSystem* fs, const char* path, haze::FileAttr* out) {
+    std::string dir, name;
+    SplitPath(NormalizePath(path), dir, name);
+
+    Attributes attributes{};
+    bool found = false;
+    u64 lookup_generation = 0;
+    {
+        std::scoped_lock lock{mutex};
+        lookup_generation = generation;
+        auto dir_it = directories.find(dir);
+        if (dir_it != directories.end()) {
+            auto it = dir_it->second.find(name);
+            if (it != dir_it->second.end()) {
+                attributes = it->second;
+                found = true;
+            }
+        }
+    }
+
+    bool cacheable = true;
+    if (!found) {
+        // 未命中：按原方式查询类型、时间戳和大小 (Miss: query type, timestamp and size the original way)
+        FsDirEntryType type;
+        Result rc = fsFsGetEntryType(fs, path, &type);
+        if (R_FAILED(rc)) {
+            return rc;
+        }
+
+        attributes.type = (type == FsDirEntryType_Dir) ? haze::FileAttrType_DIR : haze::FileAttrType_FILE;
+        attributes.has_timestamp = type == FsDirEntryType_Dir;
+        if (type == FsDirEntryType_File) {
+            // 取不到大小时（例如文件正被写入）本次照常返回，但不写入缓存 (If the size is unavailable, e.g. the file is being
+            // written, answer this query as before but leave the cache alone)
+            cacheable = false;
+            FsFile file;
+            if (R_SUCCEEDED(fsFsOpenFile(fs, path, FsOpenMode_Read, &file))) {
+                s64 size;
+                if (R_SUCCEEDED(fsFileGetSize(&file, &size))) {
+                    attributes.size = size;
+                    cacheable = true;
+                }
+                fsFileClose(&file);
+            }
+        }
+    }
+
+    bool filled_timestamp = false;
+    if (!attributes.has_timestamp) {
+        // 获取时间戳（如果失败也不影响），每个文件只查一次 (Fetch the timestamp, failure is harmless, once per file)
+        FsTimeStampRaw timestamp{};
+        if (R_SUCCEEDED(fsFsGetFileTimeStampRaw(fs, path, &timestamp)) && timestamp.is_valid) {
+            attributes.ctime = timestamp.created;
+            attributes.mtime = timestamp.modified;
+        }
+        attributes.has_timestamp = true;
+        filled_timestamp = true;
+    }
+
+    if (cacheable && (!found || filled_timestamp)) {
+        // 查询期间有失效操作时结果可能已过期，不写回 (Skip the write-back if an invalidation ran during the query, the
+        // result may already be stale)
+        std::scoped_lock lock{mutex};
+        if (generation == lookup_generation) {
+            if (entry_count >= MAX_ENTRIES) {
+                directories.clear();
+                entry_count = 0;
+            }
+            if (directories[dir].insert_or_assign(name, attributes).second) {
+                ++entry_count;
+            }
+        }
+    }
+
+    out->type = attributes.type;
+    out->flag = 0; // 默认可读写 (Read-write by default)
+    out->size = static_cast<u64>(attributes.size);
+    out->ctime = attributes.ctime;
+    out->mtime = attributes.mtime;
+    return 0;
+}
+
+void EntryAttributeCache::InvalidateLocked(const std::string& path) {
+    std::string dir, name;
+    SplitPath(path, dir, name);
+    auto dir_it = directories.find(dir);
+    if (dir_it != directories.end()) {
+        entry_count -= dir_it->second.erase(name);
+    }
+}
+
+void EntryAttributeCache::Invalidate(const char* path) {
+    std::scoped_lock lock{mutex};
+    ++generation;
+    InvalidateLocked(NormalizePath(path));
+}
+
+void EntryAttributeCache::InvalidateDirectory(const char* path) {
+    std::scoped_lock lock{mutex};
+    ++generation;
+    const std::string normalized = NormalizePath(path);
+    InvalidateLocked(normalized);
+
+    // 缓存的目录数量很少，直接遍历找出该目录及其子目录 (Few directories are cached, scan for it and its subdirectories)
+    for (auto it = directories.begin(); it != directories.end();) {
+        const std::string& dir_path = it->first;
+        if (dir_path.starts_with(normalized) &&
+            (dir_path.size() == normalized.size() || dir_path[normalized.size()] == '/')) {
+            entry_count -= it->second.size();
+            it = directories.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace mtp
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <switch.h>
+#include "haze.h"
+
+namespace mtp {
+
+/**
+ * MTP条目属性缓存 - 按目录保存SD卡条目的类型、大小和时间戳，三个文件系统代理共用一份
+ * MTP entry attribute cache - keeps the type, size and timestamps of SD card entries per directory, shared by all
+ * three filesystem proxies
+ *
+ * 电脑列出文件夹时会逐个查询每个条目的属性；读取目录时已经拿到了类型和大小，直接批量写入缓存，
+ * 查询时只需补一次时间戳，不再为每个文件打开/关闭一次
+ * The PC queries the attributes of every entry when it lists a folder; the directory read already yields types and
+ * sizes, so they are stored in bulk and a query only fills in the timestamp once, instead of opening and closing every
+ * file
+ *
+ * 路径均为代理修正后的SD卡路径，代理内的创建、写入、重命名和删除在文件系统操作前后各使对应条目失效一次：
+ * 之前的失效丢弃进行中的查询结果，之后的失效丢弃操作期间写回的旧属性
+ * Paths are the proxies' fixed SD card paths; creates, writes, renames and deletes through a proxy invalidate the
+ * affected entries both before and after the filesystem operation: the first drops the results of queries in flight,
+ * the second drops old attributes cached while the operation ran
+ */
+class EntryAttributeCache {
+public:
+    static constexpr size_t MAX_ENTRIES = 32768; // 超出时整体清空 (Cleared as a whole when exceeded)
+
+    /**
+     * 清空全部缓存（启动MTP时调用，期间SD卡可能已被修改）
+     * Clear the whole cache (called when MTP starts, the SD card may have changed in the meantime)
+     */
+    void Clear();
+
+    /**
+     * 开始重新读取目录，丢弃该目录之前缓存的条目
+     * Start a fresh read of a directory, dropping the entries cached for it before
+     * @param dir_path 目录路径 (Directory path)
+     * @return 当前缓存代数，传给StoreDirectoryEntries (Current cache generation, passed to StoreDirectoryEntries)
+     */
+    u64 BeginDirectory(const char* dir_path);
+
+    /**
+     * 批量记录一次fsDirRead读到的条目，读取期间有失效操作时不记录
+     * Record the entries returned by one fsDirRead in bulk, nothing is recorded if an invalidation ran during the read
+     * @param dir_path 目录路径 (Directory path)
+     * @param entries 目录条目 (Directory entries)
+     * @param count 条目数量 (Entry count)
+     * @param read_generation BeginDirectory返回的缓存代数 (Cache generation returned by BeginDirectory)
+     */
+    void StoreDirectoryEntries(const char* dir_path, const FsDirectoryEntry* entries, s64 count, u64 read_generation);
+
+    /**
+     * 查询条目类型，未命中时查询文件系统
+     * Look up an entry's type, querying the filesystem on a miss
+     */
+    Result GetEntryType(FsFileSystem* fs, const char* path, haze::FileAttrType* out_entry_type);
+
+    /**
+     * 查询条目属性，未命中时查询文件系统并写入缓存
+     * Look up an entry's attributes, querying the filesystem and filling the cache on a miss
+     */
+    Result GetEntryAttributes(FsFileSystem* fs, const char* path, haze::FileAttr* out);
+
+    /**
+     * 使单个条目失效（文件或空目录的创建、写入、删除、重命名）
+     * Invalidate a single entry (file or empty directory create, write, delete or rename)
+     */
+    void Invalidate(const char* path);
+
+    /**
+     * 使目录条目及其下所有缓存的条目失效（目录删除、重命名）
+     * Invalidate a directory entry and everything cached below it (directory delete or rename)
+     */
+    void InvalidateDirectory(const char* path);
+
+private:
+    struct Attributes {
+        haze::FileAttrType type;
+        s64 size;
+        u64 ctime;
+        u64 mtime;
+        bool has_timestamp; // 目录读取不返回时间戳，首次查询时补上 (Directory reads carry no timestamp, filled on first query)
+    };
+
+    using Directory = std::unordered_map<std::string, Attributes>; // 条目名 -> 属性 (Entry name -> attributes)
+
+    static std::string NormalizePath(const char* path);
+    static void SplitPath(const std::string& path, std::string& dir, std::string& name);
+    void InvalidateLocked(const std::string& path);
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Directory> directories; // 目录路径 -> 条目 (Directory path -> entries)
+    size_t entry_count{0};
+    u64 generation{0}; // 每次失效加一 (Bumped on every invalidation)
+};
+
+} // namespace mtp
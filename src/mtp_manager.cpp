@@ -12,6 +12,40 @@
 
 namespace mtp {
 
+namespace {
+
+// 代理打开的文件，记录路径以便写入结束时使属性缓存失效
+// (A file opened by a proxy, its path is kept so the attribute cache can be invalidated when a write finishes)
+struct OpenedFile {
+    FsFile file;
+    std::string path;
+    bool writable;
+};
+
+// 代理打开的目录，记录路径以便读取时批量填充属性缓存
+// (A directory opened by a proxy, its path is kept so reads can fill the attribute cache in bulk)
+struct OpenedDirectory {
+    FsDir dir;
+    std::string path;
+    u64 cache_generation; // 打开目录时的缓存代数 (Cache generation when the directory was opened)
+};
+
+// 将MTP路径转换为SD卡路径，写入调用方提供的缓冲区，多个线程可同时调用
+// (Translate an MTP path into an SD card path in a caller-provided buffer, safe to call from several threads at once)
+// 文件名已由libhaze解码为UTF-8，原样保留，中文目录也能正常访问
+// (Names are already decoded to UTF-8 by libhaze and kept as-is, so CJK folders stay reachable)
+const char* TranslatePath(const char* path, const char* mount_name, const char* sd_root, char* out) {
+    const size_t len = std::strlen(mount_name);
+    if (len && !strncasecmp(path, mount_name, len)) {
+        std::snprintf(out, FS_MAX_PATH, "%s/%s", sd_root, path + len);
+    } else {
+        std::snprintf(out, FS_MAX_PATH, "%s%s", sd_root, path);
+    }
+    return out;
+}
+
+} // namespace
+
 // 静态成员初始化
 MtpManager* MtpManager::s_instance = nullptr;
 
@@ -19,7 +53,8 @@ MtpManager* MtpManager::s_instance = nullptr;
 // SdCardFileSystemProxy 实现
 //=============================================================================
 
-SdCardFileSystemProxy::SdCardFileSystemProxy() {
+SdCardFileSystemProxy::SdCardFileSystemProxy(std::shared_ptr<EntryAttributeCache> attr_cache)
+    : m_attr_cache(std::move(attr_cache)) {
     // 获取SD卡文件系统
     m_fs = fsdevGetDeviceFileSystem("sdmc");
 }
@@ -37,86 +72,28 @@ const char* SdCardFileSystemProxy::GetDisplayName() const {
 }
 
 const char* SdCardFileSystemProxy::FixPath(const char* path, char* out) const {
-    // 路径修正：参考libhaze示例实现
-    static char buf[FS_MAX_PATH];
-    const auto len = std::strlen(GetName());
-
-    if (!out) {
-        out = buf;
-    }
-
-    // 先进行原有的路径处理逻辑
-    if (len && !strncasecmp(path + 1, GetName(), len)) {
-        std::snprintf(out, FS_MAX_PATH, "/%s", path + 1 + len);
-    } else {
-        std::strcpy(out, path);
-    }
-
-    // 处理中文字符：将非ASCII字符替换为连字符
-    char* p = out;
-    while (*p) {
-        if ((*p & 0x80) != 0) {  // 非ASCII字符
-            *p = '-';
-        }
-        p++;
-    }
-
-    return out;
+    return TranslatePath(path, GetName(), "", out);
 }
 
 Result SdCardFileSystemProxy::GetTotalSpace(const char *path, s64 *out) {
-    return fsFsGetTotalSpace(m_fs, FixPath(path), out);
+    char fixed_path[FS_MAX_PATH];
+    return fsFsGetTotalSpace(m_fs, FixPath(path, fixed_path), out);
 }
 
 Result SdCardFileSystemProxy::GetFreeSpace(const char *path, s64 *out) {
-    return fsFsGetFreeSpace(m_fs, FixPath(path), out);
+    char fixed_path[FS_MAX_PATH];
+    return fsFsGetFreeSpace(m_fs, FixPath(path, fixed_path), out);
 }
 
 Result SdCardFileSystemProxy::GetEntryType(const char *path, haze::FileAttrType *out_entry_type) {
-    FsDirEntryType type;
-    Result rc = fsFsGetEntryType(m_fs, FixPath(path), &type);
-    if (R_SUCCEEDED(rc)) {
-        *out_entry_type = (type == FsDirEntryType_Dir) ? haze::FileAttrType_DIR : haze::FileAttrType_FILE;
-    }
-    return rc;
+    char fixed_path[FS_MAX_PATH];
+    return m_attr_cache->GetEntryType(m_fs, FixPath(path, fixed_path), out_entry_type);
 }
 
 Result SdCardFileSystemProxy::GetEntryAttributes(const char *path, haze::FileAttr *out) {
-    // 获取文件类型
-    FsDirEntryType type;
-    Result rc = fsFsGetEntryType(m_fs, FixPath(path), &type);
-    if (R_FAILED(rc)) {
-        return rc;
-    }
-
-    if (type == FsDirEntryType_File) {
-        out->type = haze::FileAttrType_FILE;
-
-        // 获取时间戳（如果失败也不影响）
-        FsTimeStampRaw timestamp{};
-        if (R_SUCCEEDED(fsFsGetFileTimeStampRaw(m_fs, FixPath(path), &timestamp)) && timestamp.is_valid) {
-            out->ctime = timestamp.created;
-            out->mtime = timestamp.modified;
-        }
-
-        // 获取文件大小
-        FsFile file;
-        rc = fsFsOpenFile(m_fs, FixPath(path), FsOpenMode_Read, &file);
-        if (R_SUCCEEDED(rc)) {
-            s64 size;
-            if (R_SUCCEEDED(fsFileGetSize(&file, &size))) {
-                out->size = size;
-            }
-            fsFileClose(&file);
-        }
-    } else {
-        out->type = haze::FileAttrType_DIR;
-    }
-
-    // 设置只读标志（如果需要）
-    out->flag = 0;  // 默认可读写
-
-    return 0;  // 成功
+    // 优先使用目录读取时缓存的类型和大小 (Prefer the type and size cached by the directory read)
+    char fixed_path[FS_MAX_PATH];
+    return m_attr_cache->GetEntryAttributes(m_fs, FixPath(path, fixed_path), out);
 }
 
 Result SdCardFileSystemProxy::CreateFile(const char* path, s64 size) {
@@ -128,16 +105,33 @@ Result SdCardFileSystemProxy::CreateFile(const char* path, s64 size) {
 
     // 参考libhaze示例：不在这里设置大小，避免长时间阻塞导致超时
     // SEE: https://github.com/ITotalJustice/libhaze/issues/1#issuecomment-3305067733
-    return fsFsCreateFile(m_fs, FixPath(path), 0, flags);
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    const Result rc = fsFsCreateFile(m_fs, fixed_path, 0, flags);
+    m_attr_cache->Invalidate(fixed_path);
+    return rc;
 }
 
 Result SdCardFileSystemProxy::DeleteFile(const char* path) {
-    return fsFsDeleteFile(m_fs, FixPath(path));
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    const Result rc = fsFsDeleteFile(m_fs, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    return rc;
 }
 
 Result SdCardFileSystemProxy::RenameFile(const char *old_path, const char *new_path) {
     char fixed_old[FS_MAX_PATH], fixed_new[FS_MAX_PATH];
-    return fsFsRenameFile(m_fs, FixPath(old_path, fixed_old), FixPath(new_path, fixed_new));
+    FixPath(old_path, fixed_old);
+    FixPath(new_path, fixed_new);
+    m_attr_cache->Invalidate(fixed_old);
+    m_attr_cache->Invalidate(fixed_new);
+    const Result rc = fsFsRenameFile(m_fs, fixed_old, fixed_new);
+    m_attr_cache->Invalidate(fixed_old);
+    m_attr_cache->Invalidate(fixed_new);
+    return rc;
 }
 
 Result SdCardFileSystemProxy::OpenFile(const char *path, haze::FileOpenMode mode, haze::File *out_file) {
@@ -146,100 +140,133 @@ Result SdCardFileSystemProxy::OpenFile(const char *path, haze::FileOpenMode mode
         flags = FsOpenMode_Write | FsOpenMode_Append;
     }
 
-    auto f = new FsFile();
-    const auto rc = fsFsOpenFile(m_fs, FixPath(path), flags, f);
+    auto f = new OpenedFile();
+    char fixed_path[FS_MAX_PATH];
+    f->path = FixPath(path, fixed_path);
+    f->writable = mode == haze::FileOpenMode_WRITE;
+    const auto rc = fsFsOpenFile(m_fs, f->path.c_str(), flags, &f->file);
     if (R_FAILED(rc)) {
         delete f;
         return rc;
     }
 
+    if (f->writable) {
+        m_attr_cache->Invalidate(f->path.c_str());
+    }
     out_file->impl = f;
     return 0;  // 成功
 }
 
 Result SdCardFileSystemProxy::GetFileSize(haze::File *file, s64 *out_size) {
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileGetSize(f, out_size);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileGetSize(&f->file, out_size);
 }
 
 Result SdCardFileSystemProxy::SetFileSize(haze::File *file, s64 size) {
     // 参考libhaze示例：设置为0如果Switch在分配大文件时冻结
     // 这通常发生在使用emuMMC + Windows时
     #if 0
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileSetSize(f, size);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileSetSize(&f->file, size);
     #else
     return 0;  // 成功，但不实际设置大小
     #endif
 }
 
 Result SdCardFileSystemProxy::ReadFile(haze::File *file, s64 off, void *buf, u64 read_size, u64 *out_bytes_read) {
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileRead(f, off, buf, read_size, FsReadOption_None, out_bytes_read);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileRead(&f->file, off, buf, read_size, FsReadOption_None, out_bytes_read);
 }
 
 Result SdCardFileSystemProxy::WriteFile(haze::File *file, s64 off, const void *buf, u64 write_size) {
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileWrite(f, off, buf, write_size, FsWriteOption_None);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileWrite(&f->file, off, buf, write_size, FsWriteOption_None);
 }
 
 void SdCardFileSystemProxy::CloseFile(haze::File *file) {
-    auto f = static_cast<FsFile*>(file->impl);
+    auto f = static_cast<OpenedFile*>(file->impl);
     if (f) {
-        fsFileClose(f);
+        fsFileClose(&f->file);
+        // 写入结束后大小和时间戳都已变化 (Size and timestamps have changed once the write finishes)
+        if (f->writable) {
+            m_attr_cache->Invalidate(f->path.c_str());
+        }
         delete f;
         file->impl = nullptr;
     }
 }
 
 Result SdCardFileSystemProxy::CreateDirectory(const char* path) {
-    return fsFsCreateDirectory(m_fs, FixPath(path));
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    const Result rc = fsFsCreateDirectory(m_fs, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    return rc;
 }
 
 Result SdCardFileSystemProxy::DeleteDirectoryRecursively(const char* path) {
-    return fsFsDeleteDirectoryRecursively(m_fs, FixPath(path));
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->InvalidateDirectory(fixed_path);
+    const Result rc = fsFsDeleteDirectoryRecursively(m_fs, fixed_path);
+    m_attr_cache->InvalidateDirectory(fixed_path);
+    return rc;
 }
 
 Result SdCardFileSystemProxy::RenameDirectory(const char *old_path, const char *new_path) {
     char fixed_old[FS_MAX_PATH], fixed_new[FS_MAX_PATH];
-    return fsFsRenameDirectory(m_fs, FixPath(old_path, fixed_old), FixPath(new_path, fixed_new));
+    FixPath(old_path, fixed_old);
+    FixPath(new_path, fixed_new);
+    m_attr_cache->InvalidateDirectory(fixed_old);
+    m_attr_cache->InvalidateDirectory(fixed_new);
+    const Result rc = fsFsRenameDirectory(m_fs, fixed_old, fixed_new);
+    m_attr_cache->InvalidateDirectory(fixed_old);
+    m_attr_cache->InvalidateDirectory(fixed_new);
+    return rc;
 }
 
 Result SdCardFileSystemProxy::OpenDirectory(const char *path, haze::Dir *out_dir) {
-    auto dir = new FsDir();
-    const auto rc = fsFsOpenDirectory(m_fs, FixPath(path), FsDirOpenMode_ReadDirs | FsDirOpenMode_ReadFiles | FsDirOpenMode_NoFileSize, dir);
+    // 不再使用NoFileSize：读取目录时顺带取得文件大小填充属性缓存
+    // (NoFileSize is no longer used: the directory read also returns file sizes to fill the attribute cache)
+    auto dir = new OpenedDirectory();
+    char fixed_path[FS_MAX_PATH];
+    dir->path = FixPath(path, fixed_path);
+    const auto rc = fsFsOpenDirectory(m_fs, dir->path.c_str(), FsDirOpenMode_ReadDirs | FsDirOpenMode_ReadFiles, &dir->dir);
     if (R_FAILED(rc)) {
         delete dir;
         return rc;
     }
 
+    dir->cache_generation = m_attr_cache->BeginDirectory(dir->path.c_str());
     out_dir->impl = dir;
     return 0;  // 成功
 }
 
 Result SdCardFileSystemProxy::ReadDirectory(haze::Dir *d, s64 *out_total_entries, size_t max_entries, haze::DirEntry *buf) {
-    auto dir = static_cast<FsDir*>(d->impl);
+    auto dir = static_cast<OpenedDirectory*>(d->impl);
 
     std::vector<FsDirectoryEntry> entries(max_entries);
-    Result rc = fsDirRead(dir, out_total_entries, entries.size(), entries.data());
+    Result rc = fsDirRead(&dir->dir, out_total_entries, entries.size(), entries.data());
     if (R_SUCCEEDED(rc)) {
         for (s64 i = 0; i < *out_total_entries; i++) {
             std::strcpy(buf[i].name, entries[i].name);
         }
+        m_attr_cache->StoreDirectoryEntries(dir->path.c_str(), entries.data(), *out_total_entries, dir->cache_generation);
     }
 
     return rc;
 }
 
 Result SdCardFileSystemProxy::GetDirectoryEntryCount(haze::Dir *d, s64 *out_count) {
-    auto dir = static_cast<FsDir*>(d->impl);
-    return fsDirGetEntryCount(dir, out_count);
+    auto dir = static_cast<OpenedDirectory*>(d->impl);
+    return fsDirGetEntryCount(&dir->dir, out_count);
 }
 
 void SdCardFileSystemProxy::CloseDirectory(haze::Dir *d) {
-    auto dir = static_cast<FsDir*>(d->impl);
+    auto dir = static_cast<OpenedDirectory*>(d->impl);
     if (dir) {
-        fsDirClose(dir);
+        fsDirClose(&dir->dir);
         delete dir;
         d->impl = nullptr;
     }
@@ -249,7 +276,8 @@ void SdCardFileSystemProxy::CloseDirectory(haze::Dir *d) {
 // AddModProxy 实现 - 简单版本，参考libhaze示例
 //=============================================================================
 
-AddModProxy::AddModProxy() {
+AddModProxy::AddModProxy(std::shared_ptr<EntryAttributeCache> attr_cache)
+    : m_attr_cache(std::move(attr_cache)) {
     // 获取SD卡文件系统，与SdCardFileSystemProxy相同的方式
     m_fs = fsdevGetDeviceFileSystem("sdmc");
 }
@@ -263,87 +291,29 @@ const char* AddModProxy::GetDisplayName() const {
 }
 
 const char* AddModProxy::FixPath(const char* path, char* out) const {
-    // 路径修正：参考libhaze示例实现
-    static char buf[FS_MAX_PATH];
-    const auto len = std::strlen(GetName());
-
-    if (!out) {
-        out = buf;
-    }
-
-    // 按照libhaze示例的逻辑处理路径
-    if (len && !strncasecmp(path, GetName(), len)) {
-        std::snprintf(out, FS_MAX_PATH, "/mods2/0000-add-mod-0000/%s", path + len);
-    } else {
-        std::snprintf(out, FS_MAX_PATH, "/mods2/0000-add-mod-0000%s", path);
-    }
-
-    // 处理中文字符：将非ASCII字符替换为连字符
-    char* p = out;
-    while (*p) {
-        if ((*p & 0x80) != 0) {  // 非ASCII字符
-            *p = '-';
-        }
-        p++;
-    }
-
-    return out;
+    return TranslatePath(path, GetName(), "/mods2/0000-add-mod-0000", out);
 }
 
 // 空间信息
 Result AddModProxy::GetTotalSpace(const char *path, s64 *out) {
-    return fsFsGetTotalSpace(m_fs, FixPath(path), out);
+    char fixed_path[FS_MAX_PATH];
+    return fsFsGetTotalSpace(m_fs, FixPath(path, fixed_path), out);
 }
 
 Result AddModProxy::GetFreeSpace(const char *path, s64 *out) {
-    return fsFsGetFreeSpace(m_fs, FixPath(path), out);
+    char fixed_path[FS_MAX_PATH];
+    return fsFsGetFreeSpace(m_fs, FixPath(path, fixed_path), out);
 }
 
 Result AddModProxy::GetEntryType(const char *path, haze::FileAttrType *out_entry_type) {
-    FsDirEntryType type;
-    Result rc = fsFsGetEntryType(m_fs, FixPath(path), &type);
-    if (R_SUCCEEDED(rc)) {
-        *out_entry_type = (type == FsDirEntryType_Dir) ? haze::FileAttrType_DIR : haze::FileAttrType_FILE;
-    }
-    return rc;
+    char fixed_path[FS_MAX_PATH];
+    return m_attr_cache->GetEntryType(m_fs, FixPath(path, fixed_path), out_entry_type);
 }
 
 Result AddModProxy::GetEntryAttributes(const char *path, haze::FileAttr *out) {
-    // 获取文件类型
-    FsDirEntryType type;
-    Result rc = fsFsGetEntryType(m_fs, FixPath(path), &type);
-    if (R_FAILED(rc)) {
-        return rc;
-    }
-
-    if (type == FsDirEntryType_File) {
-        out->type = haze::FileAttrType_FILE;
-
-        // 获取时间戳（如果失败也不影响）
-        FsTimeStampRaw timestamp{};
-        if (R_SUCCEEDED(fsFsGetFileTimeStampRaw(m_fs, FixPath(path), &timestamp)) && timestamp.is_valid) {
-            out->ctime = timestamp.created;
-            out->mtime = timestamp.modified;
-        }
-
-        // 获取文件大小
-        FsFile file;
-        rc = fsFsOpenFile(m_fs, FixPath(path), FsOpenMode_Read, &file);
-        if (R_SUCCEEDED(rc)) {
-            s64 size;
-            if (R_SUCCEEDED(fsFileGetSize(&file, &size))) {
-                out->size = size;
-            }
-            fsFileClose(&file);
-        }
-    } else {
-        out->type = haze::FileAttrType_DIR;
-    }
-
-    // 设置只读标志（如果需要）
-    out->flag = 0;  // 默认可读写
-
-    return 0;  // 成功
+    // 优先使用目录读取时缓存的类型和大小 (Prefer the type and size cached by the directory read)
+    char fixed_path[FS_MAX_PATH];
+    return m_attr_cache->GetEntryAttributes(m_fs, FixPath(path, fixed_path), out);
 }
 
 // 文件操作
@@ -356,66 +326,92 @@ Result AddModProxy::CreateFile(const char* path, s64 size) {
 
     // 参考libhaze示例：不在这里设置大小，避免长时间阻塞导致超时
     // SEE: https://github.com/ITotalJustice/libhaze/issues/1#issuecomment-3305067733
-    return fsFsCreateFile(m_fs, FixPath(path), 0, flags);
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    const Result rc = fsFsCreateFile(m_fs, fixed_path, 0, flags);
+    m_attr_cache->Invalidate(fixed_path);
+    return rc;
 }
 
 Result AddModProxy::DeleteFile(const char* path) {
-    return fsFsDeleteFile(m_fs, FixPath(path));
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    const Result rc = fsFsDeleteFile(m_fs, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    return rc;
 }
 
 Result AddModProxy::RenameFile(const char *old_path, const char *new_path) {
     char fixed_old[FS_MAX_PATH], fixed_new[FS_MAX_PATH];
-    return fsFsRenameFile(m_fs, FixPath(old_path, fixed_old), FixPath(new_path, fixed_new));
+    FixPath(old_path, fixed_old);
+    FixPath(new_path, fixed_new);
+    m_attr_cache->Invalidate(fixed_old);
+    m_attr_cache->Invalidate(fixed_new);
+    const Result rc = fsFsRenameFile(m_fs, fixed_old, fixed_new);
+    m_attr_cache->Invalidate(fixed_old);
+    m_attr_cache->Invalidate(fixed_new);
+    return rc;
 }
 
 Result AddModProxy::OpenFile(const char *path, haze::FileOpenMode mode, haze::File *out_file) {
-    // 转换haze::FileOpenMode到FsOpenMode
-    u32 fs_mode = FsOpenMode_Read;
+    u32 flags = FsOpenMode_Read;
     if (mode == haze::FileOpenMode_WRITE) {
-        fs_mode = FsOpenMode_Write | FsOpenMode_Append;
+        flags = FsOpenMode_Write | FsOpenMode_Append;
     }
 
-    auto file = new FsFile();
-    const auto rc = fsFsOpenFile(m_fs, FixPath(path), fs_mode, file);
+    auto f = new OpenedFile();
+    char fixed_path[FS_MAX_PATH];
+    f->path = FixPath(path, fixed_path);
+    f->writable = mode == haze::FileOpenMode_WRITE;
+    const auto rc = fsFsOpenFile(m_fs, f->path.c_str(), flags, &f->file);
     if (R_FAILED(rc)) {
-        delete file;
+        delete f;
         return rc;
     }
 
-    out_file->impl = file;
+    if (f->writable) {
+        m_attr_cache->Invalidate(f->path.c_str());
+    }
+    out_file->impl = f;
     return 0;  // 成功
 }
 
 Result AddModProxy::GetFileSize(haze::File *file, s64 *out_size) {
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileGetSize(f, out_size);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileGetSize(&f->file, out_size);
 }
 
 Result AddModProxy::SetFileSize(haze::File *file, s64 size) {
     // 参考libhaze示例：设置为0如果Switch在分配大文件时冻结
     // 这通常发生在使用emuMMC + Windows时
     #if 0
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileSetSize(f, size);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileSetSize(&f->file, size);
     #else
     return 0;  // 成功，但不实际设置大小
     #endif
 }
 
 Result AddModProxy::ReadFile(haze::File *file, s64 off, void *buf, u64 read_size, u64 *out_bytes_read) {
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileRead(f, off, buf, read_size, FsReadOption_None, out_bytes_read);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileRead(&f->file, off, buf, read_size, FsReadOption_None, out_bytes_read);
 }
 
 Result AddModProxy::WriteFile(haze::File *file, s64 off, const void *buf, u64 write_size) {
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileWrite(f, off, buf, write_size, FsWriteOption_None);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileWrite(&f->file, off, buf, write_size, FsWriteOption_None);
 }
 
 void AddModProxy::CloseFile(haze::File *file) {
-    auto f = static_cast<FsFile*>(file->impl);
+    auto f = static_cast<OpenedFile*>(file->impl);
     if (f) {
-        fsFileClose(f);
+        fsFileClose(&f->file);
+        // 写入结束后大小和时间戳都已变化 (Size and timestamps have changed once the write finishes)
+        if (f->writable) {
+            m_attr_cache->Invalidate(f->path.c_str());
+        }
         delete f;
         file->impl = nullptr;
     }
@@ -423,53 +419,76 @@ void AddModProxy::CloseFile(haze::File *file) {
 
 // 目录操作
 Result AddModProxy::CreateDirectory(const char* path) {
-    return fsFsCreateDirectory(m_fs, FixPath(path));
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    const Result rc = fsFsCreateDirectory(m_fs, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    return rc;
 }
 
 Result AddModProxy::DeleteDirectoryRecursively(const char* path) {
-    return fsFsDeleteDirectoryRecursively(m_fs, FixPath(path));
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->InvalidateDirectory(fixed_path);
+    const Result rc = fsFsDeleteDirectoryRecursively(m_fs, fixed_path);
+    m_attr_cache->InvalidateDirectory(fixed_path);
+    return rc;
 }
 
 Result AddModProxy::RenameDirectory(const char *old_path, const char *new_path) {
     char fixed_old[FS_MAX_PATH], fixed_new[FS_MAX_PATH];
-    return fsFsRenameDirectory(m_fs, FixPath(old_path, fixed_old), FixPath(new_path, fixed_new));
+    FixPath(old_path, fixed_old);
+    FixPath(new_path, fixed_new);
+    m_attr_cache->InvalidateDirectory(fixed_old);
+    m_attr_cache->InvalidateDirectory(fixed_new);
+    const Result rc = fsFsRenameDirectory(m_fs, fixed_old, fixed_new);
+    m_attr_cache->InvalidateDirectory(fixed_old);
+    m_attr_cache->InvalidateDirectory(fixed_new);
+    return rc;
 }
 
 Result AddModProxy::OpenDirectory(const char *path, haze::Dir *out_dir) {
-    auto dir = new FsDir();
-    const auto rc = fsFsOpenDirectory(m_fs, FixPath(path), FsDirOpenMode_ReadDirs | FsDirOpenMode_ReadFiles | FsDirOpenMode_NoFileSize, dir);
+    // 不再使用NoFileSize：读取目录时顺带取得文件大小填充属性缓存
+    // (NoFileSize is no longer used: the directory read also returns file sizes to fill the attribute cache)
+    auto dir = new OpenedDirectory();
+    char fixed_path[FS_MAX_PATH];
+    dir->path = FixPath(path, fixed_path);
+    const auto rc = fsFsOpenDirectory(m_fs, dir->path.c_str(), FsDirOpenMode_ReadDirs | FsDirOpenMode_ReadFiles, &dir->dir);
     if (R_FAILED(rc)) {
         delete dir;
         return rc;
     }
 
+    dir->cache_generation = m_attr_cache->BeginDirectory(dir->path.c_str());
     out_dir->impl = dir;
     return 0;  // 成功
 }
 
 Result AddModProxy::ReadDirectory(haze::Dir *d, s64 *out_total_entries, size_t max_entries, haze::DirEntry *buf) {
-    auto dir = static_cast<FsDir*>(d->impl);
+    auto dir = static_cast<OpenedDirectory*>(d->impl);
 
     std::vector<FsDirectoryEntry> entries(max_entries);
-    Result rc = fsDirRead(dir, out_total_entries, entries.size(), entries.data());
+    Result rc = fsDirRead(&dir->dir, out_total_entries, entries.size(), entries.data());
     if (R_SUCCEEDED(rc)) {
         for (s64 i = 0; i < *out_total_entries; i++) {
             std::strcpy(buf[i].name, entries[i].name);
         }
+        m_attr_cache->StoreDirectoryEntries(dir->path.c_str(), entries.data(), *out_total_entries, dir->cache_generation);
     }
 
     return rc;
 }
 
 Result AddModProxy::GetDirectoryEntryCount(haze::Dir *d, s64 *out_count) {
-    auto dir = static_cast<FsDir*>(d->impl);
-    return fsDirGetEntryCount(dir, out_count);
+    auto dir = static_cast<OpenedDirectory*>(d->impl);
+    return fsDirGetEntryCount(&dir->dir, out_count);
 }
 
 void AddModProxy::CloseDirectory(haze::Dir *d) {
-    auto dir = static_cast<FsDir*>(d->impl);
+    auto dir = static_cast<OpenedDirectory*>(d->impl);
     if (dir) {
-        fsDirClose(dir);
+        fsDirClose(&dir->dir);
         delete dir;
         d->impl = nullptr;
     }
@@ -479,7 +498,8 @@ void AddModProxy::CloseDirectory(haze::Dir *d) {
 // NxModManagerProxy 实现
 //=============================================================================
 
-NxModManagerProxy::NxModManagerProxy() {
+NxModManagerProxy::NxModManagerProxy(std::shared_ptr<EntryAttributeCache> attr_cache)
+    : m_attr_cache(std::move(attr_cache)) {
     // 获取SD卡文件系统，与SdCardFileSystemProxy相同的方式
     m_fs = fsdevGetDeviceFileSystem("sdmc");
 }
@@ -493,87 +513,29 @@ const char* NxModManagerProxy::GetDisplayName() const {
 }
 
 const char* NxModManagerProxy::FixPath(const char* path, char* out) const {
-    // 路径修正：参考libhaze示例实现
-    static char buf[FS_MAX_PATH];
-    const auto len = std::strlen(GetName());
-
-    if (!out) {
-        out = buf;
-    }
-
-    // 按照libhaze示例的逻辑处理路径
-    if (len && !strncasecmp(path, GetName(), len)) {
-        std::snprintf(out, FS_MAX_PATH, "/mods2/%s", path + len);
-    } else {
-        std::snprintf(out, FS_MAX_PATH, "/mods2%s", path);
-    }
-
-    // 处理中文字符：将非ASCII字符替换为连字符
-    char* p = out;
-    while (*p) {
-        if ((*p & 0x80) != 0) {  // 非ASCII字符
-            *p = '-';
-        }
-        p++;
-    }
-
-    return out;
+    return TranslatePath(path, GetName(), "/mods2", out);
 }
 
 // 空间信息
 Result NxModManagerProxy::GetTotalSpace(const char *path, s64 *out) {
-    return fsFsGetTotalSpace(m_fs, FixPath(path), out);
+    char fixed_path[FS_MAX_PATH];
+    return fsFsGetTotalSpace(m_fs, FixPath(path, fixed_path), out);
 }
 
 Result NxModManagerProxy::GetFreeSpace(const char *path, s64 *out) {
-    return fsFsGetFreeSpace(m_fs, FixPath(path), out);
+    char fixed_path[FS_MAX_PATH];
+    return fsFsGetFreeSpace(m_fs, FixPath(path, fixed_path), out);
 }
 
 Result NxModManagerProxy::GetEntryType(const char *path, haze::FileAttrType *out_entry_type) {
-    FsDirEntryType type;
-    Result rc = fsFsGetEntryType(m_fs, FixPath(path), &type);
-    if (R_SUCCEEDED(rc)) {
-        *out_entry_type = (type == FsDirEntryType_Dir) ? haze::FileAttrType_DIR : haze::FileAttrType_FILE;
-    }
-    return rc;
+    char fixed_path[FS_MAX_PATH];
+    return m_attr_cache->GetEntryType(m_fs, FixPath(path, fixed_path), out_entry_type);
 }
 
 Result NxModManagerProxy::GetEntryAttributes(const char *path, haze::FileAttr *out) {
-    // 获取文件类型
-    FsDirEntryType type;
-    Result rc = fsFsGetEntryType(m_fs, FixPath(path), &type);
-    if (R_FAILED(rc)) {
-        return rc;
-    }
-
-    if (type == FsDirEntryType_File) {
-        out->type = haze::FileAttrType_FILE;
-
-        // 获取时间戳（如果失败也不影响）
-        FsTimeStampRaw timestamp{};
-        if (R_SUCCEEDED(fsFsGetFileTimeStampRaw(m_fs, FixPath(path), &timestamp)) && timestamp.is_valid) {
-            out->ctime = timestamp.created;
-            out->mtime = timestamp.modified;
-        }
-
-        // 获取文件大小
-        FsFile file;
-        rc = fsFsOpenFile(m_fs, FixPath(path), FsOpenMode_Read, &file);
-        if (R_SUCCEEDED(rc)) {
-            s64 size;
-            if (R_SUCCEEDED(fsFileGetSize(&file, &size))) {
-                out->size = size;
-            }
-            fsFileClose(&file);
-        }
-    } else {
-        out->type = haze::FileAttrType_DIR;
-    }
-
-    // 设置只读标志（如果需要）
-    out->flag = 0;  // 默认可读写
-
-    return 0;  // 成功
+    // 优先使用目录读取时缓存的类型和大小 (Prefer the type and size cached by the directory read)
+    char fixed_path[FS_MAX_PATH];
+    return m_attr_cache->GetEntryAttributes(m_fs, FixPath(path, fixed_path), out);
 }
 
 // 文件操作
@@ -586,67 +548,92 @@ Result NxModManagerProxy::CreateFile(const char* path, s64 size) {
 
     // 参考libhaze示例：不在这里设置大小，避免长时间阻塞导致超时
     // SEE: https://github.com/ITotalJustice/libhaze/issues/1#issuecomment-3305067733
-    return fsFsCreateFile(m_fs, FixPath(path), 0, flags);
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    const Result rc = fsFsCreateFile(m_fs, fixed_path, 0, flags);
+    m_attr_cache->Invalidate(fixed_path);
+    return rc;
 }
 
 Result NxModManagerProxy::DeleteFile(const char* path) {
-    return fsFsDeleteFile(m_fs, FixPath(path));
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    const Result rc = fsFsDeleteFile(m_fs, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    return rc;
 }
 
 Result NxModManagerProxy::RenameFile(const char *old_path, const char *new_path) {
     char fixed_old[FS_MAX_PATH], fixed_new[FS_MAX_PATH];
-    return fsFsRenameFile(m_fs, FixPath(old_path, fixed_old), FixPath(new_path, fixed_new));
+    FixPath(old_path, fixed_old);
+    FixPath(new_path, fixed_new);
+    m_attr_cache->Invalidate(fixed_old);
+    m_attr_cache->Invalidate(fixed_new);
+    const Result rc = fsFsRenameFile(m_fs, fixed_old, fixed_new);
+    m_attr_cache->Invalidate(fixed_old);
+    m_attr_cache->Invalidate(fixed_new);
+    return rc;
 }
 
 Result NxModManagerProxy::OpenFile(const char *path, haze::FileOpenMode mode, haze::File *out_file) {
-    // 转换haze::FileOpenMode到FsOpenMode
-    u32 fs_mode = FsOpenMode_Read;
+    u32 flags = FsOpenMode_Read;
     if (mode == haze::FileOpenMode_WRITE) {
-        fs_mode = FsOpenMode_Write | FsOpenMode_Append;
+        flags = FsOpenMode_Write | FsOpenMode_Append;
     }
 
-    auto file = new FsFile();
-    const auto rc = fsFsOpenFile(m_fs, FixPath(path), fs_mode, file);
+    auto f = new OpenedFile();
+    char fixed_path[FS_MAX_PATH];
+    f->path = FixPath(path, fixed_path);
+    f->writable = mode == haze::FileOpenMode_WRITE;
+    const auto rc = fsFsOpenFile(m_fs, f->path.c_str(), flags, &f->file);
     if (R_FAILED(rc)) {
-        delete file;
+        delete f;
         return rc;
     }
 
-    out_file->impl = file;
+    if (f->writable) {
+        m_attr_cache->Invalidate(f->path.c_str());
+    }
+    out_file->impl = f;
     return 0;  // 成功
 }
 
 Result NxModManagerProxy::GetFileSize(haze::File *file, s64 *out_size) {
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileGetSize(f, out_size);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileGetSize(&f->file, out_size);
 }
 
 Result NxModManagerProxy::SetFileSize(haze::File *file, s64 size) {
     // 参考libhaze示例：设置为0如果Switch在分配大文件时冻结
     // 这通常发生在使用emuMMC + Windows时
     #if 0
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileSetSize(f, size);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileSetSize(&f->file, size);
     #else
     return 0;  // 成功，但不实际设置大小
     #endif
 }
 
 Result NxModManagerProxy::ReadFile(haze::File *file, s64 off, void *buf, u64 read_size, u64 *out_bytes_read) {
-    auto f = static_cast<FsFile*>(file->impl);
-    return fsFileRead(f, off, buf, read_size, FsReadOption_None, out_bytes_read);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileRead(&f->file, off, buf, read_size, FsReadOption_None, out_bytes_read);
 }
 
 Result NxModManagerProxy::WriteFile(haze::File *file, s64 off, const void *buf, u64 write_size) {
-    auto f = static_cast<FsFile*>(file->impl);
-    
-    return fsFileWrite(f, off, buf, write_size, FsWriteOption_None);
+    auto f = static_cast<OpenedFile*>(file->impl);
+    return fsFileWrite(&f->file, off, buf, write_size, FsWriteOption_None);
 }
 
 void NxModManagerProxy::CloseFile(haze::File *file) {
-    auto f = static_cast<FsFile*>(file->impl);
+    auto f = static_cast<OpenedFile*>(file->impl);
     if (f) {
-        fsFileClose(f);
+        fsFileClose(&f->file);
+        // 写入结束后大小和时间戳都已变化 (Size and timestamps have changed once the write finishes)
+        if (f->writable) {
+            m_attr_cache->Invalidate(f->path.c_str());
+        }
         delete f;
         file->impl = nullptr;
     }
@@ -654,53 +641,76 @@ void NxModManagerProxy::CloseFile(haze::File *file) {
 
 // 目录操作
 Result NxModManagerProxy::CreateDirectory(const char* path) {
-    return fsFsCreateDirectory(m_fs, FixPath(path));
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    const Result rc = fsFsCreateDirectory(m_fs, fixed_path);
+    m_attr_cache->Invalidate(fixed_path);
+    return rc;
 }
 
 Result NxModManagerProxy::DeleteDirectoryRecursively(const char* path) {
-    return fsFsDeleteDirectoryRecursively(m_fs, FixPath(path));
+    char fixed_path[FS_MAX_PATH];
+    FixPath(path, fixed_path);
+    m_attr_cache->InvalidateDirectory(fixed_path);
+    const Result rc = fsFsDeleteDirectoryRecursively(m_fs, fixed_path);
+    m_attr_cache->InvalidateDirectory(fixed_path);
+    return rc;
 }
 
 Result NxModManagerProxy::RenameDirectory(const char *old_path, const char *new_path) {
     char fixed_old[FS_MAX_PATH], fixed_new[FS_MAX_PATH];
-    return fsFsRenameDirectory(m_fs, FixPath(old_path, fixed_old), FixPath(new_path, fixed_new));
+    FixPath(old_path, fixed_old);
+    FixPath(new_path, fixed_new);
+    m_attr_cache->InvalidateDirectory(fixed_old);
+    m_attr_cache->InvalidateDirectory(fixed_new);
+    const Result rc = fsFsRenameDirectory(m_fs, fixed_old, fixed_new);
+    m_attr_cache->InvalidateDirectory(fixed_old);
+    m_attr_cache->InvalidateDirectory(fixed_new);
+    return rc;
 }
 
 Result NxModManagerProxy::OpenDirectory(const char *path, haze::Dir *out_dir) {
-    auto dir = new FsDir();
-    const auto rc = fsFsOpenDirectory(m_fs, FixPath(path), FsDirOpenMode_ReadDirs | FsDirOpenMode_ReadFiles | FsDirOpenMode_NoFileSize, dir);
+    // 不再使用NoFileSize：读取目录时顺带取得文件大小填充属性缓存
+    // (NoFileSize is no longer used: the directory read also returns file sizes to fill the attribute cache)
+    auto dir = new OpenedDirectory();
+    char fixed_path[FS_MAX_PATH];
+    dir->path = FixPath(path, fixed_path);
+    const auto rc = fsFsOpenDirectory(m_fs, dir->path.c_str(), FsDirOpenMode_ReadDirs | FsDirOpenMode_ReadFiles, &dir->dir);
     if (R_FAILED(rc)) {
         delete dir;
         return rc;
     }
 
+    dir->cache_generation = m_attr_cache->BeginDirectory(dir->path.c_str());
     out_dir->impl = dir;
     return 0;  // 成功
 }
 
 Result NxModManagerProxy::ReadDirectory(haze::Dir *d, s64 *out_total_entries, size_t max_entries, haze::DirEntry *buf) {
-    auto dir = static_cast<FsDir*>(d->impl);
+    auto dir = static_cast<OpenedDirectory*>(d->impl);
 
     std::vector<FsDirectoryEntry> entries(max_entries);
-    Result rc = fsDirRead(dir, out_total_entries, entries.size(), entries.data());
+    Result rc = fsDirRead(&dir->dir, out_total_entries, entries.size(), entries.data());
     if (R_SUCCEEDED(rc)) {
         for (s64 i = 0; i < *out_total_entries; i++) {
             std::strcpy(buf[i].name, entries[i].name);
         }
+        m_attr_cache->StoreDirectoryEntries(dir->path.c_str(), entries.data(), *out_total_entries, dir->cache_generation);
     }
 
     return rc;
 }
 
 Result NxModManagerProxy::GetDirectoryEntryCount(haze::Dir *d, s64 *out_count) {
-    auto dir = static_cast<FsDir*>(d->impl);
-    return fsDirGetEntryCount(dir, out_count);
+    auto dir = static_cast<OpenedDirectory*>(d->impl);
+    return fsDirGetEntryCount(&dir->dir, out_count);
 }
 
 void NxModManagerProxy::CloseDirectory(haze::Dir *d) {
-    auto dir = static_cast<FsDir*>(d->impl);
+    auto dir = static_cast<OpenedDirectory*>(d->impl);
     if (dir) {
-        fsDirClose(dir);
+        fsDirClose(&dir->dir);
         delete dir;
         d->impl = nullptr;
     }
@@ -722,6 +732,7 @@ MtpManager::MtpManager()
     , m_is_connected(false)
     , m_just_completed(false)
     , m_transfer_in_progress(false)
+    , m_attr_cache(std::make_shared<EntryAttributeCache>())
     , m_sd_proxy(nullptr)
     , m_addmod_proxy(nullptr)
     , m_nxmodmgr_proxy(nullptr)
@@ -739,13 +750,13 @@ MtpManager::MtpManager()
     ResetTransferInfo();
     
     // 创建SD卡代理
-    m_sd_proxy = std::make_shared<SdCardFileSystemProxy>();
+    m_sd_proxy = std::make_shared<SdCardFileSystemProxy>(m_attr_cache);
     
     // 创建ADD MOD代理
-    m_addmod_proxy = std::make_shared<AddModProxy>();
+    m_addmod_proxy = std::make_shared<AddModProxy>(m_attr_cache);
     
     // 创建Nx Mod Manager代理
-    m_nxmodmgr_proxy = std::make_shared<NxModManagerProxy>();
+    m_nxmodmgr_proxy = std::make_shared<NxModManagerProxy>(m_attr_cache);
     
     // 添加到文件系统入口列表
     m_fs_entries.push_back(m_sd_proxy);
@@ -776,6 +787,9 @@ bool MtpManager::StartMtp() {
     
     // 重置传输信息
     ResetTransferInfo();
+
+    // 停止期间SD卡可能已被本程序修改，丢弃旧的属性缓存 (The SD card may have been changed while stopped, drop stale attributes)
+    m_attr_cache->Clear();
     
     // 初始化haze MTP服务
     // 参数：回调函数、文件系统入口、VID、PID标识、日志关闭
@@ -10,6 +10,7 @@
 #include <mutex>
 #include "haze.h"
 #include "lang_manager.hpp"
+#include "mtp_attribute_cache.hpp"
 
 namespace mtp {
 
@@ -27,7 +28,7 @@ enum class MtpStatus {
 // SD卡文件系统代理类
 class SdCardFileSystemProxy : public haze::FileSystemProxyImpl {
 public:
-    SdCardFileSystemProxy();
+    explicit SdCardFileSystemProxy(std::shared_ptr<EntryAttributeCache> attr_cache);
     ~SdCardFileSystemProxy();
 
     // 基本信息
@@ -62,15 +63,16 @@ public:
 
 private:
     FsFileSystem* m_fs;     // 文件系统指针
+    std::shared_ptr<EntryAttributeCache> m_attr_cache;  // 共享的属性缓存 (Shared attribute cache)
     
-    // 路径修正函数
-    const char* FixPath(const char* path, char* out = nullptr) const;
+    // 路径修正函数，结果写入调用方的缓冲区（至少FS_MAX_PATH字节）
+    const char* FixPath(const char* path, char* out) const;
 };
 
 // ADD MOD文件系统代理类 - 简单实现
 class AddModProxy : public haze::FileSystemProxyImpl {
 public:
-    AddModProxy();
+    explicit AddModProxy(std::shared_ptr<EntryAttributeCache> attr_cache);
     
     // 基本信息
     const char* GetName() const override;
@@ -104,15 +106,16 @@ public:
 
 private:
     FsFileSystem* m_fs;         // 文件系统指针
+    std::shared_ptr<EntryAttributeCache> m_attr_cache;  // 共享的属性缓存 (Shared attribute cache)
     
-    // 路径修正函数
-    const char* FixPath(const char* path, char* out = nullptr) const;
+    // 路径修正函数，结果写入调用方的缓冲区（至少FS_MAX_PATH字节）
+    const char* FixPath(const char* path, char* out) const;
 };
 
 // NX MOD MANAGER文件系统代理类 - 简单实现
 class NxModManagerProxy : public haze::FileSystemProxyImpl {
 public:
-    NxModManagerProxy();
+    explicit NxModManagerProxy(std::shared_ptr<EntryAttributeCache> attr_cache);
     
     // 基本信息
     const char* GetName() const override;
@@ -146,9 +149,10 @@ public:
 
 private:
     FsFileSystem* m_fs;         // 文件系统指针
+    std::shared_ptr<EntryAttributeCache> m_attr_cache;  // 共享的属性缓存 (Shared attribute cache)
     
-    // 路径修正函数
-    const char* FixPath(const char* path, char* out = nullptr) const;
+    // 路径修正函数，结果写入调用方的缓冲区（至少FS_MAX_PATH字节）
+    const char* FixPath(const char* path, char* out) const;
 };
 
 // MTP管理器类
@@ -182,6 +186,7 @@ private:
     bool m_is_connected;                                    // 是否已连接到电脑
     bool m_just_completed;                                  // 刚刚完成传输的标志（用于UI检测）
     bool m_transfer_in_progress;                            // 传输任务是否正在进行（更准确的判断标志）
+    std::shared_ptr<EntryAttributeCache> m_attr_cache;      // 三个代理共用的属性缓存
     std::shared_ptr<SdCardFileSystemProxy> m_sd_proxy;      // SD卡代理
     std::shared_ptr<AddModProxy> m_addmod_proxy;            // ADD MOD代理
     std::shared_ptr<NxModManagerProxy> m_nxmodmgr_proxy;    // NX MOD MANAGER代理
@@ -5,6 +5,11 @@
 #include <utility>
 #include <algorithm>
 #include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace tj::gfx {
 
@@ -162,102 +167,112 @@ void drawTextBox(NVGcontext* vg, float x, float y, float width, float size, floa
     nvgTextBox(vg, x, y, width, str, end);
 }
 
+// 字符级换行的一行：偏移量相对于文本开头，排版结果因此可以跨帧复用 (One row of character-level line breaking: offsets are
+// relative to the start of the text, so the layout can be reused across frames)
+struct TextLayoutRow {
+    size_t start;
+    size_t end;
+    float width;
+};
+
+// 一段文本的排版结果 (Layout of one piece of text)
+struct TextLayout {
+    NVGcontext* vg;
+    float size;
+    float maxWidth;
+    std::string text;
+    std::vector<TextLayoutRow> rows;
+    float maxRowWidth;
+};
+
+constexpr int MAX_TEXT_BOX_ROWS = 20; // 文本框最多绘制的行数 (Maximum number of rows drawn in a text box)
+constexpr size_t MAX_TEXT_LAYOUTS = 64; // 超出时整体清空 (Cleared as a whole when exceeded)
+
+// 排版缓存，只在渲染线程使用 (Layout cache, only used on the render thread)
+static std::unordered_map<size_t, TextLayout> text_layouts;
+
 // 字符级换行函数：按字符宽度换行，不考虑单词边界，但处理\n换行符 (Character-level line breaking: break by character width, ignore word boundaries, but handle \n newlines)
-static int breakTextByCharacter(NVGcontext* vg, const char* str, const char* end, float maxWidth, NVGtextRow* rows, int maxRows) {
-    if (!str || !rows || maxRows <= 0) return 0;
-    
-    int rowCount = 0;
+// 每段文字只取一次字形位置，线性计算每行的断点和宽度 (Glyph positions are taken once per paragraph, row breaks and widths
+// are computed in one linear pass)
+static void breakTextByCharacter(NVGcontext* vg, const char* str, const char* textEnd, float maxWidth, int maxRows, std::vector<TextLayoutRow>& rows) {
+    static std::vector<NVGglyphPosition> positions;
+
     const char* current = str;
-    const char* textEnd = end ? end : (str + strlen(str));
-    
-    while (current < textEnd && rowCount < maxRows) {
-        const char* lineStart = current;
-        const char* lineEnd = current;
-        float currentWidth = 0.0f;
-        bool foundNewline = false;
-        
-        // 逐字符检查，直到超过最大宽度或遇到\n (Check character by character until exceeding max width or encountering \n)
-        while (lineEnd < textEnd) {
-            // 检查是否遇到换行符 (Check if encountering newline character)
-            if (*lineEnd == '\n') {
-                foundNewline = true;
-                break;
-            }
-            
-            const char* nextChar = lineEnd;
-            
-            // 处理UTF-8字符，找到下一个字符的开始位置 (Handle UTF-8 characters, find next character start position)
-            if ((*nextChar & 0x80) == 0) {
-                // ASCII字符 (ASCII character)
-                nextChar++;
-            } else if ((*nextChar & 0xE0) == 0xC0) {
-                // 2字节UTF-8字符 (2-byte UTF-8 character)
-                nextChar += 2;
-            } else if ((*nextChar & 0xF0) == 0xE0) {
-                // 3字节UTF-8字符 (3-byte UTF-8 character)
-                nextChar += 3;
-            } else if ((*nextChar & 0xF8) == 0xF0) {
-                // 4字节UTF-8字符 (4-byte UTF-8 character)
-                nextChar += 4;
-            } else {
-                // 无效UTF-8，跳过 (Invalid UTF-8, skip)
-                nextChar++;
-            }
-            
-            // 确保不超过文本结尾 (Ensure not exceeding text end)
-            if (nextChar > textEnd) {
-                nextChar = textEnd;
-            }
-            
-            // 计算到这个字符为止的宽度 (Calculate width up to this character)
-            float testWidth = nvgTextBounds(vg, 0, 0, lineStart, nextChar, nullptr);
-            
-            if (testWidth > maxWidth && lineEnd > lineStart) {
-                // 超过宽度且已有字符，在当前位置断行 (Exceeds width and has characters, break at current position)
-                break;
-            }
-            
-            lineEnd = nextChar;
-            currentWidth = testWidth;
+    while (current < textEnd && static_cast<int>(rows.size()) < maxRows) {
+        // 找到本段结尾 (Find the end of this paragraph)
+        const char* paragraphEnd = static_cast<const char*>(std::memchr(current, '\n', textEnd - current));
+        if (!paragraphEnd) {
+            paragraphEnd = textEnd;
         }
-        
-        // 如果遇到换行符，直接在换行符处断行 (If encountering newline, break directly at newline)
-        if (foundNewline) {
-            // 换行符处断行，计算当前行的宽度 (Break at newline, calculate current line width)
-            currentWidth = nvgTextBounds(vg, 0, 0, lineStart, lineEnd, nullptr);
-        } else if (lineEnd == lineStart && lineEnd < textEnd) {
-            // 如果一个字符都放不下，至少放一个字符 (If can't fit even one character, at least put one character)
-            // 强制包含至少一个字符 (Force include at least one character)
-            if ((*lineEnd & 0x80) == 0) {
-                lineEnd++;
-            } else if ((*lineEnd & 0xE0) == 0xC0) {
-                lineEnd += 2;
-            } else if ((*lineEnd & 0xF0) == 0xE0) {
-                lineEnd += 3;
-            } else if ((*lineEnd & 0xF8) == 0xF0) {
-                lineEnd += 4;
-            } else {
-                lineEnd++;
+
+        // 每个字形至少占一个字节 (Every glyph takes at least one byte)
+        positions.resize(std::max<size_t>(paragraphEnd - current, 1));
+        const int count = nvgTextGlyphPositions(vg, 0, 0, current, paragraphEnd, positions.data(), static_cast<int>(positions.size()));
+
+        if (count <= 0) {
+            // 空行或没有可显示的字形 (Empty line or no displayable glyphs)
+            const float width = current < paragraphEnd ? nvgTextBounds(vg, 0, 0, current, paragraphEnd, nullptr) : 0.0f;
+            rows.push_back({static_cast<size_t>(current - str), static_cast<size_t>(paragraphEnd - str), width});
+        } else {
+            // 最后一个字形的右边界需要单独量一次 (The right edge of the last glyph needs one separate measurement)
+            const float paragraphRight = positions[count - 1].x + nvgTextBounds(vg, 0, 0, positions[count - 1].str, paragraphEnd, nullptr);
+            const auto glyphRight = [&](int i) { return i + 1 < count ? positions[i + 1].x : paragraphRight; };
+
+            int rowStart = 0;
+            for (int i = 0; i < count && static_cast<int>(rows.size()) < maxRows; ++i) {
+                // 超过宽度且已有字符，在当前字符前断行 (Exceeds width and has characters, break before the current character)
+                if (i > rowStart && glyphRight(i) - positions[rowStart].x > maxWidth) {
+                    const char* rowBegin = rowStart == 0 ? current : positions[rowStart].str;
+                    rows.push_back({static_cast<size_t>(rowBegin - str), static_cast<size_t>(positions[i].str - str), positions[i].x - positions[rowStart].x});
+                    rowStart = i;
+                }
+            }
+
+            if (static_cast<int>(rows.size()) < maxRows) {
+                const char* rowBegin = rowStart == 0 ? current : positions[rowStart].str;
+                rows.push_back({static_cast<size_t>(rowBegin - str), static_cast<size_t>(paragraphEnd - str), paragraphRight - positions[rowStart].x});
             }
-            if (lineEnd > textEnd) lineEnd = textEnd;
-            currentWidth = nvgTextBounds(vg, 0, 0, lineStart, lineEnd, nullptr);
         }
-        
-        // 保存这一行 (Save this line)
-        rows[rowCount].start = lineStart;
-        rows[rowCount].end = lineEnd;
-        // 如果遇到换行符，下一行从换行符之后开始 (If encountering newline, next line starts after newline)
-        rows[rowCount].next = foundNewline ? lineEnd + 1 : lineEnd;
-        rows[rowCount].width = currentWidth;
-        rows[rowCount].minx = 0;
-        rows[rowCount].maxx = currentWidth;
-        
-        rowCount++;
-        // 如果遇到换行符，跳过换行符继续处理 (If encountering newline, skip newline and continue)
-        current = foundNewline ? lineEnd + 1 : lineEnd;
+
+        // 跳过换行符继续处理 (Skip the newline and continue)
+        current = paragraphEnd < textEnd ? paragraphEnd + 1 : textEnd;
     }
-    
-    return rowCount;
+}
+
+// 取得文本排版，文本、字号和宽度都没变时直接复用上次结果，需先设置字号
+// Get the text layout, reusing the previous result when the text, font size and width are unchanged; the font size
+// must be set first
+static const TextLayout& getTextLayout(NVGcontext* vg, float size, float maxWidth, const char* str, const char* end) {
+    const std::string_view text = !str ? std::string_view{} : std::string_view{str, end ? static_cast<size_t>(end - str) : std::strlen(str)};
+
+    size_t key = std::hash<std::string_view>{}(text);
+    key ^= std::hash<float>{}(size) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    key ^= std::hash<float>{}(maxWidth) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    key ^= std::hash<const void*>{}(vg) + 0x9e3779b9 + (key << 6) + (key >> 2);
+
+    auto it = text_layouts.find(key);
+    if (it != text_layouts.end() && it->second.vg == vg && it->second.size == size && it->second.maxWidth == maxWidth && it->second.text == text) {
+        return it->second;
+    }
+
+    if (it == text_layouts.end() && text_layouts.size() >= MAX_TEXT_LAYOUTS) {
+        text_layouts.clear();
+    }
+
+    // 未命中或哈希冲突时重新排版 (Lay the text out again on a miss or a hash collision)
+    TextLayout& layout = text_layouts[key];
+    layout.vg = vg;
+    layout.size = size;
+    layout.maxWidth = maxWidth;
+    layout.text.assign(text);
+    layout.rows.clear();
+    breakTextByCharacter(vg, layout.text.data(), layout.text.data() + layout.text.size(), maxWidth, MAX_TEXT_BOX_ROWS, layout.rows);
+
+    layout.maxRowWidth = 0.0f;
+    for (const auto& row : layout.rows) {
+        layout.maxRowWidth = std::max(layout.maxRowWidth, row.width);
+    }
+    return layout;
 }
 
 void drawTextBoxCentered(NVGcontext* vg, float x, float y, float width, float height, float size, float lineSpacing, const char* str, const char* end, Colour c) {
@@ -273,9 +288,10 @@ void drawTextBoxCentered(NVGcontext* vg, float x, float y, float width, float he
     float textAreaWidth = width;
     float textAreaX = x;
     
-    // 使用字符级换行计算文本行数 (Use character-level line breaking to calculate text rows)
-    NVGtextRow allRows[20];
-    int allRowsCount = breakTextByCharacter(vg, str, end, textAreaWidth, allRows, 20);
+    // 使用字符级换行计算文本行数，文本不变时复用缓存的排版 (Use character-level line breaking to calculate text rows,
+    // reusing the cached layout while the text is unchanged)
+    const TextLayout& layout = getTextLayout(vg, size, textAreaWidth, str, end);
+    const int allRowsCount = static_cast<int>(layout.rows.size());
     
     // 计算文本总高度 (Calculate total text height)
     float totalTextHeight = allRowsCount > 0 ? allRowsCount * lineSpacing * lineh : 0;
@@ -286,15 +302,8 @@ void drawTextBoxCentered(NVGcontext* vg, float x, float y, float width, float he
     float textStartY = centerY - totalTextHeight / 2.0f + ascender;
     
     // 水平居中但左对齐：计算文本块的实际宽度，让整个文本块居中，但内容左对齐 (Horizontal center but left-aligned: calculate actual text block width, center the block, but left-align content)
-    float maxLineWidth = 0.0f;
-    
-    // 计算所有行中最宽的行宽度 (Calculate the width of the widest line)
-    for (int i = 0; i < allRowsCount; i++) {
-        float lineWidth = nvgTextBounds(vg, 0, 0, allRows[i].start, allRows[i].end, nullptr);
-        if (lineWidth > maxLineWidth) {
-            maxLineWidth = lineWidth;
-        }
-    }
+    // 最宽的行宽度已在排版时算好 (The width of the widest line is computed during layout)
+    float maxLineWidth = layout.maxRowWidth;
     
     // 如果文本块宽度小于容器宽度，则让文本块在容器中居中 (If text block width is smaller than container width, center the text block in container)
     float textBlockStartX = textAreaX;
@@ -309,7 +318,7 @@ void drawTextBoxCentered(NVGcontext* vg, float x, float y, float width, float he
     float currentY = textStartY;
     
     for (int i = 0; i < allRowsCount; i++) {
-        nvgText(vg, textBlockStartX, currentY, allRows[i].start, allRows[i].end);
+        nvgText(vg, textBlockStartX, currentY, str + layout.rows[i].start, str + layout.rows[i].end);
         currentY += lineSpacing * lineh;
     }
 }
@@ -328,9 +337,10 @@ void drawTextBoxCentered(NVGcontext* vg, float x, float y, float width, float he
     float textAreaWidth = width;
     float textAreaX = x;
     
-    // 使用字符级换行计算文本行数 (Use character-level line breaking to calculate text rows)
-    NVGtextRow allRows[20];
-    int allRowsCount = breakTextByCharacter(vg, str, end, textAreaWidth, allRows, 20);
+    // 使用字符级换行计算文本行数，文本不变时复用缓存的排版 (Use character-level line breaking to calculate text rows,
+    // reusing the cached layout while the text is unchanged)
+    const TextLayout& layout = getTextLayout(vg, size, textAreaWidth, str, end);
+    const int allRowsCount = static_cast<int>(layout.rows.size());
     
     // 计算文本总高度 (Calculate total text height)
     float totalTextHeight = allRowsCount > 0 ? allRowsCount * lineSpacing * lineh : 0;
@@ -360,15 +370,8 @@ void drawTextBoxCentered(NVGcontext* vg, float x, float y, float width, float he
     
     if (isCenterAligned) {
         // 水平居中但左对齐：计算文本块实际宽度，让整个文本块居中，但内容左对齐 (Horizontal center but left-aligned: calculate actual text block width, center the block, but left-align content)
-        float maxLineWidth = 0.0f;
-        
-        // 计算所有行中最宽的行宽度 (Calculate the width of the widest line)
-        for (int i = 0; i < allRowsCount; i++) {
-            float lineWidth = nvgTextBounds(vg, 0, 0, allRows[i].start, allRows[i].end, nullptr);
-            if (lineWidth > maxLineWidth) {
-                maxLineWidth = lineWidth;
-            }
-        }
+        // 最宽的行宽度已在排版时算好 (The width of the widest line is computed during layout)
+        float maxLineWidth = layout.maxRowWidth;
         
         // 如果文本块宽度小于容器宽度，则让文本块在容器中居中 (If text block width is smaller than container width, center the text block in container)
         if (maxLineWidth < textAreaWidth) {
@@ -401,7 +404,7 @@ void drawTextBoxCentered(NVGcontext* vg, float x, float y, float width, float he
     }
     
     for (int i = 0; i < allRowsCount; i++) {
-        nvgText(vg, textX, currentY, allRows[i].start, allRows[i].end);
+        nvgText(vg, textX, currentY, str + layout.rows[i].start, str + layout.rows[i].end);
         currentY += lineSpacing * lineh;
     }
 }
@@ -0,0 +1,45 @@
+#include "pulse_colour.hpp"
+
+namespace tj {
+
+void PulseColour::Step() {
+    if (col.g == 255) { //当绿色分量达到最大值时(When green component reaches maximum)
+        increase_blue = true; //开始增加蓝色分量(Start increasing blue component)
+    } else if (col.b == 255 && delay == 10) { //当蓝色分量达到最大值且延迟达到10时(When blue component reaches maximum and delay reaches 10)
+        increase_blue = false; //停止增加蓝色分量(Stop increasing blue component)
+        delay = 0; //重置延迟计数器(Reset delay counter)
+    }
+
+    if (col.b == 255 && increase_blue == true) { //当蓝色分量为最大值且正在增加蓝色时(When blue component is at maximum and increasing blue)
+        delay++; //增加延迟计数器(Increment delay counter)
+    } else {
+        col.b = increase_blue ? col.b + 2 : col.b - 2; //根据方向调整蓝色分量(Adjust blue component based on direction)
+        col.g = increase_blue ? col.g - 2 : col.g + 2; //根据方向调整绿色分量(Adjust green component based on direction)
+    }
+}
+
+void PulseColour::Update(FrameScheduler& frame_scheduler, Clock::time_point now) {
+    // 按经过的时间推进；长时间未绘制后只走一步 (Advance by elapsed time; only one step after a long gap)
+    auto steps = (now - last_step) / STEP_INTERVAL;
+    if (steps > 8) {
+        steps = 1;
+        last_step = now;
+    } else {
+        last_step += steps * STEP_INTERVAL;
+    }
+
+    // 长时间无输入后走完当前周期，停在初始颜色，不再申请绘制 (Without input for a while, finish the current cycle and rest
+    // at the initial colour without requesting frames)
+    const bool settling = now - frame_scheduler.GetLastInput() >= IDLE_TIMEOUT;
+    for (; steps > 0 && !(settling && col.g == 255); --steps) {
+        Step();
+    }
+    if (settling && col.g == 255) {
+        return;
+    }
+
+    // 脉冲动画需要继续绘制 (The pulse animation keeps drawing)
+    frame_scheduler.RequestFrameWithin(FRAME_INTERVAL, now);
+}
+
+} // namespace tj
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <switch.h>
+#include "nanovg/nanovg.h"
+#include "frame_scheduler.hpp"
+
+namespace tj {
+
+/**
+ * 选中项的脉冲颜色 - 来自游戏卡安装器，在绿色和蓝色之间来回渐变
+ * Selection pulse colour - from the gamecard installer, fades back and forth between green and blue
+ *
+ * 按经过的时间推进，跳过未变化的帧时脉冲速度不变；长时间无输入后走完当前周期，停在初始颜色并不再申请绘制，
+ * 列表画面得以空闲，下次输入时继续
+ * Advanced by elapsed time so the speed is unchanged when frames are skipped; without input for a while it finishes the
+ * current cycle and rests at the initial colour without requesting frames, so list screens can go idle, and the next
+ * input resumes it
+ */
+class PulseColour {
+public:
+    using Clock = FrameScheduler::Clock;
+
+    static constexpr auto STEP_INTERVAL = std::chrono::microseconds(16667); // 颜色每1/60秒变化一步 (The colour advances one step every 1/60 second)
+    static constexpr auto FRAME_INTERVAL = std::chrono::milliseconds(33);   // 空闲时动画以30帧绘制 (The animation is drawn at 30 fps while idle)
+    static constexpr auto IDLE_TIMEOUT = std::chrono::seconds(3);           // 无输入超过该时间后停在初始颜色 (Rests at the initial colour once there was no input for this long)
+
+    /**
+     * 绘制高亮时调用：推进颜色，动画未停时向帧调度器申请下一帧
+     * Called while drawing the highlight: advance the colour and request the next frame while the animation runs
+     * @param frame_scheduler 帧调度器 (Frame scheduler)
+     * @param now 当前时间 (Current time)
+     */
+    void Update(FrameScheduler& frame_scheduler, Clock::time_point now);
+
+    /**
+     * 当前颜色，分量范围0-255
+     * Current colour, components in 0-255
+     */
+    const NVGcolor& GetColour() const { return col; }
+
+private:
+    void Step();
+
+    NVGcolor col{0, 255, 187, 255}; // 颜色值 (Color value)
+    u8 delay{0};                    // 延迟时间 (Delay time)
+    bool increase_blue{false};      // 是否增加蓝色分量 (Whether to increase blue component)
+    Clock::time_point last_step{Clock::now()};
+};
+
+} // namespace tj
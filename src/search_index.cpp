@@ -0,0 +1,229 @@
+#include "search_index.hpp"
+#include "utf8_util.hpp"
+#include "Pinyin-onefile.cpp"
+#include <algorithm>
+#include <cctype>
+
+namespace tj {
+
+namespace {
+
+// 解析名称为读音位置列表：中文字符取所有去重后的小写拼音，ASCII字母数字取自身，其余字符忽略
+// Parse a name into reading positions: Chinese characters take all deduplicated lowercase pinyins, ASCII alphanumerics take themselves, everything else is ignored
+void ParseReadings(const std::string& name,
+                   std::vector<std::vector<std::string>>& full_positions,
+                   std::vector<std::vector<std::string>>& initial_positions) {
+    size_t len = name.length();
+    size_t i = 0;
+
+    while (i < len) {
+        wchar_t ch = 0;
+        // 跳过无效字符 (Skip invalid character)
+        if (!DecodeUtf8(name, i, ch)) {
+            continue;
+        }
+
+        if (WzhePinYin::Pinyin::IsChinese(ch)) {
+            auto pinyins = WzhePinYin::Pinyin::GetPinyins(ch);
+            if (pinyins.empty()) {
+                continue;
+            }
+
+            std::vector<std::string> current_pinyins;
+            std::vector<std::string> current_initials;
+            for (auto& py : pinyins) {
+                std::transform(py.begin(), py.end(), py.begin(), ::tolower);
+                if (py.empty()) {
+                    continue;
+                }
+                // 多音字去重，避免重复分支 (Deduplicate polyphonic readings to avoid duplicate branches)
+                if (std::find(current_pinyins.begin(), current_pinyins.end(), py) == current_pinyins.end()) {
+                    current_pinyins.push_back(py);
+                }
+                std::string initial(1, py[0]);
+                if (std::find(current_initials.begin(), current_initials.end(), initial) == current_initials.end()) {
+                    current_initials.push_back(std::move(initial));
+                }
+            }
+
+            if (!current_pinyins.empty()) {
+                full_positions.push_back(std::move(current_pinyins));
+                initial_positions.push_back(std::move(current_initials));
+            }
+        } else if (ch < 128 && std::isalnum(static_cast<unsigned char>(ch))) {
+            // 只添加字母和数字，忽略标点符号；保留原大小写，与小写查询只在原名称中匹配 (Only add alphanumeric, ignore
+            // punctuation; the original case is kept, so a lowercase query only matches it through the original name)
+            std::string ascii(1, static_cast<char>(ch));
+            full_positions.push_back({ascii});
+            initial_positions.push_back({ascii});
+        }
+    }
+}
+
+} // namespace
+
+void PinyinSearchIndex::Lattice::Build(const std::vector<std::vector<std::string>>& positions) {
+    chars.clear();
+    tail_next.clear();
+    head_offsets.clear();
+    heads.clear();
+
+    head_offsets.reserve(positions.size() + 1);
+    for (size_t pos = 0; pos < positions.size(); ++pos) {
+        head_offsets.push_back(static_cast<uint32_t>(heads.size()));
+        for (const auto& reading : positions[pos]) {
+            heads.push_back(static_cast<uint32_t>(chars.size()));
+            chars += reading;
+            tail_next.insert(tail_next.end(), reading.size() - 1, NOT_TAIL);
+            tail_next.push_back(static_cast<uint16_t>(pos + 1));
+        }
+    }
+    head_offsets.push_back(static_cast<uint32_t>(heads.size()));
+}
+
+void PinyinSearchIndex::Lattice::Start(char c, std::vector<uint32_t>& out) const {
+    out.clear();
+    // 子串可以从任意读音的任意字符开始 (A substring may start at any character of any reading)
+    for (size_t node = 0; node < chars.size(); ++node) {
+        if (chars[node] == c) {
+            out.push_back(static_cast<uint32_t>(node));
+        }
+    }
+}
+
+void PinyinSearchIndex::Lattice::Advance(char c, const std::vector<uint32_t>& states, std::vector<uint32_t>& out) const {
+    out.clear();
+    bool branched = false;
+    const size_t position_count = head_offsets.size() - 1;
+
+    for (uint32_t node : states) {
+        uint16_t next_pos = tail_next[node];
+        if (next_pos == NOT_TAIL) {
+            // 读音内部：只能走到下一个字符 (Inside a reading: only the next character follows)
+            if (chars[node + 1] == c) {
+                out.push_back(node + 1);
+            }
+        } else if (next_pos < position_count) {
+            // 读音末尾：分支到下一位置的所有读音 (End of a reading: branch into every reading at the next position)
+            for (uint32_t h = head_offsets[next_pos]; h < head_offsets[next_pos + 1]; ++h) {
+                if (chars[heads[h]] == c) {
+                    out.push_back(heads[h]);
+                    branched = true;
+                }
+            }
+        }
+    }
+
+    // 只有分支时可能产生重复状态 (Duplicate states can only come from branching)
+    if (branched) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
+
+void PinyinSearchIndex::Build(const std::vector<std::string>& names) {
+    Clear();
+    entries.resize(names.size());
+
+    std::vector<std::vector<std::string>> full_positions;
+    std::vector<std::vector<std::string>> initial_positions;
+
+    for (size_t idx = 0; idx < names.size(); ++idx) {
+        Entry& entry = entries[idx];
+        entry.lower_name = names[idx];
+        std::transform(entry.lower_name.begin(), entry.lower_name.end(), entry.lower_name.begin(), ::tolower);
+
+        full_positions.clear();
+        initial_positions.clear();
+        ParseReadings(names[idx], full_positions, initial_positions);
+        entry.full.Build(full_positions);
+        entry.initials.Build(initial_positions);
+    }
+}
+
+void PinyinSearchIndex::Clear() {
+    entries.clear();
+    last_query.clear();
+    candidates.clear();
+    results.clear();
+}
+
+bool PinyinSearchIndex::AdvanceCandidate(Candidate& candidate, const std::string& query_lower, size_t from) {
+    const Entry& entry = entries[candidate.entry];
+
+    // 1. 直接匹配原始名称 (Direct match with original name)
+    if (candidate.raw_matched) {
+        candidate.raw_matched = entry.lower_name.find(query_lower) != std::string::npos;
+    }
+
+    // 2. 推进全拼和首字母自动机 (Advance the full pinyin and initials automata)
+    for (size_t i = from; i < query_lower.size(); ++i) {
+        char c = query_lower[i];
+        if (i == 0) {
+            entry.full.Start(c, candidate.full_states);
+            entry.initials.Start(c, candidate.initial_states);
+            continue;
+        }
+        if (!candidate.full_states.empty()) {
+            entry.full.Advance(c, candidate.full_states, scratch);
+            candidate.full_states.swap(scratch);
+        }
+        if (!candidate.initial_states.empty()) {
+            entry.initials.Advance(c, candidate.initial_states, scratch);
+            candidate.initial_states.swap(scratch);
+        }
+        if (candidate.full_states.empty() && candidate.initial_states.empty() && !candidate.raw_matched) {
+            return false;
+        }
+    }
+
+    return candidate.raw_matched || !candidate.full_states.empty() || !candidate.initial_states.empty();
+}
+
+const std::vector<uint32_t>& PinyinSearchIndex::Query(const std::string& query_lower) {
+    results.clear();
+
+    if (query_lower.empty()) {
+        last_query.clear();
+        candidates.clear();
+        return results;
+    }
+
+    size_t from = 0;
+    bool extends_last = !last_query.empty() && query_lower.size() > last_query.size()
+                        && query_lower.compare(0, last_query.size(), last_query) == 0;
+
+    if (extends_last) {
+        // 追加字符：不匹配的名称加字符后也不可能匹配，只推进上次的候选项
+        // Appended characters: a name that did not match cannot match a longer query, only advance previous candidates
+        from = last_query.size();
+    } else {
+        // 其他修改（回退、替换）：从全部名称重新开始 (Other edits such as backspace: restart from every name)
+        candidates.clear();
+        candidates.reserve(entries.size());
+        for (size_t idx = 0; idx < entries.size(); ++idx) {
+            candidates.push_back({static_cast<uint32_t>(idx), true, {}, {}});
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (AdvanceCandidate(candidates[i], query_lower, from)) {
+            if (kept != i) {
+                candidates[kept] = std::move(candidates[i]);
+            }
+            kept++;
+        }
+    }
+    candidates.resize(kept);
+
+    results.reserve(candidates.size());
+    for (const auto& candidate : candidates) {
+        results.push_back(candidate.entry);
+    }
+
+    last_query = query_lower;
+    return results;
+}
+
+} // namespace tj
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tj {
+
+/**
+ * 拼音搜索索引 - 在设置搜索上下文时一次性构建，每次按键只做线性时间的自动机推进
+ * Pinyin search index - built once when the search context is set, each keystroke only advances an automaton in linear time
+ *
+ * 每个名称保存两个读音格(全拼、首字母)，多音字的所有读音作为同一位置的并列分支，
+ * 查询串是否为某条读音路径的子串通过状态集合模拟判断，无需展开所有组合
+ * Each name keeps two reading lattices (full pinyin and initials). All readings of a polyphonic character are parallel
+ * branches at the same position, so "query is a substring of some reading path" is decided by simulating a state set
+ * instead of expanding every combination
+ */
+class PinyinSearchIndex {
+public:
+    /**
+     * 为名称列表构建索引，会清空之前的索引和查询状态
+     * Build the index for a list of names, clears any previous index and query state
+     * @param names 搜索目标名称列表 (Names to search)
+     */
+    void Build(const std::vector<std::string>& names);
+
+    /**
+     * 清空索引和查询状态
+     * Clear index and query state
+     */
+    void Clear();
+
+    /**
+     * 查询匹配的名称索引，查询串在上一次查询的基础上追加字符时只处理上次的候选项
+     * Query matching name indices, when the query extends the previous one only the previous candidates are processed
+     * @param query_lower 小写查询文本 (Lowercase query text)
+     * @return 按原顺序排列的匹配索引 (Matching indices in original order)
+     */
+    const std::vector<uint32_t>& Query(const std::string& query_lower);
+
+    size_t Size() const { return entries.size(); }
+
+private:
+    // 读音格：读音字符平铺存储，读音末尾字符连接到下一位置的所有读音首字符
+    // Reading lattice: reading characters are stored flat, the last character of a reading links to the heads of all readings at the next position
+    struct Lattice {
+        static constexpr uint16_t NOT_TAIL = UINT16_MAX;
+
+        std::string chars;                  // 所有读音字符 (All reading characters)
+        std::vector<uint16_t> tail_next;    // 读音末尾字符的下一位置，否则为NOT_TAIL (Next position for a reading's last character, otherwise NOT_TAIL)
+        std::vector<uint32_t> head_offsets; // 每个位置的首字符在heads中的起始偏移 (Start offset into heads for each position)
+        std::vector<uint32_t> heads;        // 每个位置所有读音首字符的节点编号 (Node indices of every reading head per position)
+
+        void Build(const std::vector<std::vector<std::string>>& positions);
+        void Start(char c, std::vector<uint32_t>& out) const;
+        void Advance(char c, const std::vector<uint32_t>& states, std::vector<uint32_t>& out) const;
+    };
+
+    struct Entry {
+        std::string lower_name; // 小写原始名称，用于直接子串匹配 (Lowercase original name for direct substring matching)
+        Lattice full;           // 全拼读音格 (Full pinyin lattice)
+        Lattice initials;       // 首字母读音格 (Initials lattice)
+    };
+
+    // 当前查询的候选项及其自动机状态 (Candidate of the current query with its automaton states)
+    struct Candidate {
+        uint32_t entry;
+        bool raw_matched;
+        std::vector<uint32_t> full_states;
+        std::vector<uint32_t> initial_states;
+    };
+
+    bool AdvanceCandidate(Candidate& candidate, const std::string& query_lower, size_t from);
+
+    std::vector<Entry> entries;
+    std::string last_query;
+    std::vector<Candidate> candidates;
+    std::vector<uint32_t> results;
+    std::vector<uint32_t> scratch;
+};
+
+} // namespace tj
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace tj {
+
+/**
+ * 从offset处解码一个UTF-8字符（1-4字节）并前移offset
+ * Decode one UTF-8 character (1-4 bytes) at offset and advance offset past it
+ * @param text UTF-8文本 (UTF-8 text)
+ * @param offset 当前字节位置，offset < text.size() (Current byte position, offset < text.size())
+ * @param ch 输出的码点 (Output code point)
+ * @return 无效或被截断的字节返回false，此时offset只前移一个字节 (Returns false for an invalid or truncated byte, offset
+ *         then advances by one byte only)
+ */
+inline bool DecodeUtf8(const std::string& text, size_t& offset, wchar_t& ch) {
+    const size_t len = text.size();
+    const unsigned char c = static_cast<unsigned char>(text[offset]);
+    auto cont = [&](size_t n) { return static_cast<wchar_t>(text[offset + n] & 0x3F); };
+
+    if (c < 0x80) {
+        ch = c;
+        offset += 1;
+    } else if ((c & 0xE0) == 0xC0 && offset + 1 < len) {
+        ch = ((c & 0x1F) << 6) | cont(1);
+        offset += 2;
+    } else if ((c & 0xF0) == 0xE0 && offset + 2 < len) {
+        ch = ((c & 0x0F) << 12) | (cont(1) << 6) | cont(2);
+        offset += 3;
+    } else if ((c & 0xF8) == 0xF0 && offset + 3 < len) {
+        ch = ((c & 0x07) << 18) | (cont(1) << 12) | (cont(2) << 6) | cont(3);
+        offset += 4;
+    } else {
+        ch = 0;
+        offset += 1;
+        return false;
+    }
+    return true;
+}
+
+} // namespace tj